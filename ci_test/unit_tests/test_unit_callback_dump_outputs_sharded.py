@@ -0,0 +1,158 @@
+import glob
+import json
+import os
+import os.path
+import sys
+import numpy as np
+
+# Bamboo utilities
+current_file = os.path.realpath(__file__)
+current_dir = os.path.dirname(current_file)
+sys.path.insert(0, os.path.join(os.path.dirname(current_dir), 'common_python'))
+import tools
+
+# ==============================================
+# Objects for Python data reader
+# ==============================================
+# Note: The Python data reader imports this file as a module and calls
+# the functions below to ingest data.
+
+# Data
+# Note: The number of samples is not a multiple of the mini-batch
+# size, so the last mini-batch is partial.
+np.random.seed(20221020)
+_num_samples = 23
+_sample_size = 3
+_mini_batch_size = 5
+_samples = np.random.normal(size=(_num_samples,_sample_size)).astype(np.float32)
+
+# Sample access functions
+def get_sample(index):
+    return _samples[index,:]
+def num_samples():
+    return _num_samples
+def sample_dims():
+    return (_sample_size,)
+
+# ==============================================
+# Setup LBANN experiment
+# ==============================================
+
+def setup_experiment(lbann):
+    """Construct LBANN experiment.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    trainer = lbann.Trainer(_mini_batch_size)
+    model = construct_model(lbann)
+    data_reader = construct_data_reader(lbann)
+    optimizer = lbann.NoOptimizer()
+    return trainer, model, data_reader, optimizer
+
+def construct_model(lbann):
+    """Construct LBANN model.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    # Note: Outputs are written within the experiment directory
+    # created by tools.create_tests.
+    output_dir = os.path.join(current_dir,
+                              'experiments',
+                              os.path.splitext(os.path.basename(current_file))[0],
+                              'outputs')
+    x = lbann.Input(data_field='samples')
+    y = lbann.Identity(x, name='dumped')
+    callbacks = [
+        lbann.CallbackDumpOutputs(layers='dumped',
+                                  execution_modes='test',
+                                  directory=output_dir,
+                                  format='npy',
+                                  sharded=True),
+    ]
+    num_epochs = 0
+    return lbann.Model(num_epochs,
+                       layers=lbann.traverse_layer_graph(x),
+                       callbacks=callbacks)
+
+def construct_data_reader(lbann):
+    """Construct Protobuf message for Python data reader.
+
+    The Python data reader will import the current Python file to
+    access the sample access functions.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    message = lbann.reader_pb2.DataReader()
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'train'
+        )
+    ])
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'test'
+        )
+    ])
+    return message
+
+# ==============================================
+# Setup PyTest
+# ==============================================
+
+def augment_test_func(test_func):
+    """Augment test function to check the dumped shards."""
+    test_name = test_func.__name__
+
+    def func(cluster, dirname):
+        experiment_output = test_func(cluster, dirname)
+        work_dir = experiment_output['work_dir']
+
+        # Read every shard listed in the manifest
+        manifests = glob.glob(
+            os.path.join(work_dir, '**', 'test-epoch*_dumped_output0_manifest.json'),
+            recursive=True)
+        assert len(manifests) == 1, \
+            f'Expected one manifest, found {len(manifests)}'
+        manifest_dir = os.path.dirname(manifests[0])
+        with open(manifests[0], 'r') as f:
+            manifest = json.load(f)
+        data = []
+        indices = []
+        for shard in manifest['shards']:
+            data_file = os.path.join(manifest_dir, shard['data'])
+            indices_file = os.path.join(manifest_dir, shard['indices'])
+            if os.path.exists(data_file):
+                data.append(np.load(data_file).reshape((-1, _sample_size)))
+                indices.append(np.load(indices_file).reshape(-1))
+        data = np.concatenate(data)
+        indices = np.concatenate(indices)
+
+        # Each sample is dumped once with its own index
+        assert sorted(indices.tolist()) == list(range(_num_samples)), \
+            'Dumped sample indices do not cover the data set'
+        assert np.allclose(data, _samples[indices,:]), \
+            'Dumped outputs do not match their sample indices'
+
+    # Return test function from factory function
+    func.__name__ = test_name
+    return func
+
+# Create test functions that can interact with PyTest
+for _test_func in tools.create_tests(setup_experiment, __file__):
+    globals()[_test_func.__name__] = augment_test_func(_test_func)
@@ -50,6 +50,17 @@ def setup_experiment(lbann):
     optimizer = lbann.NoOptimizer()
     return trainer, model, data_reader, optimizer
 
+def setup_experiment_layer_parallel(lbann):
+    """Construct LBANN experiment where sibling layers run concurrently.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    trainer, model, data_reader, optimizer = setup_experiment(lbann)
+    model.layer_parallel_threads = 4
+    return trainer, model, data_reader, optimizer
+
 def construct_model(lbann):
     """Construct LBANN model.
 
@@ -276,3 +287,18 @@ def construct_data_reader(lbann):
 # Create test functions that can interact with PyTest
 for _test_func in tools.create_tests(setup_experiment, __file__):
     globals()[_test_func.__name__] = _test_func
+
+# Repeat without writing parent outputs into the concatenated tensor
+for _test_func in tools.create_tests(
+        setup_experiment,
+        __file__,
+        test_name_base='test_unit_layer_concatenate_no_aliasing',
+        lbann_args=['--no_tensor_aliasing']):
+    globals()[_test_func.__name__] = _test_func
+
+# Repeat with the parents of each concatenation running concurrently
+for _test_func in tools.create_tests(
+        setup_experiment_layer_parallel,
+        __file__,
+        test_name_base='test_unit_layer_concatenate_layer_parallel'):
+    globals()[_test_func.__name__] = _test_func
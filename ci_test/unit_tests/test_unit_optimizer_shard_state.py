@@ -0,0 +1,150 @@
+import os
+import os.path
+import sys
+import numpy as np
+
+# Bamboo utilities
+current_file = os.path.realpath(__file__)
+current_dir = os.path.dirname(current_file)
+sys.path.insert(0, os.path.join(os.path.dirname(current_dir), 'common_python'))
+import tools
+
+# ==============================================
+# Objects for Python data reader
+# ==============================================
+# Note: The Python data reader imports this file as a module and calls
+# the functions below to ingest data.
+
+# Data
+# Note: Sample size is chosen so that it does not divide evenly
+# between processes.
+np.random.seed(20221019)
+_num_samples = 64
+_sample_size = 37
+_samples = np.random.normal(size=(_num_samples,_sample_size)).astype(np.float32)
+
+# Sample access functions
+def get_sample(index):
+    return _samples[index,:]
+def num_samples():
+    return _num_samples
+def sample_dims():
+    return (_sample_size,)
+
+# ==============================================
+# Setup LBANN experiment
+# ==============================================
+
+def setup_experiment(lbann):
+    """Construct LBANN experiment.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    mini_batch_size = num_samples() // 4
+    trainer = lbann.Trainer(mini_batch_size)
+    model = construct_model(lbann)
+    data_reader = construct_data_reader(lbann)
+    optimizer = lbann.NoOptimizer()
+    return trainer, model, data_reader, optimizer
+
+def construct_model(lbann):
+    """Construct LBANN model.
+
+    Two weights with identical initial values are trained with the
+    same gradient. One has replicated optimizer state and the other
+    has sharded optimizer state, so they should remain identical.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+
+    # Input data
+    x = lbann.Reshape(lbann.Input(data_field='samples'),
+                      dims=tools.str_list(_sample_size))
+
+    # Weights with replicated and sharded optimizer state
+    def make_weights(shard_state, name):
+        return lbann.Weights(
+            optimizer=lbann.Adam(learn_rate=0.01, beta1=0.9, beta2=0.99,
+                                 eps=1e-8, shard_state=shard_state),
+            initializer=lbann.ConstantInitializer(value=0.5),
+            name=name)
+    w_replicated = lbann.WeightsLayer(
+        weights=make_weights(False, 'replicated_weights'),
+        dims=tools.str_list(_sample_size))
+    w_sharded = lbann.WeightsLayer(
+        weights=make_weights(True, 'sharded_weights'),
+        dims=tools.str_list(_sample_size))
+
+    # Objective function
+    obj = [
+        lbann.L2Norm2(lbann.Subtract(x, w_replicated)),
+        lbann.L2Norm2(lbann.Subtract(x, w_sharded)),
+    ]
+
+    # Difference between trained weights
+    # Note: Only the order of the gradient reduction differs, so the
+    # weights should match up to rounding error.
+    diff = lbann.L2Norm2(lbann.Subtract(lbann.StopGradient(w_replicated),
+                                        lbann.StopGradient(w_sharded)))
+    metrics = [lbann.Metric(diff, name='weights difference')]
+    callbacks = [
+        lbann.CallbackCheckMetric(
+            metric=metrics[-1].name,
+            lower_bound=0,
+            upper_bound=_sample_size * np.finfo(np.float32).eps,
+            error_on_failure=True,
+            execution_modes='test'),
+    ]
+
+    # Construct model
+    num_epochs = 2
+    return lbann.Model(num_epochs,
+                       layers=lbann.traverse_layer_graph(x),
+                       objective_function=obj,
+                       metrics=metrics,
+                       callbacks=callbacks)
+
+def construct_data_reader(lbann):
+    """Construct Protobuf message for Python data reader.
+
+    The Python data reader will import the current Python file to
+    access the sample access functions.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    message = lbann.reader_pb2.DataReader()
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'train'
+        )
+    ])
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'test'
+        )
+    ])
+    return message
+
+# ==============================================
+# Setup PyTest
+# ==============================================
+
+# Create test functions that can interact with PyTest
+for _test_func in tools.create_tests(setup_experiment, __file__):
+    globals()[_test_func.__name__] = _test_func
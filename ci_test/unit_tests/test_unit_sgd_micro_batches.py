@@ -0,0 +1,172 @@
+import os
+import os.path
+import sys
+import numpy as np
+
+# Bamboo utilities
+current_file = os.path.realpath(__file__)
+current_dir = os.path.dirname(current_file)
+sys.path.insert(0, os.path.join(os.path.dirname(current_dir), 'common_python'))
+import tools
+
+# ==============================================
+# Objects for Python data reader
+# ==============================================
+# Note: The Python data reader imports this file as a module and calls
+# the functions below to ingest data.
+
+# Data
+np.random.seed(20221022)
+_num_samples = 32
+_sample_size = 7
+_samples = np.random.normal(size=(_num_samples,_sample_size)).astype(np.float32)
+
+# Training parameters
+# Note: Each optimization step runs _num_micro_batches micro-batches
+# of _micro_batch_size samples. The result should match SGD with
+# mini-batches of _num_micro_batches * _micro_batch_size samples.
+_micro_batch_size = 4
+_num_micro_batches = 2
+_num_epochs = 2
+_learning_rate = 0.1
+
+# Sample access functions
+def get_sample(index):
+    return _samples[index,:]
+def num_samples():
+    return _num_samples
+def sample_dims():
+    return (_sample_size,)
+
+# ==============================================
+# NumPy implementation
+# ==============================================
+
+def expected_weights():
+    """Weights after training with full mini-batches."""
+    mini_batch_size = _num_micro_batches * _micro_batch_size
+    w = np.zeros(_sample_size, dtype=np.float64)
+    for _ in range(_num_epochs):
+        for start in range(0, _num_samples, mini_batch_size):
+            x = _samples[start:start+mini_batch_size,:].astype(np.float64)
+            grad = 2 * np.mean(w - x, axis=0)
+            w -= _learning_rate * grad
+    return w
+
+# ==============================================
+# Setup LBANN experiment
+# ==============================================
+
+def setup_experiment(lbann):
+    """Construct LBANN experiment.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    algo = lbann.BatchedIterativeOptimizer(
+        "sgd",
+        epoch_count=_num_epochs,
+        num_micro_batches=_num_micro_batches)
+    trainer = lbann.Trainer(_micro_batch_size, training_algo=algo)
+    model = construct_model(lbann)
+    data_reader = construct_data_reader(lbann)
+    optimizer = lbann.NoOptimizer()
+    return trainer, model, data_reader, optimizer
+
+def construct_model(lbann):
+    """Construct LBANN model.
+
+    The weights are trained to minimize the mean squared distance to
+    the samples, and compared with the NumPy implementation.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+
+    # Input data
+    x = lbann.Reshape(lbann.Input(data_field='samples'),
+                      dims=tools.str_list(_sample_size))
+
+    # Trained weights
+    w = lbann.WeightsLayer(
+        weights=lbann.Weights(
+            optimizer=lbann.SGD(learn_rate=_learning_rate),
+            initializer=lbann.ConstantInitializer(value=0.0),
+            name='trained_weights'),
+        dims=tools.str_list(_sample_size))
+    obj = lbann.L2Norm2(lbann.Subtract(x, w))
+
+    # Expected weights
+    w_expected = lbann.WeightsLayer(
+        weights=lbann.Weights(
+            optimizer=lbann.NoOptimizer(),
+            initializer=lbann.ValueInitializer(
+                values=tools.str_list(expected_weights())),
+            name='expected_weights'),
+        dims=tools.str_list(_sample_size))
+
+    # Difference between trained and expected weights
+    diff = lbann.L2Norm2(lbann.Subtract(lbann.StopGradient(w), w_expected))
+    metrics = [lbann.Metric(diff, name='weights difference')]
+    # Note: Callbacks that read weight gradients at the end of backprop
+    # must skip micro-batches whose gradients are incomplete.
+    callbacks = [
+        lbann.CallbackCheckNaN(),
+        lbann.CallbackCheckSmall(),
+        lbann.CallbackCheckMetric(
+            metric=metrics[-1].name,
+            lower_bound=0,
+            upper_bound=_sample_size * 8 * np.finfo(np.float32).eps,
+            error_on_failure=True,
+            execution_modes='test'),
+    ]
+
+    # Construct model
+    return lbann.Model(_num_epochs,
+                       layers=lbann.traverse_layer_graph(x),
+                       objective_function=obj,
+                       metrics=metrics,
+                       callbacks=callbacks)
+
+def construct_data_reader(lbann):
+    """Construct Protobuf message for Python data reader.
+
+    The Python data reader will import the current Python file to
+    access the sample access functions.
+
+    Args:
+        lbann (module): Module for LBANN Python frontend
+
+    """
+    message = lbann.reader_pb2.DataReader()
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'train'
+        )
+    ])
+    message.reader.extend([
+        tools.create_python_data_reader(
+            lbann,
+            current_file,
+            'get_sample',
+            'num_samples',
+            'sample_dims',
+            'test'
+        )
+    ])
+    return message
+
+# ==============================================
+# Setup PyTest
+# ==============================================
+
+# Create test functions that can interact with PyTest
+for _test_func in tools.create_tests(setup_experiment, __file__):
+    globals()[_test_func.__name__] = _test_func
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+// Converts a text sample list into the binary index that the sample
+// list readers memory-map (see lbann/data_readers/sample_list_index.hpp).
+
+#include "lbann/data_readers/sample_list_index.hpp"
+
+#include <clara.hpp>
+
+#include <zstr.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+  string input;
+  string output;
+  bool print_help = false;
+
+  auto cli =
+    clara::Help(print_help).optional() |
+    clara::Arg(input, "sample list")(
+      "The text sample list to convert (optionally gzip-compressed)")
+      .required() |
+    clara::Arg(output, "index")("The name of the binary index to write")
+      .required();
+
+  auto result = cli.parse({argc, argv});
+  if (!result) {
+    cerr << "Error: Parsing arguments failed with message: "
+         << result.errorMessage() << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (print_help || input.empty() || output.empty()) {
+    auto const& exe_name = cli.m_exeName.name();
+    cout << cli << endl
+         << "example invocation:\n"
+         << "  " << exe_name << " train_sample_list.txt train_sample_list.bin\n"
+         << endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    zstr::ifstream istrm(input);
+    lbann::sample_list_index::convert(istrm, output);
+    lbann::sample_list_index const index(output);
+    cout << "Wrote " << output << ": " << index.get_num_files()
+         << " files, " << index.get_num_samples() << " samples" << endl;
+  }
+  catch (std::exception const& e) {
+    cerr << "Error: " << e.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
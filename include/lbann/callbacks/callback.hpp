@@ -139,7 +139,12 @@ public:
   virtual void on_backward_prop_begin(model *m) {}
   /** @brief Called when a layer begins backward propagation. */
   virtual void on_backward_prop_begin(model *m, Layer *l) {}
-  /** @brief Called when a model ends backward propagation. */
+  /** @brief Called when a model ends backward propagation.
+   *
+   *  With micro-batches, this is called for each of them. Weight
+   *  gradients can only be read after the last one, i.e. when the
+   *  optimizer's gradient allreduce is not deferred.
+   */
   virtual void on_backward_prop_end(model *m) {}
   /** @brief Called when a layer ends backward propagation. */
   virtual void on_backward_prop_end(model *m, Layer *l) {}
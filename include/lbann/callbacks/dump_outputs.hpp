@@ -29,6 +29,7 @@
 
 #include "lbann/callbacks/callback.hpp"
 
+#include <memory>
 #include <set>
 #include <string>
 
@@ -50,6 +51,17 @@ namespace callback {
  *  we use internally).
  *
  *  CNPY is required to export to NumPy file formats (npy and npz).
+ *
+ *  In sharded mode, outputs are not gathered to the root process.
+ *  Each process appends its local mini-batch samples to its own NPY
+ *  shard, "<mode>-epoch<#>_<layer>_output<#>_rank<#>.npy", and the
+ *  corresponding data sample indices to "..._rank<#>_indices.npy".
+ *  Shards are written by a background thread and their headers are
+ *  kept valid as they grow, so they can be loaded with numpy.load
+ *  (CNPY is not required). The trainer master writes a JSON manifest,
+ *  "<mode>-epoch<#>_<layer>_output<#>_manifest.json", that lists the
+ *  shards for reassembly. Shards are closed at the end of each
+ *  training epoch, validation, and test.
  */
 class dump_outputs : public callback_base {
 public:
@@ -65,20 +77,38 @@ public:
    *  @param directory      Directory for output files (default: current
    *                        working directory).
    *  @param file_format    Output file format. Options are csv, tsv,
-   *                        npy, npz (default: csv).
+   *                        npy, npz (default: csv, or npy if
+   *                        sharded).
+   *  @param sharded        Whether each process writes its local
+   *                        samples to its own shard (only npy is
+   *                        supported).
    */
   dump_outputs(
     std::set<std::string> layer_names,// = std::set<std::string>(),
     std::set<execution_mode> modes, // = std::set<std::string>(),
     El::Int batch_interval = 0,
     std::string directory = "",
-    std::string file_format = "");
+    std::string file_format = "",
+    bool sharded = false);
+  dump_outputs(const dump_outputs& other);
+  dump_outputs& operator=(const dump_outputs& other);
+  ~dump_outputs() override;
 
   dump_outputs* copy() const override {
     return new dump_outputs(*this);
   }
   std::string name() const override { return "dump outputs"; }
 
+  void on_epoch_end(model* m) override {
+    close_shards(*m, execution_mode::training);
+  }
+  void on_validation_end(model* m) override {
+    close_shards(*m, execution_mode::validation);
+  }
+  void on_test_end(model* m) override {
+    close_shards(*m, execution_mode::testing);
+  }
+
   void on_forward_prop_end(model* m, Layer* l) override {
     do_dump_outputs(*m, *l);
   }
@@ -120,11 +150,27 @@ private:
   /** @brief Output file format. */
   std::string m_file_format;
 
+  /** @brief Whether each process writes its own shard. */
+  bool m_sharded;
+
+  /** @brief Background writer for sharded output. */
+  class shard_writer;
+  std::unique_ptr<shard_writer> m_shard_writer;
+
+  /** @brief Shard prefixes whose manifest has been written. */
+  std::set<std::string> m_manifests;
+
   /** @brief   Dump outputs to file.
    *  @details Returns immediately if an output dump is not needed.
    */
   void do_dump_outputs(const model& m, const Layer& l);
 
+  /** @brief Append local outputs to shards. */
+  void do_dump_sharded_outputs(const model& m, const Layer& l);
+
+  /** @brief Finish writing and close shards for an execution mode. */
+  void close_shards(const model& m, execution_mode mode);
+
 };
 
 // Builder function
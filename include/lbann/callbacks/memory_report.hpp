@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef LBANN_CALLBACKS_CALLBACK_MEMORY_REPORT_HPP_INCLUDED
+#define LBANN_CALLBACKS_CALLBACK_MEMORY_REPORT_HPP_INCLUDED
+
+#include "lbann/callbacks/callback.hpp"
+
+#include <string>
+#include <vector>
+
+namespace lbann {
+namespace callback {
+
+/** @brief Report the local memory used by a model.
+ *
+ *  When the model has finished setup, the memory held by each layer
+ *  (activations, error signals and workspaces), by each weights
+ *  object (values, gradient and optimizer state) and by the I/O
+ *  buffers is estimated for a mini-batch size, along with the
+ *  predicted peak during a training step. Run with
+ *  --exit_after_setup to size a job without running a step.
+ *
+ *  The estimates are upper bounds: output tensors that turn out to be
+ *  views into other tensors are counted in full.
+ */
+class memory_report : public callback_base {
+public:
+
+  /** @brief Local memory used by a layer, in bytes. */
+  struct layer_usage {
+    std::string name;
+    std::string type;
+    size_t activations = 0;
+    size_t error_signals = 0;
+    size_t workspace = 0;
+  };
+
+  /** @brief Local memory used by a weights object, in bytes. */
+  struct weights_usage {
+    std::string name;
+    size_t values = 0;
+    /** Gradient and optimizer state */
+    size_t optimizer = 0;
+  };
+
+  /** @brief Local memory used by a model, in bytes. */
+  struct usage {
+    std::vector<layer_usage> layers;
+    std::vector<weights_usage> weights;
+    size_t io_buffers = 0;
+    /** Sum of all entries */
+    size_t total = 0;
+    /** Predicted peak during a training step
+     *
+     *  Activations, workspaces, weights and optimizers are held for
+     *  the whole step. Error signals are held from the backprop of
+     *  the layer that computes them until all of its parents have
+     *  run backprop.
+     */
+    size_t peak = 0;
+  };
+
+  /** @param mini_batch_size Mini-batch size for the estimates
+   *                         (0: the trainer's max mini-batch size).
+   */
+  memory_report(El::Int mini_batch_size = 0);
+  memory_report(const memory_report&) = default;
+  memory_report& operator=(const memory_report&) = default;
+  memory_report* copy() const override { return new memory_report(*this); }
+  void on_setup_end(model *m) override;
+  std::string name() const override { return "memory_report"; }
+
+  /** @brief Estimate the local memory used by a set-up model. */
+  static usage compute_usage(const model& m, El::Int mini_batch_size);
+
+  /** @name Serialization */
+  ///@{
+
+  /** @brief Store state to archive for checkpoint and restart */
+  template <class Archive> void serialize(Archive & ar);
+
+  ///@}
+
+private:
+
+  /** Mini-batch size for the estimates (0: trainer's max). */
+  El::Int m_mini_batch_size;
+
+};
+
+// Builder function
+std::unique_ptr<callback_base>
+build_memory_report_callback_from_pbuf(
+  const google::protobuf::Message&, std::shared_ptr<lbann_summary> const&);
+
+} // namespace callback
+} // namespace lbann
+
+#endif  // LBANN_CALLBACKS_CALLBACK_MEMORY_REPORT_HPP_INCLUDED
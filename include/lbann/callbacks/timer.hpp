@@ -38,8 +38,9 @@ namespace callback {
 
 /** Record and report model timing results.
  *  Reports the total time and mini-batch time statistics for training
- *  epochs and for model evaluations. This reports times for the
- *  master process in each model.
+ *  epochs and for model evaluations, as well as the I/O time that was
+ *  not hidden behind compute. This reports times for the master
+ *  process in each model.
  */
 class timer : public callback_base {
 public:
@@ -92,6 +93,8 @@ private:
   std::map<execution_mode,EvalType> m_batch_start_times;
   /** Mini-batch times. */
   std::map<execution_mode,std::vector<EvalType>> m_batch_times;
+  /** Time per mini-batch spent waiting for data. */
+  std::map<execution_mode,std::vector<EvalType>> m_batch_io_times;
 
   /** Start timing session. */
   void timing_begin(const model& m);
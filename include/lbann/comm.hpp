@@ -598,6 +598,16 @@ public:
                  int count,
                  const El::mpi::Comm& c,
                  El::mpi::Op op = El::mpi::SUM) const;
+  /** Scalar-array reduce-scatter.
+   *  @c snd holds @c count entries for each process in @c c, ordered
+   *  by rank. @c rcv receives the reduced entries for this process.
+   */
+  template <typename T>
+  void reduce_scatter(T const* snd,
+                      T* rcv,
+                      int count,
+                      const El::mpi::Comm& c,
+                      El::mpi::Op op = El::mpi::SUM) const;
   /** Matrix allreduce. */
   template <typename TensorDataType>
   void allreduce(El::AbstractMatrix<TensorDataType>& m,
@@ -706,6 +706,24 @@ void lbann_comm::allreduce(T* const data,
 #endif
   m_bytes_received += count * sizeof(T) * (size_c - 1);
 }
+/** Scalar-array reduce-scatter. */
+template <typename T>
+void lbann_comm::reduce_scatter(T const* const snd,
+                                T* const rcv,
+                                const int count,
+                                const El::mpi::Comm& c,
+                                const El::mpi::Op op) const
+{
+  auto const size_c = El::mpi::Size(c);
+  m_bytes_sent += count * sizeof(T) * (size_c - 1);
+  El::mpi::ReduceScatter(snd,
+                         rcv,
+                         count,
+                         op,
+                         c,
+                         El::SyncInfo<El::Device::CPU>{});
+  m_bytes_received += count * sizeof(T) * (size_c - 1);
+}
 /** Non-blocking in-place scalar-array allreduce.
  *  If LBANN has not been built with Aluminum, then this calls a blocking
  *  allreduce.
@@ -130,6 +130,8 @@ class buffered_data_coordinator : public data_coordinator {
 
   bool epoch_complete(execution_mode mode) override;
 
+  size_t get_buffer_memory_usage() const override;
+
   const data_buffer<IODataType>& get_data_buffer(const data_buffer_map_t& buffer_map, const execution_mode mode) const;
   data_buffer<IODataType>& get_data_buffer(data_buffer_map_t& buffer_map, const execution_mode mode);
 
@@ -152,6 +152,18 @@ class data_coordinator {
   /// execution mode
   virtual bool epoch_complete(execution_mode mode) = 0;
 
+  /** @brief Time the last fetch_data call spent waiting for data
+   *
+   *  When background I/O is enabled, the next mini-batch is fetched
+   *  while the current one goes through backprop and the optimizer
+   *  step. This is the part of the fetch that was not hidden behind
+   *  compute.
+   */
+  EvalType get_exposed_io_time(execution_mode mode) const {
+    auto it = m_exposed_io_time.find(mode);
+    return (it != m_exposed_io_time.end()) ? it->second : EvalType(0);
+  }
+
   //************************************************************************
   // Helper functions to access the statistics about the data set
   //************************************************************************
@@ -182,6 +194,9 @@ class data_coordinator {
 
   virtual int get_current_world_master_mini_batch_adjustment(execution_mode mode, int model_rank) const;
 
+  /** @brief Local memory held by I/O buffers, in bytes. */
+  virtual size_t get_buffer_memory_usage() const { return 0; }
+
   //************************************************************************
   // Helper functions to access the data readers
   //************************************************************************
@@ -503,6 +518,9 @@ class data_coordinator {
 
   std::set<data_field_type> m_active_data_fields;
 
+  /** @brief Time the last fetch_data call spent waiting for data */
+  std::map<execution_mode, EvalType> m_exposed_io_time;
+
 public:  // @todo BVE FIXME
   bool m_data_set_processed;
   std::mutex dr_mutex;
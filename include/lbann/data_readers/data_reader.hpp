@@ -220,6 +220,34 @@ class generic_data_reader {
    */
   bool is_shuffled() const { return m_shuffle; }
 
+  /** @brief Use a two-level, locality-aware "block" shuffle
+   *
+   *  Samples are grouped into blocks (see get_shuffle_block), the
+   *  order of the blocks is shuffled, and then samples are shuffled
+   *  within consecutive windows of @c window blocks. A mini-batch
+   *  thus draws from a few blocks (e.g. files) at a time, which
+   *  turns random I/O into mostly sequential I/O.
+   *
+   *  Statistical quality: samples within a window are uniformly
+   *  shuffled, but samples from different windows are never mixed,
+   *  so a mini-batch is only as diverse as the window it comes
+   *  from. Larger windows approach a global shuffle; a window should
+   *  hold at least a few mini-batches worth of samples. Zero (the
+   *  default) selects the global shuffle.
+   */
+  void set_shuffle_window(size_t window) { m_shuffle_window = window; }
+  size_t get_shuffle_window() const { return m_shuffle_window; }
+
+  /**
+   * Number of consecutive sample indices that form a block for the
+   * block shuffle, for data readers that do not group samples by
+   * file (default: 1).
+   */
+  void set_shuffle_block_size(size_t block_size) {
+    m_shuffle_block_size = std::max(block_size, size_t{1});
+  }
+  size_t get_shuffle_block_size() const { return m_shuffle_block_size; }
+
   /**
    * Set shuffled indices; primary use is for testing
    * and reproducibility
@@ -297,8 +325,8 @@ class generic_data_reader {
   virtual std::string get_type() const = 0;
 
   /** @brief Fetch a mini-batch worth of data, including samples, labels, responses (as appropriate) */
-  int fetch(std::map<data_field_type, CPUMat*>& input_buffers,
-            El::Matrix<El::Int>& indices_fetched, size_t mb_size);
+  virtual int fetch(std::map<data_field_type, CPUMat*>& input_buffers,
+                    El::Matrix<El::Int>& indices_fetched, size_t mb_size);
 
   /** @brief Check to see if the data reader supports this specific data field
    */
@@ -796,6 +824,17 @@ class generic_data_reader {
   /// Shuffle indices and profide a random number generator
   virtual void shuffle_indices(rng_gen& gen);
 
+  /** Returns the block (e.g. the file) that holds a sample, for the
+   *  block shuffle. Samples in the same block are assumed to be
+   *  cheap to read together.
+   */
+  virtual size_t get_shuffle_block(int index) const {
+    return static_cast<size_t>(index) / m_shuffle_block_size;
+  }
+
+  /** Block shuffle of the indices; see set_shuffle_window */
+  void block_shuffle_indices(rng_gen& gen);
+
 public:
   int m_mini_batch_size;
   int m_current_pos;
@@ -841,6 +880,10 @@ public:
   std::string m_data_fn;
   std::string m_label_fn;
   bool m_shuffle;
+  /// Number of blocks per window of the block shuffle (0: global shuffle)
+  size_t m_shuffle_window = 0;
+  /// Number of consecutive indices per block of the block shuffle
+  size_t m_shuffle_block_size = 1;
   size_t m_absolute_sample_count;
   std::map<execution_mode, double> m_execution_mode_split_percentage;
   double m_use_percent;
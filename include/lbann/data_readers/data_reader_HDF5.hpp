@@ -31,6 +31,8 @@
 #include "lbann/data_readers/sample_list_hdf5.hpp"
 #include "lbann/data_store/data_store_conduit.hpp"
 
+#include <future>
+
 // Forward declaration
 class DataReaderHDF5WhiteboxTester;
 
@@ -65,6 +67,16 @@ public:
 
   void load() override;
 
+  /** @brief Fetch a mini-batch
+   *
+   *  Without the data store, the mini-batch's samples are read from
+   *  disk here (grouped by file) and the next mini-batch is read
+   *  ahead on a background thread.
+   */
+  int fetch(std::map<data_field_type, CPUMat*>& input_buffers,
+            El::Matrix<El::Int>& indices_fetched,
+            size_t mb_size) override;
+
   bool fetch_data_field(data_field_type data_field, CPUMat& Y, int data_id, int mb_idx) override;
 
   bool fetch_datum(CPUMat& X, int data_id, int mb_idx) override
@@ -177,6 +189,20 @@ private:
   // penalty
   bool m_delete_packed_fields = true;
 
+  /** maps: sample index -> Node, as produced by load_sample */
+  using sample_cache = std::unordered_map<size_t, conduit::Node>;
+
+  /** True if samples are read from disk during fetch, rather than
+   *  from the data store */
+  bool m_streaming = false;
+
+  /** Samples of the current mini-batch (streaming mode only) */
+  sample_cache m_streamed_samples;
+
+  /** Samples of the next mini-batch, loaded by the read-ahead thread
+   *  (streaming mode only) */
+  std::future<sample_cache> m_read_ahead;
+
   struct PackingGroup
   {
     std::string group_name;
@@ -295,6 +321,20 @@ private:
   void
   load_sample(conduit::Node& node, size_t index, bool ignore_failure = false);
 
+  /** Loads the samples with the given indices; samples are visited
+   *  file by file, in sample list order, so that each file is opened
+   *  once and read front to back. Used in streaming mode.
+   */
+  sample_cache load_samples(std::vector<size_t> indices);
+
+  /** Returns the indices of the samples in the mini-batch that
+   *  starts at position 'pos' of the shuffled indices */
+  std::vector<size_t> get_mini_batch_indices(int pos, int mb_size) const;
+
+  /** Blocks until the read-ahead thread (if any) is finished and
+   *  discards its result */
+  void discard_read_ahead();
+
   /** Performs packing, normalization, etc. Called by load_sample. */
   void pack_data(conduit::Node& node_in_out);
 
@@ -31,7 +31,7 @@
 #define LBANN_DATA_READER_NUMPY_HPP
 
 #include "data_reader.hpp"
-#include <cnpy.h>
+#include "lbann/utils/mapped_npy.hpp"
 
 namespace lbann {
 
@@ -41,12 +41,12 @@ namespace lbann {
  * axes can be flattened to form a sample.
  * This supports fetching labels, but only from the last column. (This can be
  * relaxed if necessary.) Ditto responses.
+ * The file is memory-mapped, so only the pages holding fetched samples are
+ * read and they are shared through the page cache by all ranks on a node.
  */
 class numpy_reader : public generic_data_reader {
  public:
   numpy_reader(bool shuffle = true);
-  // These need to be explicit because of some issue with the cnpy copy
-  // constructor/assignment operator not linking correctly otherwise.
   numpy_reader(const numpy_reader&);
   numpy_reader& operator=(const numpy_reader&);
   ~numpy_reader() override {}
@@ -63,8 +63,8 @@ class numpy_reader : public generic_data_reader {
   int get_linearized_data_size() const override { return m_num_features; }
   int get_linearized_label_size() const override { return m_num_labels; }
   const std::vector<int> get_data_dims() const override {
-    std::vector<int> dims(m_data.shape.begin() + 1,
-                          m_data.shape.end());
+    std::vector<int> dims(m_data.shape().begin() + 1,
+                          m_data.shape().end());
     if (m_supported_input_types.at(INPUT_DATA_TYPE_LABELS) ||
         m_supported_input_types.at(INPUT_DATA_TYPE_RESPONSES)) {
       dims.back() -= 1;
@@ -85,10 +85,9 @@ class numpy_reader : public generic_data_reader {
   int m_num_labels = 0;
   /**
    * Underlying numpy data.
-   * Note raw data is managed with shared smart pointer semantics (relevant
-   * for copying).
+   * Note the mapping is shared between copies.
    */
-  cnpy::NpyArray m_data;
+  mapped_npy_array m_data;
 };
 
 }  // namespace lbann
@@ -31,7 +31,6 @@
 
 #include "data_reader.hpp"
 #include "data_reader_numpy.hpp"
-#include <cnpy.h>
 
 namespace lbann {
   /**
@@ -39,12 +38,12 @@ namespace lbann {
    * This assumes that the file contains "data", "labels" (optional),
    * and "responses" (optional) whose the zero'th axis is the sample axis.
    * float, double, int16 data-types is accepted for "data".
+   * Arrays stored without compression (numpy.savez) are memory-mapped;
+   * compressed arrays (numpy.savez_compressed) are read into memory.
    */
   class numpy_npz_reader : public generic_data_reader {
   public:
     numpy_npz_reader(const bool shuffle);
-    // These need to be explicit because of some issue with the cnpy copy
-    // constructor/assignment operator not linking correctly otherwise.
     numpy_npz_reader(const numpy_npz_reader&);
     numpy_npz_reader& operator=(const numpy_npz_reader&);
     ~numpy_npz_reader() override {}
@@ -66,8 +65,8 @@ namespace lbann {
     int get_linearized_label_size() const override { return m_num_labels; }
     int get_linearized_response_size() const override { return m_num_response_features; }
     const std::vector<int> get_data_dims() const override {
-      std::vector<int> dims(m_data.shape.begin() + 1,
-                            m_data.shape.end());
+      std::vector<int> dims(m_data.shape().begin() + 1,
+                            m_data.shape().end());
       return dims;
     }
 
@@ -89,13 +88,17 @@ namespace lbann {
      * Note raw data is managed with shared smart pointer semantics (relevant
      * for copying).
      */
-    cnpy::NpyArray m_data, m_labels, m_responses;
+    mapped_npy_array m_data, m_labels, m_responses;
 
     // A constant to be multiplied when data is converted
     // from int16 to DataType.
     DataType m_scaling_factor_int16 = 1.0;
 
   private:
+    /// Map an array in a .npz file, or load it if it is compressed.
+    static mapped_npy_array load_array(const std::string& filename,
+                                       const std::string& key);
+
     // Keys to retrieve data, labels, responses from a given .npz file.
     static const std::string NPZ_KEY_DATA, NPZ_KEY_LABELS, NPZ_KEY_RESPONSES;
 
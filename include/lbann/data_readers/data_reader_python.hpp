@@ -30,9 +30,24 @@
 #include "data_reader.hpp"
 #ifdef LBANN_HAS_EMBEDDED_PYTHON
 #include "lbann/utils/python.hpp"
+#include <deque>
 
 namespace lbann {
 
+/** @brief Data reader that gets samples from a Python function.
+ *
+ *  Samples are generated by a pool of Python worker processes and
+ *  written into a ring of mini-batch slots in shared memory. Up to
+ *  @c num_prefetch_batches upcoming mini-batches are requested
+ *  asynchronously, so the workers keep generating data while the
+ *  model is computing. Full mini-batches are handed to the data
+ *  coordinator as views into shared memory without copying.
+ *
+ *  Labels and regression responses can optionally be provided with
+ *  additional Python functions. The label function must return an
+ *  integer class index and the response function must return an
+ *  iterable with @c num_responses entries.
+ */
 class python_reader : public generic_data_reader {
 public:
   python_reader(std::string module,
@@ -40,7 +55,12 @@ public:
                 std::string sample_function,
                 std::string num_samples_function,
                 std::string sample_dims_function,
-                bool shuffle);
+                bool shuffle,
+                std::string label_function = "",
+                El::Int num_labels = 0,
+                std::string response_function = "",
+                El::Int num_responses = 0,
+                El::Int num_prefetch_batches = 2);
   python_reader(const python_reader&) = default;
   python_reader& operator=(const python_reader&) = default;
   ~python_reader() override;
@@ -54,6 +74,8 @@ public:
   int get_num_labels() const override;
   int get_linearized_data_size() const override;
   int get_linearized_label_size() const override;
+  int get_num_responses() const override;
+  int get_linearized_response_size() const override;
 
   void setup(int num_io_threads, observer_ptr<thread_pool> io_thread_pool) override;
   void load() override;
@@ -65,9 +87,39 @@ protected:
                         El::Int mb_size,
                         El::Matrix<El::Int>& indices_fetched) override;
   bool fetch_label(CPUMat& Y, int data_id, int mb_idx) override;
+  bool fetch_response(CPUMat& Y, int data_id, int mb_idx) override;
 
 private:
 
+  /** @brief Mini-batch that has been requested from the process pool. */
+  struct pending_mini_batch {
+    /** @brief Slot in shared memory arrays. */
+    El::Int slot;
+    /** @brief Data sample indices. */
+    std::vector<El::Int> indices;
+    /** @brief @c AsyncResult from the Python @c multiprocessing module. */
+    python::object result;
+  };
+
+  /** @brief Indices of data samples in a predicted mini-batch.
+   *
+   *  Mirrors the mini-batch sizing in the data coordinator.
+   */
+  std::vector<El::Int> get_mini_batch_indices(El::Int pos,
+                                              El::Int mb_size) const;
+  /** @brief Asynchronously generate a mini-batch in a shared memory slot. */
+  python::object launch_mini_batch(El::Int slot,
+                                   const std::vector<El::Int>& indices);
+  /** @brief Find a slot that is not pending or in use.
+   *
+   *  Returns -1 if all slots are busy.
+   */
+  El::Int get_free_slot(El::Int current_slot) const;
+  /** @brief Request upcoming mini-batches from the process pool. */
+  void prefetch_mini_batches(El::Int current_slot);
+  /** @brief Wait for and discard all pending mini-batches. */
+  void discard_pending_mini_batches();
+
   /** @brief Dimensions of data sample tensor. */
   std::vector<El::Int> m_sample_dims;
   /** @brief Number of data samples in data set. */
@@ -80,6 +132,22 @@ private:
    *  entries in a data sample.
    */
   python::object m_sample_function;
+  /** @brief Optional Python function to access sample labels.
+   *
+   *  The function takes the sample index and returns the class
+   *  index, which is converted to a one-hot vector.
+   */
+  python::object m_label_function;
+  /** @brief Optional Python function to access sample responses.
+   *
+   *  The function takes the sample index and returns an iterator
+   *  over @c m_num_responses entries.
+   */
+  python::object m_response_function;
+  /** @brief Number of label classes. */
+  El::Int m_num_labels = 0;
+  /** @brief Number of response values. */
+  El::Int m_num_responses = 0;
 
   /** @brief Wrapper function around sample access function.
    *
@@ -97,7 +165,8 @@ private:
 
   /** @brief Shared memory array.
    *
-   *  @c RawArray from the Python @c multiprocessing module.
+   *  @c RawArray from the Python @c multiprocessing module. It is
+   *  partitioned into @c m_num_slots mini-batch slots.
    */
   python::object m_shared_memory_array;
 
@@ -107,6 +176,31 @@ private:
    */
   DataType* m_shared_memory_array_ptr = nullptr;
 
+  /** @brief Shared memory array for one-hot labels. */
+  python::object m_shared_label_array;
+  /** @brief Pointer into shared memory array for labels. */
+  DataType* m_shared_label_array_ptr = nullptr;
+  /** @brief Shared memory array for responses. */
+  python::object m_shared_response_array;
+  /** @brief Pointer into shared memory array for responses. */
+  DataType* m_shared_response_array_ptr = nullptr;
+
+  /** @brief Number of mini-batches requested ahead of time. */
+  El::Int m_num_prefetch_batches;
+  /** @brief Number of mini-batch slots in shared memory.
+   *
+   *  Two slots more than the prefetch depth: one for the mini-batch
+   *  being fetched and one for the mini-batch the model is still
+   *  using (it is viewed in place by the data coordinator).
+   */
+  El::Int m_num_slots = 0;
+  /** @brief Mini-batch capacity of each slot. */
+  El::Int m_slot_size = 0;
+  /** @brief Slot returned by the most recent fetch. */
+  El::Int m_last_slot = -1;
+  /** @brief Mini-batches requested from the process pool, in order. */
+  std::deque<pending_mini_batch> m_pending_mini_batches;
+
 };
 
 } // namespace lbann
@@ -83,11 +83,23 @@ public:
 protected:
   SampleListT m_sample_list;
 
+  /** The block shuffle groups samples by the file that holds them */
+  size_t get_shuffle_block(int index) const override
+  {
+    return m_sample_list[index].first;
+  }
+
   void load_list_of_samples(const std::string sample_list_file);
 
   void
   load_list_of_samples_from_archive(const std::string& sample_list_archive);
 
+  /** Orders sample indices by the file that holds them, then by their
+   *  position in the sample list, so that files can be read one at a
+   *  time and front to back.
+   */
+  void sort_indices_by_file(std::vector<size_t>& indices) const;
+
 }; // class data_reader_sample_list
 
 } // end of namespace lbann
@@ -30,11 +30,15 @@
 
 #include "lbann/data_readers/data_reader_sample_list.hpp"
 #include "lbann/data_readers/sample_list_impl.hpp"
+#include "lbann/data_readers/sample_list_index.hpp"
 #include "lbann/data_readers/sample_list_open_files_impl.hpp"
 #include "lbann/utils/serialize.hpp"
 #include "lbann/utils/timer.hpp"
 #include "lbann/utils/vectorwrapbuf.hpp"
 
+#include <algorithm>
+#include <tuple>
+
 namespace lbann {
 
 template <typename SampleListT>
@@ -75,6 +79,19 @@ template <typename SampleListT>
 void data_reader_sample_list<SampleListT>::shuffle_indices(rng_gen& gen)
 {
   generic_data_reader::shuffle_indices(gen);
+
+  // Report file handle usage of the epoch that just finished
+  const auto& stats = m_sample_list.get_file_handle_stats();
+  if (m_verbose && get_comm()->am_world_master() &&
+      (stats.num_opens + stats.num_reuses) != 0u) {
+    std::cout << "role: " << get_role()
+              << " file handles since the last shuffle: opened "
+              << stats.num_opens
+              << ", closed " << stats.num_closes
+              << ", reused " << stats.num_reuses << std::endl;
+  }
+  m_sample_list.reset_file_handle_stats();
+
   if(get_mini_batch_size() != 0) {
     m_sample_list.compute_epochs_file_usage(get_shuffled_indices(),
                                             get_mini_batch_size(),
@@ -112,6 +129,19 @@ void data_reader_sample_list<SampleListT>::load_list_of_samples(
     m_sample_list.keep_sample_order(false);
   }
 
+  // A binary index is mapped by every rank, which reads the full list
+  // directly; the pages are shared through the page cache, so neither
+  // the broadcast nor the gather below is needed
+  if (sample_list_index::is_index_file(sample_list_file)) {
+    m_sample_list.load_index(sample_list_file);
+    if (get_comm()->am_world_master()) {
+      std::cout << "Time to load sample list index '" << sample_list_file
+                << "': " << get_time() - tm1 << std::endl;
+    }
+    generic_data_reader::set_file_dir(m_sample_list.get_samples_dirname());
+    return;
+  }
+
   // Load the sample list
   if (arg_parser.get<bool>(LBANN_OPTION_LOAD_FULL_SAMPLE_LIST_ONCE)) {
     std::vector<char> buffer;
@@ -170,9 +200,8 @@ template <typename SampleListT>
 auto data_reader_sample_list<SampleListT>::open_file(size_t index)
   -> std::pair<file_handle_type, sample_name_type>
 {
-  auto [sample_id, sample_name] = m_sample_list[index];
-  m_sample_list.open_samples_file_handle(index);
-  auto file_handle_out = m_sample_list.get_samples_file_handle(sample_id);
+  auto sample_name = m_sample_list[index].second;
+  auto file_handle_out = m_sample_list.open_samples_file_handle(index);
   LBANN_ASSERT(m_sample_list.is_file_handle_valid(file_handle_out));
   return std::make_pair(file_handle_out, std::move(sample_name));
 }
@@ -183,6 +212,16 @@ void data_reader_sample_list<SampleListT>::close_file(size_t index)
   m_sample_list.close_samples_file_handle(index);
 }
 
+template <typename SampleListT>
+void data_reader_sample_list<SampleListT>::sort_indices_by_file(
+  std::vector<size_t>& indices) const
+{
+  std::sort(indices.begin(), indices.end(), [this](size_t a, size_t b) {
+    return std::tie(m_sample_list[a].first, a) <
+           std::tie(m_sample_list[b].first, b);
+  });
+}
+
 } // end of namespace lbann
 
 #endif // LBANN_DATA_READER_SAMPLE_LIST_IMPL_HPP
@@ -123,6 +123,11 @@ class sample_list {
   /// Load sample list using the given header instead of reading it from the input stream
   void load(const sample_list_header& header, std::istream& istrm, const lbann_comm& comm, bool interleave);
 
+  /** Load a binary sample list index (see sample_list_index) using the given
+   *  stride and offset on the sequence of files. The index is memory-mapped,
+   *  so only the records of the selected files are read. */
+  void load_index(const std::string& index_file, size_t stride=1, size_t offset=0);
+
   /// Restore a sample list from a serialized string
   void load_from_string(const std::string& samplelist, const lbann_comm& comm, bool interleave);
 
@@ -209,6 +214,9 @@ class sample_list {
 
   virtual void set_samples_filename(sample_file_id_t id, const std::string& filename);
 
+  /// Append a data file holding the given total number of samples and return its id
+  virtual sample_file_id_t add_samples_file(const std::string& filename, size_t num_samples_in_file);
+
   /// Reorder the sample list to its initial order
   virtual void reorder();
 
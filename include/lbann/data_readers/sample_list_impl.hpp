@@ -46,6 +46,7 @@
 
 #include "lbann/comm_impl.hpp"
 #include "lbann/data_readers/sample_list.hpp"
+#include "lbann/data_readers/sample_list_index.hpp"
 #include "lbann/utils/exception.hpp"
 #include "lbann/utils/file_utils.hpp"
 #include "lbann/utils/serialize.hpp"
@@ -312,6 +313,12 @@ inline void sample_list<sample_name_t>
        const lbann_comm& comm,
        bool interleave) {
   m_header.set_sample_list_name(samplelist_file);
+  if (sample_list_index::is_index_file(samplelist_file)) {
+    const size_t stride = interleave? comm.get_procs_per_trainer() : 1ul;
+    const size_t offset = interleave? comm.get_rank_in_trainer() : 0ul;
+    load_index(samplelist_file, stride, offset);
+    return;
+  }
   zstr::ifstream istrm(samplelist_file);
   //std::ifstream istrm(samplelist_file);
   load(istrm, comm, interleave);
@@ -343,6 +350,58 @@ inline void sample_list<sample_name_t>
   read_sample_list(istrm, stride, offset);
 }
 
+template <typename sample_name_t>
+inline void sample_list<sample_name_t>
+::load_index(const std::string& index_file,
+             size_t stride, size_t offset) {
+  const sample_list_index index(index_file);
+
+  m_header.set_sample_list_name(index_file);
+  m_header.m_is_multi_sample = index.is_multi_sample();
+  m_header.m_is_exclusive = false;
+  m_header.m_no_label_header = !index.use_label_header();
+  m_header.m_has_unused_sample_fields = index.has_unused_sample_fields();
+  m_header.m_included_sample_count = index.get_num_samples();
+  m_header.m_excluded_sample_count = index.get_num_excluded_samples();
+  m_header.m_num_files = index.get_num_files();
+  m_header.m_file_dir = std::string(index.get_file_dir());
+  m_header.m_label_filename = std::string(index.get_label_filename());
+
+  if (m_header.get_file_dir().empty() || (m_check_data_file && !check_if_dir_exists(m_header.get_file_dir()))) {
+    LBANN_ERROR("file ", index_file, " :: data root directory '",
+                m_header.get_file_dir(), "' does not exist.");
+  }
+
+  m_stride = stride;
+  m_sample_list.reserve((m_header.get_sample_count() + stride - 1ul)/stride);
+
+  static const auto sn0 = uninitialized_sample_name<sample_name_t>();
+  for (size_t f = offset; f < index.get_num_files(); f += stride) {
+    const auto file = index.get_file(f);
+    const std::string filename(index.get_file_name(f));
+    const std::string file_path = add_delimiter(m_header.get_file_dir()) + filename;
+    if (filename.empty() || (m_check_data_file && !check_if_file_exists(file_path))) {
+      LBANN_ERROR("data file '", file_path, "' does not exist.");
+    }
+
+    const sample_file_id_t id = add_samples_file(filename, file.num_samples_in_file);
+    const size_t last_sample = file.first_sample + file.num_samples;
+    for (size_t s = file.first_sample; s < last_sample; ++s) {
+      if (m_header.is_multi_sample()) {
+        const std::string sample_name(index.get_sample_name(s));
+        m_sample_list.emplace_back(id, to_sample_name_t<sample_name_t>(sample_name));
+      } else {
+        m_sample_list.emplace_back(id, sn0);
+      }
+    }
+  }
+
+  // Single-sample lists are named after the full list is assembled
+  if (stride == 1ul && !m_header.is_multi_sample()) {
+    assign_samples_name();
+  }
+}
+
 template <typename sample_name_t>
 inline void sample_list<sample_name_t>
 ::load_from_string(const std::string& samplelist,
@@ -812,6 +871,15 @@ inline void sample_list<sample_name_t>
   m_file_id_stats_map[id] = filename;
 }
 
+template <typename sample_name_t>
+inline typename sample_list<sample_name_t>::sample_file_id_t
+sample_list<sample_name_t>
+::add_samples_file(const std::string& filename, size_t num_samples_in_file) {
+  const sample_file_id_t id = m_file_id_stats_map.size();
+  m_file_id_stats_map.emplace_back(filename);
+  return id;
+}
+
 #if defined(__cpp_if_constexpr) // c++17
 template <typename sample_name_t>
 inline void sample_list<sample_name_t>
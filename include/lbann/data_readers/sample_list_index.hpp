@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_DATA_READERS_SAMPLE_LIST_INDEX_HPP
+#define LBANN_DATA_READERS_SAMPLE_LIST_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace lbann {
+
+/** @brief Read-only binary index of a sample list.
+ *
+ *  Text sample lists are parsed line by line on every rank, which
+ *  dominates start-up time for lists with millions of samples. The
+ *  index holds the same information in a form that can be used in
+ *  place: a fixed-size header, a table of fixed-width file records,
+ *  a table of fixed-width sample records, and a string table with
+ *  all file and sample names. The file is memory-mapped, so a rank
+ *  only touches the records it reads and ranks on a node share the
+ *  pages through the page cache.
+ *
+ *  Samples are stored grouped by file, in the order of the original
+ *  list. Only inclusive lists can be indexed, since enumerating the
+ *  samples of an exclusive list requires opening the data files.
+ *  Integers are stored in the byte order of the machine that wrote
+ *  the index.
+ */
+class sample_list_index {
+public:
+
+  /** @brief Identifies a sample list index file. */
+  static constexpr char magic[8] = {'L','B','A','N','N','S','L','I'};
+  /** @brief Format version written by @c convert. */
+  static constexpr uint64_t version = 1u;
+
+  /** @brief Location of a string in the string table. */
+  struct string_ref {
+    uint64_t offset;
+    uint64_t length;
+  };
+
+  /** @brief Fixed-size header at the start of the file. */
+  struct header_t {
+    char magic[8];
+    uint64_t version;
+    /** Combination of the @c flag_* values. */
+    uint64_t flags;
+    uint64_t num_files;
+    /** Number of listed (included) samples. */
+    uint64_t num_samples;
+    /** Number of samples in the data files that are not listed. */
+    uint64_t num_excluded_samples;
+    uint64_t file_table_offset;
+    uint64_t sample_table_offset;
+    uint64_t string_table_offset;
+    uint64_t string_table_size;
+    string_ref file_dir;
+    string_ref label_filename;
+    uint64_t reserved[2];
+  };
+  static_assert(sizeof(header_t) == 128, "unexpected index header size");
+
+  static constexpr uint64_t flag_multi_sample = 0x1;
+  static constexpr uint64_t flag_no_label_header = 0x2;
+  static constexpr uint64_t flag_has_unused_sample_fields = 0x4;
+
+  /** @brief Entry for a data file. */
+  struct file_record {
+    string_ref name;
+    /** Index of the file's first sample in the sample table. */
+    uint64_t first_sample;
+    /** Number of listed samples in the file. */
+    uint64_t num_samples;
+    /** Number of samples in the file, listed or not. */
+    uint64_t num_samples_in_file;
+  };
+
+  /** @brief Entry for a sample. Empty for single-sample lists. */
+  struct sample_record {
+    string_ref name;
+  };
+
+  /** @brief Whether a file starts with the index magic string. */
+  static bool is_index_file(const std::string& filename);
+
+  /** @brief Map an index file. */
+  explicit sample_list_index(const std::string& filename);
+
+  bool is_multi_sample() const;
+  bool use_label_header() const;
+  bool has_unused_sample_fields() const;
+  size_t get_num_files() const;
+  size_t get_num_samples() const;
+  size_t get_num_excluded_samples() const;
+  std::string_view get_file_dir() const;
+  std::string_view get_label_filename() const;
+
+  /** @brief Record of the i-th data file. */
+  file_record get_file(size_t i) const;
+  /** @brief Name of the i-th data file, relative to the file dir. */
+  std::string_view get_file_name(size_t i) const;
+  /** @brief Name of the i-th sample. */
+  std::string_view get_sample_name(size_t i) const;
+
+  /** @brief Write the index of a text sample list.
+   *
+   *  Accepts single-sample and inclusive multi-sample lists,
+   *  including the "a ... b" range encoding of integer sample
+   *  names. The list is not checked against the data files.
+   */
+  static void convert(std::istream& text_list,
+                      const std::string& index_filename);
+
+private:
+
+  std::string_view get_string(const string_ref& ref) const;
+
+  /** @brief Mapped file contents. */
+  std::shared_ptr<const char> m_data;
+  /** @brief Size of mapped file in bytes. */
+  size_t m_size = 0;
+  header_t m_header;
+
+};
+
+} // namespace lbann
+
+#endif // LBANN_DATA_READERS_SAMPLE_LIST_INDEX_HPP
@@ -30,6 +30,7 @@
 #include "sample_list.hpp"
 
 #include <deque>
+#include <mutex>
 
 /// Number of system and other files that may be open during execution
 #define LBANN_MAX_OPEN_FILE_MARGIN 128
@@ -57,6 +58,15 @@ class sample_list_open_files : public sample_list<sample_name_t> {
   using file_id_stats_v_t = std::vector< file_id_stats_t >; // rename to sample_to_file_v or something
   /// Type for the map of file descriptors to usage step and substep
   using fd_use_map_t = std::template pair<sample_file_id_t, std::pair<int,int>>;
+  /// Counts of file handle operations on behalf of sample accesses
+  struct file_handle_stats {
+    /// Number of files opened
+    size_t num_opens = 0u;
+    /// Number of files closed, either explicitly or to make room
+    size_t num_closes = 0u;
+    /// Number of accesses served by a file handle that was already open
+    size_t num_reuses = 0u;
+  };
 
   sample_list_open_files();
   virtual ~sample_list_open_files();
@@ -87,20 +97,35 @@ class sample_list_open_files : public sample_list<sample_name_t> {
 
   const std::string& get_samples_filename(sample_file_id_t id) const override;
 
+  /** Get the file handle of a file while holding the file handle
+    * lock, since I/O threads open and close file handles
+    * concurrently. */
   file_handle_t get_samples_file_handle(sample_file_id_t id) const;
 
   void set_files_handle(const std::string& filename, file_handle_t h);
 
   void delete_file_handle_pq_entry(sample_file_id_t id);
 
+  /** Update the priority of the open file handle of a file that is
+    * being accessed: its next use is the next step in its access
+    * queue. If too many files are open, the file whose next use is
+    * furthest in the future is closed. */
   void manage_open_file_handles(sample_file_id_t id);
 
   file_handle_t open_samples_file_handle(const size_t i);
 
   virtual void close_samples_file_handle(const size_t i, bool check_if_in_use = false);
 
+  /** Compute when each file will be used during the upcoming epoch.
+    * File handles that are already open stay open and are
+    * re-prioritized by their first use in the epoch. */
   void compute_epochs_file_usage(const std::vector<int>& shufled_indices, int mini_batch_size, const lbann_comm& comm);
 
+  /// Counts of file handle operations since the last reset
+  const file_handle_stats& get_file_handle_stats() const { return m_file_handle_stats; }
+
+  void reset_file_handle_stats() { m_file_handle_stats = file_handle_stats{}; }
+
   virtual bool is_file_handle_valid(const file_handle_t& h) const = 0;
 
   void all_gather_packed_lists(lbann_comm& comm) override;
@@ -109,6 +134,10 @@ class sample_list_open_files : public sample_list<sample_name_t> {
 
   void set_samples_filename(sample_file_id_t id, const std::string& filename) override;
 
+  /** Files added from an index are not opened; their handles are opened
+    * on first access. */
+  sample_file_id_t add_samples_file(const std::string& filename, size_t num_samples_in_file) override;
+
   void reorder() override;
 
   /// Get the list of samples from a specific type of bundle file
@@ -167,6 +196,12 @@ class sample_list_open_files : public sample_list<sample_name_t> {
   std::deque<fd_use_map_t> m_open_fd_pq;
 
   size_t m_max_open_files;
+
+  file_handle_stats m_file_handle_stats;
+
+  /// Protects the file handles and their priority queue, which are
+  /// updated on every access
+  mutable std::mutex m_open_fd_mutex;
 };
 
 template<typename T>
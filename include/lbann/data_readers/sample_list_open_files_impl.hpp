@@ -98,6 +98,7 @@ inline void sample_list_open_files<sample_name_t, file_handle_t>
   /// Do not copy the open file descriptor priority queue
   /// File handle ownership is not transfered in the copy
   m_open_fd_pq.clear();
+  m_file_handle_stats = file_handle_stats{};
 }
 
 template <typename sample_name_t, typename file_handle_t>
@@ -541,6 +542,7 @@ inline const std::string& sample_list_open_files<sample_name_t, file_handle_t>
 template <typename sample_name_t, typename file_handle_t>
 inline file_handle_t sample_list_open_files<sample_name_t, file_handle_t>
 ::get_samples_file_handle(sample_file_id_t id) const {
+  std::lock_guard<std::mutex> lock(m_open_fd_mutex);
   file_handle_t h = std::get<FID_STATS_HANDLE>(m_file_id_stats_map[id]);
   return h;
 }
@@ -551,6 +553,16 @@ inline void sample_list_open_files<sample_name_t, file_handle_t>
   std::get<FID_STATS_NAME>(m_file_id_stats_map[id]) = filename;
 }
 
+template <typename sample_name_t, typename file_handle_t>
+inline typename sample_list_open_files<sample_name_t, file_handle_t>::sample_file_id_t
+sample_list_open_files<sample_name_t, file_handle_t>
+::add_samples_file(const std::string& filename, size_t num_samples_in_file) {
+  const sample_file_id_t id = m_file_id_stats_map.size();
+  m_file_id_stats_map.emplace_back(std::make_tuple(filename, uninitialized_file_handle<file_handle_t>(), std::deque<std::pair<int,int>>{}));
+  m_file_map[filename] = num_samples_in_file;
+  return id;
+}
+
 template <typename sample_name_t, typename file_handle_t>
 inline void sample_list_open_files<sample_name_t, file_handle_t>
 ::reorder() {
@@ -756,14 +768,10 @@ inline void sample_list_open_files<sample_name_t, file_handle_t>
     LBANN_WARNING("Unable to compute file usage with empty mini-batch size");
     return;
   }
+  std::lock_guard<std::mutex> lock(m_open_fd_mutex);
   for (auto&& e : m_file_id_stats_map) {
-    auto& h = std::get<FID_STATS_HANDLE>(e);
-    close_file_handle(h);
-    clear_file_handle(h);
     std::get<FID_STATS_DEQUE>(e).clear();
   }
-  // Once all of the file handles are closed, clear the priority queue
-  m_open_fd_pq.clear();
   for (size_t i = 0; i < shuffled_indices.size(); i++) {
     int idx = shuffled_indices[i];
     const auto& s = this->m_sample_list[idx];
@@ -776,6 +784,17 @@ inline void sample_list_open_files<sample_name_t, file_handle_t>
       std::get<FID_STATS_DEQUE>(m_file_id_stats_map[index]).emplace_back(std::make_pair(step, substep));
     }
   }
+  /// Keep the files that are already open, since the new epoch is
+  /// likely to use them again, but order them by their next use
+  for (auto& entry : m_open_fd_pq) {
+    const auto& file_access_queue = std::get<FID_STATS_DEQUE>(m_file_id_stats_map[entry.first]);
+    if(!file_access_queue.empty()) {
+      entry.second = file_access_queue.front();
+    }else {
+      entry.second = std::make_pair(INT_MAX, static_cast<int>(entry.first));
+    }
+  }
+  std::make_heap(m_open_fd_pq.begin(), m_open_fd_pq.end(), pq_cmp);
 }
 
 template <typename sample_name_t, typename file_handle_t>
@@ -784,6 +803,8 @@ inline void sample_list_open_files<sample_name_t, file_handle_t>
   for (std::deque<fd_use_map_t>::iterator it = m_open_fd_pq.begin(); it!=m_open_fd_pq.end(); ++it) {
     if(it->first == id) {
       it = m_open_fd_pq.erase(it);
+      /// Erasing an arbitrary entry breaks the heap property
+      std::make_heap(m_open_fd_pq.begin(), m_open_fd_pq.end(), pq_cmp);
       break;
     }
   }
@@ -794,24 +815,20 @@ template <typename sample_name_t, typename file_handle_t>
 inline void sample_list_open_files<sample_name_t, file_handle_t>
 ::manage_open_file_handles(sample_file_id_t id) {
   /// When we enter this function the priority queue is either empty or a heap
-  if(!m_open_fd_pq.empty()) {
-    if(m_open_fd_pq.size() > m_max_open_files) {
-      auto& f = m_open_fd_pq.front();
-      auto& victim = m_file_id_stats_map[f.first];
-      auto& victim_fd = std::get<FID_STATS_HANDLE>(victim);
-      std::pop_heap(m_open_fd_pq.begin(), m_open_fd_pq.end(), pq_cmp);
-      m_open_fd_pq.pop_back();
-      close_file_handle(victim_fd);
-      clear_file_handle(victim_fd);
-    }
-
-    /// Before we can enqueue the any new access times for this descriptor,
-    /// remove any earlier descriptor
-    std::sort_heap(m_open_fd_pq.begin(), m_open_fd_pq.end(), pq_cmp);
-    if (m_open_fd_pq.front().first == id) {
-      m_open_fd_pq.pop_front();
-    }
-    std::make_heap(m_open_fd_pq.begin(), m_open_fd_pq.end(), pq_cmp);
+  /// Before we can enqueue the any new access times for this descriptor,
+  /// remove any earlier descriptor
+  delete_file_handle_pq_entry(id);
+
+  /// Make room by closing the files whose next use is furthest away
+  while(!m_open_fd_pq.empty() && m_open_fd_pq.size() >= m_max_open_files) {
+    auto& f = m_open_fd_pq.front();
+    auto& victim = m_file_id_stats_map[f.first];
+    auto& victim_fd = std::get<FID_STATS_HANDLE>(victim);
+    std::pop_heap(m_open_fd_pq.begin(), m_open_fd_pq.end(), pq_cmp);
+    m_open_fd_pq.pop_back();
+    close_file_handle(victim_fd);
+    clear_file_handle(victim_fd);
+    m_file_handle_stats.num_closes++;
   }
 
   auto& e = m_file_id_stats_map[id];
@@ -835,8 +852,14 @@ inline file_handle_t sample_list_open_files<sample_name_t, file_handle_t>
 ::open_samples_file_handle(const size_t i) {
   const sample_t& s = this->m_sample_list[i];
   sample_file_id_t id = s.first;
-  file_handle_t h = get_samples_file_handle(id);
-  if (!is_file_handle_valid(h)) {
+  std::lock_guard<std::mutex> lock(m_open_fd_mutex);
+  file_handle_t h = std::get<FID_STATS_HANDLE>(m_file_id_stats_map[id]);
+  if (is_file_handle_valid(h)) {
+    /// Move the file's priority to its next use so that eviction
+    /// follows the actual access schedule
+    m_file_handle_stats.num_reuses++;
+    manage_open_file_handles(id);
+  }else {
     const std::string& file_name = get_samples_filename(id);
     const std::string& file_dir = this->get_samples_dirname();
     const std::string file_path = add_delimiter(file_dir) + file_name;
@@ -850,6 +873,7 @@ inline file_handle_t sample_list_open_files<sample_name_t, file_handle_t>
     }
     auto& e = m_file_id_stats_map[id];
     std::get<FID_STATS_HANDLE>(e) = h;
+    m_file_handle_stats.num_opens++;
     /// If a new file is opened, place it in the priority queue
     manage_open_file_handles(id);
   }
@@ -861,7 +885,8 @@ inline void sample_list_open_files<sample_name_t, file_handle_t>
 ::close_samples_file_handle(const size_t i, bool check_if_in_use) {
   const sample_t& s = this->m_sample_list[i];
   sample_file_id_t id = s.first;
-  auto h = get_samples_file_handle(id);
+  std::lock_guard<std::mutex> lock(m_open_fd_mutex);
+  auto h = std::get<FID_STATS_HANDLE>(m_file_id_stats_map[id]);
   if (is_file_handle_valid(h)) {
     auto& e = m_file_id_stats_map[id];
     auto& file_access_queue = std::get<FID_STATS_DEQUE>(e);
@@ -870,6 +895,7 @@ inline void sample_list_open_files<sample_name_t, file_handle_t>
       close_file_handle(fh);
       clear_file_handle(fh);
       delete_file_handle_pq_entry(id);
+      m_file_handle_stats.num_closes++;
     }
   }
 }
@@ -37,6 +37,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <mutex>
+#include <thread>
 
 
 namespace lbann {
@@ -116,9 +117,11 @@ class data_store_conduit {
 
   void spill_preloaded_conduit_node(int data_id, const conduit::Node &node);
 
-  const conduit::Node & get_random_node() const;
+  /// returns a copy, since in compressed mode the sample is
+  /// decompressed for this call only
+  conduit::Node get_random_node() const;
 
-  const conduit::Node & get_random_node(const std::string &field) const;
+  conduit::Node get_random_node(const std::string &field) const;
 
   /// returns an empty node
   conduit::Node & get_empty_node(int data_id);
@@ -159,6 +162,28 @@ class data_store_conduit {
    */
   bool is_local_cache() const { return m_is_local_cache; }
 
+  /** @brief Returns "true" if owned samples are shared within a node
+   *
+   * In node-local mode, once loading is complete each rank copies the
+   * samples it owns into a shared memory segment. Ranks of the trainer
+   * that run on the same node map each other's segments and read those
+   * samples in place; only samples owned by ranks on other nodes are
+   * exchanged with MPI. Node-local mode is activated via the cmd line
+   * flag: --data_store_node_local
+   */
+  bool is_node_local_store() const { return m_is_node_local_store; }
+
+  /** @brief Returns "true" if owned samples are held compressed
+   *
+   * In compressed mode each owned sample is packed as for sending,
+   * byte-shuffled so that the bytes of equal significance in its
+   * elements are adjacent, and compressed with zlib. Samples are
+   * exchanged in this form and decompressed on first access by
+   * get_conduit_node(), i.e, in the I/O threads. Compressed mode is
+   * activated via the cmd line flag: --data_store_compress
+   */
+  bool is_compressed() const { return m_compress; }
+
   /** @brief Turn preloading on or off */
   void set_is_preloading(bool flag);
 
@@ -181,6 +206,12 @@ class data_store_conduit {
   /** @brief turns local cache mode on of off */
   void set_is_local_cache(bool flag = true) { m_is_local_cache = flag; }
 
+  /** @brief turns node-local sharing of owned samples on or off */
+  void set_is_node_local_store(bool flag = true) { m_is_node_local_store = flag; }
+
+  /** @brief turns compression of owned samples on or off */
+  void set_is_compressed(bool flag = true) { m_compress = flag; }
+
   /** @brief Check that explicit loading, preloading, and fully loaded flags are consistent */
   void check_query_flags() const;
 
@@ -285,6 +316,12 @@ class data_store_conduit {
 
   void test_imagenet_node(int sample_id, bool dereference = true);
 
+  /** @brief Returns the number of bytes held for owned samples
+   *
+   * In compressed mode this is the compressed size; the uncompressed
+   * size, compression ratio and decode cost are written to the
+   * profile file.
+   */
   size_t get_mem_usage();
 
 private :
@@ -379,6 +416,10 @@ private :
   // time to unpack nodes received from other ranks
   double m_rebuild_time = 0;
 
+  // time to decompress samples, summed over the I/O threads
+  mutable double m_decompress_time = 0;
+  mutable size_t m_num_decompressed = 0;
+
   // total time for exchange_mini_batch_data
   double m_exchange_time = 0;
 
@@ -419,6 +460,60 @@ private :
 
   bool m_is_local_cache = false;
 
+  bool m_is_node_local_store = false;
+
+  /// set once the node-local segments have been built and mapped
+  bool m_node_local_store_is_built = false;
+
+  /** @brief Shared memory segment holding the samples owned by a rank */
+  struct node_local_segment {
+    std::string name;
+    char *data = nullptr;
+    size_t length = 0;
+  };
+
+  /// segments indexed by rank in trainer; empty for ranks on other nodes
+  std::vector<node_local_segment> m_node_local_segments;
+
+  /// whether each rank in the trainer runs on this node
+  std::vector<bool> m_rank_is_node_local;
+
+  /// maps rank in trainer -> data_id -> packed sample in that rank's segment
+  std::vector<std::unordered_map<int, const conduit::uint8*>> m_node_local_samples;
+
+  /// (data_id, owner) for the current minibatch samples that are read
+  /// from node-local segments
+  std::vector<std::pair<int,int>> m_node_local_recv_data_ids;
+
+  bool m_compress = false;
+
+  /** @brief A sample decompressed by get_conduit_node
+   *
+   * 'node' refers to 'buffer', which holds the sample in the layout
+   * built by build_node_for_sending
+   */
+  struct decompressed_sample {
+    std::vector<conduit::uint8> buffer;
+    conduit::Node node;
+  };
+
+  /// guards the maps below, which are filled in by the I/O threads
+  mutable std::mutex m_decompress_mutex;
+
+  /// maps data_id -> compressed sample for the current minibatch
+  std::unordered_map<int, const conduit::uint8*> m_compressed_minibatch_data;
+
+  /// maps data_id -> samples decompressed since the last exchange
+  mutable std::unordered_map<int, decompressed_sample> m_decompressed_data;
+
+  /** @brief The last sample decompressed by each thread while
+   *  explicitly loading
+   *
+   * No exchange clears m_decompressed_data during explicit loading,
+   * so it would end up holding the whole data set decompressed
+   */
+  mutable std::unordered_map<std::thread::id, decompressed_sample> m_loading_decompressed_data;
+
   bool m_node_sizes_vary = false;
 
   /// used in exchange_data_by_sample, when sample sizes are non-uniform
@@ -510,6 +605,29 @@ private :
 
   void exchange_data_by_sample(size_t current_pos, size_t mb_size);
 
+  /** @brief Copy owned samples into a shared segment and map the
+   *  segments of the other ranks of the trainer on this node
+   *
+   *  Collective over the trainer. Falls back to MPI exchange if any
+   *  rank lacks space in /dev/shm.
+   */
+  void build_node_local_store();
+
+  /// unmaps the node-local segments
+  void release_node_local_store();
+
+  /// rebuilds a sample from a buffer packed by build_node_for_sending
+  void unpack_node_for_receiving(conduit::uint8 *buf, conduit::Node &node_out) const;
+
+  /// compresses a node built by build_node_for_sending into node_out
+  void compress_node(const conduit::Node &packed, size_t element_bytes, conduit::Node &node_out) const;
+
+  /// decompresses a sample built by compress_node
+  void decompress_node(const conduit::uint8 *buf, std::vector<conduit::uint8> &buf_out) const;
+
+  /// returns the decompressed sample; called by get_conduit_node
+  const conduit::Node & get_decompressed_node(int data_id) const;
+
   void setup_data_store_buffers();
 
   /// called by exchange_data
@@ -34,24 +34,49 @@
 #include "lbann/layers/io/input_layer.hpp"
 #include "lbann/models/model.hpp"
 
+#include <functional>
+#include <memory>
+#include <string>
+
 
 namespace lbann {
 
 /** @brief Class for LBANN batch inference algorithms.
  *
  *  This execution algorithm is meant for running inference using a trained
- *  model and samples passed by the user from an external application.  The
- *  algorithm currently assumes that there is only 1 input layer in the model,
- *  and the output layer is a softmax layer.
+ *  model and samples passed by the user from an external application, or
+ *  streamed from a data reader through the data coordinator.  The
+ *  algorithm currently assumes that there is only 1 input layer in the
+ *  model.
+ *
+ *  Inference never dispatches callbacks and never allocates error
+ *  signals. The gathered output tensor is allocated once and reused for
+ *  every mini-batch.
  */
 class batch_functional_inference_algorithm {
 public:
+  /** @brief Consumer of the outputs of a streamed mini-batch.
+   *  @param outputs Output tensor of the mini-batch, one column per
+   *         sample. It is replicated on every rank and only valid
+   *         during the call.
+   *  @param sample_indices Data reader indices of the samples, one row
+   *         per output column, if the data coordinator tracks them.
+   *         Like the outputs, they are replicated on every rank and
+   *         only valid during the call.
+   */
+  using output_handler_type =
+    std::function<void(El::Matrix<DataType, El::Device::CPU> const& outputs,
+                       El::Matrix<El::Int> const* sample_indices)>;
+
   /** Constructor. */
   batch_functional_inference_algorithm() {};
   /** Copy constructor. */
-  batch_functional_inference_algorithm(const batch_functional_inference_algorithm& other) = default;
+  batch_functional_inference_algorithm(const batch_functional_inference_algorithm& other) {};
   /** Copy assignment operator. */
-  batch_functional_inference_algorithm& operator=(const batch_functional_inference_algorithm& other) = default;
+  batch_functional_inference_algorithm& operator=(const batch_functional_inference_algorithm& other) {
+    m_output_buffer.reset();
+    return *this;
+  }
   /** Move constructor. */
   batch_functional_inference_algorithm(batch_functional_inference_algorithm&& other) = default;
   /** Move assignment operator. */
@@ -71,44 +96,145 @@ public:
    * @param[in] model A trained model
    * @param[in] samples A distributed matrix containing samples for model input
    * @param[in] mbs The max mini-batch size
+   * @param[in] output_layer Name of the layer holding class
+   *            probabilities (default: the softmax layer)
    * @return Matrix of predicted labels (by index)
    */
   template <typename DataT, El::Dist CDist, El::Dist RDist, El::DistWrap DistView, El::Device Device>
   El::Matrix<int, El::Device::CPU>
   infer(observer_ptr<model> model,
         El::DistMatrix<DataT, CDist, RDist, DistView, Device> const& samples,
-        size_t mbs) {
+        size_t mbs,
+        std::string const& output_layer = "") {
+    // Make matrix for returning predicted labels
+    El::Matrix<int, El::Device::CPU> labels(samples.Height(), 1);
+    infer_resident(*model, samples, mbs, output_layer,
+                   [&labels](size_t offset,
+                             El::Matrix<DataType, El::Device::CPU> const& outputs) {
+                     auto mb_labels = El::View(
+                       labels, El::IR(offset, offset+outputs.Width()), El::ALL);
+                     get_labels(outputs, mb_labels);
+                   });
+    return labels;
+  }
+
+  /** @brief Run model inference on samples and return the raw output tensor.
+   * @param[in] model A trained model
+   * @param[in] samples A distributed matrix containing samples for model input
+   * @param[in] mbs The max mini-batch size
+   * @param[in] output_layer Name of the output layer (default: the
+   *            softmax layer, or the last layer if there is none)
+   * @return Output tensor, one column per sample
+   */
+  template <typename DataT, El::Dist CDist, El::Dist RDist, El::DistWrap DistView, El::Device Device>
+  El::Matrix<DataType, El::Device::CPU>
+  infer_outputs(observer_ptr<model> model,
+                El::DistMatrix<DataT, CDist, RDist, DistView, Device> const& samples,
+                size_t mbs,
+                std::string const& output_layer = "") {
+    El::Matrix<DataType, El::Device::CPU> outputs;
+    infer_resident(*model, samples, mbs, output_layer,
+                   [&outputs, &samples](size_t offset,
+                                        El::Matrix<DataType, El::Device::CPU> const& mb_outputs) {
+                     // Allocate the result once the output size is known
+                     if (outputs.Width() == 0) {
+                       outputs.Resize(mb_outputs.Height(), samples.Height());
+                     }
+                     auto mb_view = El::View(
+                       outputs, El::ALL, El::IR(offset, offset+mb_outputs.Width()));
+                     El::Copy(mb_outputs, mb_view);
+                   });
+    return outputs;
+  }
+
+  /** @brief Stream samples from a data reader and run model inference.
+   *
+   * Mini-batches are fetched by the data coordinator, which prefetches
+   * the next mini-batch in the background while the current one goes
+   * through forward prop and the output handler.
+   *
+   * @param[in] model A trained model
+   * @param[in] dc Data coordinator holding the data reader
+   * @param[in] mode Execution mode of the data reader to stream
+   * @param[in] handler Consumer of the outputs of each mini-batch
+   * @param[in] output_layer Name of the output layer (default: the
+   *            softmax layer, or the last layer if there is none)
+   * @return Number of samples processed
+   */
+  size_t infer(observer_ptr<model> model,
+               data_coordinator& dc,
+               execution_mode mode,
+               output_handler_type const& handler,
+               std::string const& output_layer = "") {
+    if (!dc.is_execution_mode_valid(mode)) {
+      LBANN_ERROR("data coordinator has no data reader for execution mode ",
+                  to_string(mode));
+    }
+    auto const& l = get_output_layer(*model, output_layer);
+
+    auto c = SGDExecutionContext(mode, dc.get_mini_batch_size(mode));
+    model->reset_mode(c, mode);
+    dc.reset_mode(c);
+
+    size_t num_samples = 0;
+    bool finished = false;
+    while (!finished) {
+      dc.fetch_data(mode);
+      c.set_current_mini_batch_size(dc.get_current_mini_batch_size(mode));
+      model->forward_prop(mode, false);
+      // Kick off the background fetch of the next mini-batch before
+      // handling the outputs of this one
+      finished = dc.epoch_complete(mode);
+      auto const& outputs = gather_outputs(l);
+      handler(outputs,
+              gather_sample_indices(l, dc.get_sample_indices_per_mb(mode)));
+      num_samples += outputs.Width();
+      model->update_layers();
+      c.inc_step();
+    }
+    return num_samples;
+  }
+
+protected:
+
+  /** @brief Run model inference on all mini-batches of resident samples
+   * @param[in] model A trained model
+   * @param[in] samples A distributed matrix containing samples for model input
+   * @param[in] mbs The max mini-batch size
+   * @param[in] output_layer Name of the output layer
+   * @param[in] consume Called with the sample offset and the gathered
+   *            outputs of each mini-batch
+   */
+  template <typename DataT, El::Dist CDist, El::Dist RDist, El::DistWrap DistView, El::Device Device, typename ConsumerT>
+  void
+  infer_resident(model& model,
+                 El::DistMatrix<DataT, CDist, RDist, DistView, Device> const& samples,
+                 size_t mbs,
+                 std::string const& output_layer,
+                 ConsumerT&& consume) {
     if (mbs <= 0) {
       LBANN_ERROR("mini-batch size must be larger than 0");
     }
-
-    // Make matrix for returning predicted labels
-    size_t samples_size = samples.Height();
-    El::Matrix<int, El::Device::CPU> labels(samples_size, 1);
+    auto const& l = get_output_layer(model, output_layer);
 
     // Create an SGD_execution_context so that layer.forward_prop can get the
     // mini_batch_size - This should be fixed in the future, when SGD is not so
     // hard-coded into the model & layers
     auto c = SGDExecutionContext(execution_mode::inference, mbs);
-    model->reset_mode(c, execution_mode::inference);
+    model.reset_mode(c, execution_mode::inference);
 
     // Infer on mini batches
+    size_t samples_size = samples.Height();
     for (size_t i = 0; i < samples_size; i+=mbs) {
       size_t mb_idx = std::min(i+mbs, samples_size);
       auto mb_range = El::IR(i, mb_idx);
       auto mb_samples = El::LockedView(samples, mb_range, El::ALL);
-      auto mb_labels = El::View(labels, mb_range, El::ALL);
 
-      infer_mini_batch(*model, mb_samples);
-      get_labels(*model, mb_labels);
+      infer_mini_batch(model, mb_samples);
+      consume(i, gather_outputs(l));
     }
-
-    return labels;
   }
 
-
-protected:
-
   /** @brief Run model inference on a single mini-batch of samples
    * This method takes a mini-batch of samples, inserts them into the input
    * layer of the model, and runs forward prop on the model.
@@ -127,42 +253,119 @@ protected:
         il.set_samples(samples);
       }
     }
-    model.forward_prop(execution_mode::inference);
+    model.forward_prop(execution_mode::inference, false);
   }
 
-  /** @brief Finds the predicted category in a models softmax layer
-   * @param[in] model A model that has been used for inference
-   * @param[in] labels A matrix to place predicted category labels
+  /** @brief Find the layer whose outputs are returned
+   * @param[in] model A trained model
+   * @param[in] name Layer name. If empty, the softmax layer is used,
+   *            or the last layer if there is none.
    */
-  void get_labels(model& model,\
-                  El::Matrix<int, El::Device::CPU> &labels) {
-    int pred_label = 0;
-    float max, col_value;
-
+  data_type_layer<DataType> const& get_output_layer(model& model,
+                                                    std::string const& name) {
+    Layer const* output = nullptr;
     for (const auto* l : model.get_layers()) {
-      // Find the output layer
-      if (l->get_type() == "softmax") {
-        auto const& dtl = dynamic_cast<lbann::data_type_layer<float> const&>(*l);
-        const auto& outputs = dtl.get_activations();
-
-        // Find the prediction for each sample
-        int col_count = outputs.Width();
-        int row_count = outputs.Height();
-        for (int i=0; i<col_count; i++) {
-          max = 0;
-          for (int j=0; j<row_count; j++) {
-            col_value = outputs.Get(i, j);
-            if (col_value > max) {
-              max = col_value;
-              pred_label = j;
-            }
-          }
-          labels(i) = pred_label;
+      if (name.empty() ? l->get_type() == "softmax" : l->get_name() == name) {
+        output = l;
+      }
+    }
+    if (output == nullptr && name.empty() && model.get_num_layers() > 0) {
+      output = &model.get_layer(model.get_num_layers()-1);
+    }
+    if (output == nullptr) {
+      LBANN_ERROR("could not find output layer \"", name, "\" "
+                  "in model \"", model.get_name(), "\"");
+    }
+    auto const* dtl = dynamic_cast<data_type_layer<DataType> const*>(output);
+    if (dtl == nullptr) {
+      LBANN_ERROR("output layer \"", output->get_name(), "\" "
+                  "does not use the default data type");
+    }
+    return *dtl;
+  }
+
+  /** @brief Gather the outputs of a layer on every rank
+   * The gather buffer is allocated on first use and reused afterwards.
+   * @param[in] l A layer that has been used for inference
+   * @return Local view of the gathered outputs
+   */
+  El::Matrix<DataType, El::Device::CPU> const&
+  gather_outputs(data_type_layer<DataType> const& l) {
+    const auto& outputs = l.get_activations();
+    if (m_output_buffer == nullptr
+        || &m_output_buffer->Grid() != &outputs.Grid()) {
+      m_output_buffer = std::make_unique<StarMatDT<DataType, El::Device::CPU>>(
+        outputs.Grid());
+    }
+    El::Copy(outputs, *m_output_buffer);
+    return m_output_buffer->LockedMatrix();
+  }
+
+  /** @brief Gather the data reader indices of a layer's samples
+   * The data coordinator only holds the indices of the local samples,
+   * sized for a full mini-batch. They are distributed like the layer
+   * outputs and gathered on every rank, so that they line up with the
+   * columns returned by gather_outputs.
+   * @param[in] l A layer that has been used for inference
+   * @param[in] local_indices Indices of the local samples
+   * @return Gathered indices, or a null pointer if there are none
+   */
+  El::Matrix<El::Int> const*
+  gather_sample_indices(data_type_layer<DataType> const& l,
+                        El::Matrix<El::Int> const* local_indices) {
+    if (local_indices == nullptr) {
+      return nullptr;
+    }
+    const auto& outputs = l.get_activations();
+    El::DistMatrix<El::Int, El::STAR, El::VC, El::ELEMENT, El::Device::CPU>
+      dist_indices(1, outputs.Width(), outputs.Grid());
+    const El::Int local_width = dist_indices.LocalWidth();
+    if (local_indices->Height() < local_width) {
+      LBANN_ERROR("could not match ", local_width, " local samples "
+                  "in layer \"", l.get_name(), "\" "
+                  "to data sample indices");
+    }
+    for (El::Int j = 0; j < local_width; ++j) {
+      dist_indices.SetLocal(0, j, local_indices->Get(j, 0));
+    }
+    El::DistMatrix<El::Int, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>
+      indices(dist_indices);
+    m_index_buffer.Resize(outputs.Width(), 1);
+    for (El::Int j = 0; j < outputs.Width(); ++j) {
+      m_index_buffer(j, 0) = indices.GetLocal(0, j);
+    }
+    return &m_index_buffer;
+  }
+
+  /** @brief Finds the predicted category of each sample
+   * @param[in] outputs Class probabilities, one column per sample
+   * @param[in] labels A matrix to place predicted category labels
+   */
+  static void get_labels(El::Matrix<DataType, El::Device::CPU> const& outputs,
+                         El::Matrix<int, El::Device::CPU>& labels) {
+    const El::Int col_count = outputs.Width();
+    const El::Int row_count = outputs.Height();
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int col = 0; col < col_count; ++col) {
+      int pred_label = 0;
+      DataType max = outputs(0, col);
+      for (El::Int row = 1; row < row_count; ++row) {
+        if (outputs(row, col) > max) {
+          max = outputs(row, col);
+          pred_label = row;
         }
       }
+      labels(col) = pred_label;
     }
   }
 
+private:
+
+  /** @brief Output tensor gathered on every rank */
+  std::unique_ptr<StarMatDT<DataType, El::Device::CPU>> m_output_buffer;
+  /** @brief Sample indices gathered on every rank */
+  El::Matrix<El::Int> m_index_buffer;
+
 };
 
 }  // namespace lbann
@@ -87,7 +87,9 @@ public:
     std::vector<std::string> disable_layers,
     double learning_rate_factor,
     double learning_rate_factor_gru,
-    size_t compute_interval);
+    size_t compute_interval,
+    bool async_inverse = false,
+    size_t max_inverse_staleness = max_inverse_staleness_default);
 
   KFAC(KFAC const& other);
   KFAC& operator=(const KFAC& other);
@@ -130,6 +132,10 @@ public:
   /** @brief The default parameters of the decay factor. */
   constexpr static const double kronecker_decay_default = 0.99;
 
+  /** @brief The default number of steps an asynchronous inverse may
+   *  lag behind the factors it was computed from. */
+  constexpr static const size_t max_inverse_staleness_default = 1;
+
   /** @brief Parameters for prof_region_*. */
   constexpr static const bool prof_sync = true;
   constexpr static const int prof_color = 0;
@@ -197,6 +203,21 @@ private:
 
   void sync_weights_model(model& model, lbann_comm *comm);
 
+  /** @brief Allgather the inverses computed by each process. */
+  void allgather_kronecker_inverses(
+    ExeContextType& context,
+    lbann_comm& comm);
+
+  /** @brief Install finished asynchronous inverses and start new
+   *  ones.
+   *  @returns Whether any inverse changed and must be allgathered.
+   */
+  bool update_async_kronecker_inverses(
+    ExeContextType& context,
+    lbann_comm& comm,
+    size_t num_steps,
+    bool is_kronecker_update_required);
+
   /** @brief The KFAC stopping criteria. */
   std::unique_ptr<TermCriteriaType> m_stopping_criteria;
 
@@ -241,6 +262,18 @@ private:
   bool m_has_kronecker_inverse=false;
   size_t m_compute_interval;
 
+  /** @brief Whether to invert the Kronecker factors on helper threads
+   *  while preconditioning with the previous inverse. */
+  bool m_async_inverse;
+
+  /** @brief Number of steps after which an asynchronous inverse is
+   *  waited for and installed. */
+  size_t m_max_inverse_staleness;
+
+  /** @brief State of the in-flight asynchronous inverses. */
+  bool m_has_pending_inverse=false;
+  size_t m_pending_inverse_step=0;
+
   El::Matrix<double, El::Device::CPU> m_inverse_matrices_size;
 
 }; // class KFAC
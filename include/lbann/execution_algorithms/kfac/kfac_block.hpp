@@ -30,6 +30,8 @@
 #include "lbann/execution_algorithms/kfac/execution_context.hpp"
 #include "lbann/layers/layer.hpp"
 
+#include <future>
+
 namespace lbann {
 
 // Forward declaration
@@ -94,6 +96,34 @@ class kfac_block {
     LBANN_ERROR("this function should be called via a sub-class.");
   }
 
+  /** @brief Whether update_kronecker_inverse may be replaced by
+   *  start/finish_async_kronecker_inverse. */
+  virtual bool supports_async_kronecker_inverse() const {
+    return false;
+  }
+
+  /** @brief Start inverting a snapshot of the average Kronecker
+   *  factors on a helper thread.
+   *
+   *  The current inverse is left untouched and keeps being used for
+   *  preconditioning until finish_async_kronecker_inverse is called.
+   *  Only supported for CPU blocks.
+   */
+  void start_async_kronecker_inverse(
+      lbann_comm* comm,
+      bool use_pi,
+      DataType damping_act, DataType damping_err,
+      bool print_time);
+
+  /** @brief Whether an asynchronous inverse is in flight. */
+  bool has_pending_kronecker_inverse() const {
+    return m_async_inverse.valid();
+  }
+
+  /** @brief Wait for the asynchronous inverse (if any) and install
+   *  it as the current inverse. */
+  void finish_async_kronecker_inverse();
+
   /** @brief Compute the inverse of the average Kronecker factors. */
   virtual void compute_preconditioned_gradients(
       lbann_comm* comm,
@@ -197,6 +227,31 @@ class kfac_block {
   /** @brief Return the default sync info that may used in update functions. */
   El::SyncInfo<Device> get_sync_info();
 
+  /** @brief Average Kronecker factors read by the inversion. */
+  virtual std::vector<El::Matrix<DataType, Device>*>
+  get_kronecker_average_matrices() {
+    LBANN_ERROR("this function should be called via a sub-class.");
+  }
+
+  /** @brief Inverse Kronecker factors, in the same order as
+   *  get_kronecker_average_matrices. */
+  virtual std::vector<El::Matrix<DataType, Device>*>
+  get_kronecker_inverse_matrices() {
+    LBANN_ERROR("this function should be called via a sub-class.");
+  }
+
+  /** @brief Invert damped factors into @p inverses.
+   *  This runs on a helper thread, so it must only touch its
+   *  arguments and thread-local workspaces. */
+  virtual void invert_kronecker_factors(
+      const std::vector<El::Matrix<DataType, Device>>& averages,
+      std::vector<El::Matrix<DataType, Device>>& inverses,
+      bool use_pi,
+      DataType damping_act, DataType damping_err,
+      bool print_time) {
+    LBANN_ERROR("this function should be called via a sub-class.");
+  }
+
   /** @brief The target layer. */
   Layer *m_layer;
 
@@ -225,6 +280,16 @@ class kfac_block {
    *  TODO: Use its own workspace and remove this pointer. */
   kfac::KFACExecutionContext* m_context;
 
+  /** @brief Snapshot of the average factors and the inverses being
+   *  computed by the helper thread. */
+  std::vector<El::Matrix<DataType, Device>>
+  m_async_averages, m_async_inverses;
+
+  /** @brief Handle of the in-flight asynchronous inverse.
+   *  Declared last so that it is joined before the buffers it uses
+   *  are destroyed. */
+  std::future<void> m_async_inverse;
+
 };
 
 } // namespace lbann
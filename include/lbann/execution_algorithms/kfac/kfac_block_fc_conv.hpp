@@ -145,6 +145,10 @@ class kfac_block_fc_conv: public kfac_block<Device> {
       bool print_matrix_summary,
       bool print_time) override;
 
+  bool supports_async_kronecker_inverse() const override {
+    return true;
+  }
+
   void compute_preconditioned_gradients(
       lbann_comm* comm,
       DataType learning_rate_factor,
@@ -220,6 +224,23 @@ class kfac_block_fc_conv: public kfac_block<Device> {
   std::vector<std::tuple<std::string, size_t, size_t>>
   get_internal_matrix_info() const override;
 
+  std::vector<El::Matrix<DataType, Device>*>
+  get_kronecker_average_matrices() override {
+    return {&m_kronecker_average_A, &m_kronecker_average_G};
+  }
+
+  std::vector<El::Matrix<DataType, Device>*>
+  get_kronecker_inverse_matrices() override {
+    return {&m_kronecker_inverse_A, &m_kronecker_inverse_G};
+  }
+
+  void invert_kronecker_factors(
+      const std::vector<El::Matrix<DataType, Device>>& averages,
+      std::vector<El::Matrix<DataType, Device>>& inverses,
+      bool use_pi,
+      DataType damping_act, DataType damping_err,
+      bool print_time) override;
+
   /** @brief Information to perform its computation. **/
   const bool m_is_conv, m_has_bias;
   size_t m_conv_input_spatial_prod, m_conv_output_spatial_prod;
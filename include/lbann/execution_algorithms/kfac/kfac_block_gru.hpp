@@ -160,6 +160,10 @@ class kfac_block_gru: public kfac_block<Device> {
       bool print_matrix_summary,
       bool print_time) override;
 
+  bool supports_async_kronecker_inverse() const override {
+    return true;
+  }
+
   void compute_preconditioned_gradients(
       lbann_comm* comm,
       DataType learning_rate_factor,
@@ -240,6 +244,20 @@ class kfac_block_gru: public kfac_block<Device> {
   std::vector<std::tuple<std::string, size_t, size_t>>
   get_internal_matrix_info() const override;
 
+  /** @brief A_h, A_x, then G in LEARNABLE_MATRICES order. **/
+  std::vector<El::Matrix<DataType, Device>*>
+  get_kronecker_average_matrices() override;
+
+  std::vector<El::Matrix<DataType, Device>*>
+  get_kronecker_inverse_matrices() override;
+
+  void invert_kronecker_factors(
+      const std::vector<El::Matrix<DataType, Device>>& averages,
+      std::vector<El::Matrix<DataType, Device>>& inverses,
+      bool use_pi,
+      DataType damping_act, DataType damping_err,
+      bool print_time) override;
+
   /** @brief Get the pointer to its GRU_layer. **/
   gru_layer<DataType, data_layout::DATA_PARALLEL, Device>*
   get_gru_layer() const {
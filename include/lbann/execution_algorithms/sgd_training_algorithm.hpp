@@ -46,11 +46,18 @@ class SGDTrainingAlgorithm
   using BaseType = Cloneable<SGDTrainingAlgorithm, TrainingAlgorithm>;
 
 public:
-  /** @brief Construct with a name. */
+  /** @brief Construct with a name.
+   *
+   *  @param num_micro_batches Number of mini-batches whose gradients
+   *  are accumulated locally before they are reduced and applied in
+   *  one optimization step.
+   */
   SGDTrainingAlgorithm(std::string name,
-                         std::unique_ptr<SGDTerminationCriteria> stop)
+                         std::unique_ptr<SGDTerminationCriteria> stop,
+                         size_t num_micro_batches = 1UL)
     : BaseType{std::move(name)},
       m_stopping_criteria{std::move(stop)},
+      m_num_micro_batches{num_micro_batches},
       m_validation_context{execution_mode::validation, 1UL},
       m_validation_epochs{1UL}
   {}
@@ -105,7 +112,13 @@ public:
   }
 
 protected:
-  /** Train model on one step / mini-batch of an SGD forward pass */
+  /** Train model on one step of an SGD forward pass
+   *
+   *  A step runs forward and backward prop on up to
+   *  @c m_num_micro_batches mini-batches, stopping early at the end
+   *  of an epoch, and then updates the weights with the averaged
+   *  gradient.
+   */
   virtual bool train_mini_batch(SGDExecutionContext& c,
                                 model& model,
                                 data_coordinator& dc);
@@ -143,6 +156,14 @@ protected:
 private:
   std::unique_ptr<SGDTerminationCriteria> m_stopping_criteria;
 
+  /** @brief Number of mini-batches per optimization step.
+   *
+   *  Gradients of each mini-batch ("micro-batch") are accumulated
+   *  locally and the gradient allreduce is only launched for the last
+   *  one.
+   */
+  size_t m_num_micro_batches;
+
   // FIXME (trb 07/20/21): This is a hack. These aren't actually
   // copyable objects (it wouldn't make sense), so when the training
   // algorithm is copied, these are reset to defaults. "In the
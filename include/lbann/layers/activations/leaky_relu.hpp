@@ -72,6 +72,7 @@ public:
   std::string get_type() const override { return "leaky ReLU"; }
   data_layout get_data_layout() const override { return Layout; }
   El::Device get_device_allocation() const override { return Device; }
+  bool can_recompute_outputs() const override { return true; }
 
   description get_description() const override {
     auto desc = data_type_layer<TensorDataType>::get_description();
@@ -155,6 +155,11 @@ public:
   void fp_compute() final;
   void bp_compute() final;
 
+#ifdef LBANN_HAS_ONEDNN_CPU
+  // oneDNN softmax requires matching strides
+  bool supports_strided_tensors() const final { return false; }
+#endif // LBANN_HAS_ONEDNN_CPU
+
   template <typename U>
   friend void fp_compute_impl(softmax_layer<U, Layout, Device>& l);
   template <typename U>
@@ -129,6 +129,16 @@ public:
   /** Get error signal tensor corresponding to parent layer. */
   const InputAbsDistMatrixType& get_error_signals(const Layer& parent) const override;
 
+  void discard_outputs() override;
+  void recompute_outputs() override;
+  void refresh_inputs() override;
+  size_t get_output_memory_usage(El::Int mini_batch_size) const override;
+  size_t get_error_signal_memory_usage(El::Int mini_batch_size) const override;
+
+  void set_output_alias(const Layer& child,
+                        BaseDistMat* target,
+                        El::Int row_offset) override;
+
   /** Get temp Grad Tensor. */
   OutputAbsDistMatrixType& get_temp_grad() ;
   /** Get transfered input for each branch tag **/
@@ -237,7 +247,8 @@ protected:
   void fp_setup_inputs(El::Int mini_batch_size) override;
   /** Setup output tensors.
    *  Called by the 'forward_prop' function. Each output tensor is
-   *  resized to match the mini-batch size.
+   *  resized to match the mini-batch size, or set up as a view into
+   *  its alias target (see set_output_alias).
    */
   void fp_setup_outputs(El::Int mini_batch_size) override;
 
@@ -289,6 +300,14 @@ protected:
   void setup_inter_subgrid_comm_based_on_childs(const El::Grid& grid);
   void setup_inter_subgrid_comm_based_on_parents(const El::Grid& grid);
 
+  /** @brief Whether the compute functions handle local matrices whose
+   *         leading dimension is larger than their height.
+   *
+   *  If not, strided input tensors are copied instead of viewed and
+   *  output tensors are not written into alias targets.
+   */
+  virtual bool supports_strided_tensors() const { return true; }
+
 private:
 
   /** @brief Attempt to take ownership of the previous error signal.
@@ -396,6 +415,11 @@ private:
    *  Each matrix column corresponds to a flattened mini-batch sample.
    */
   std::vector<std::unique_ptr<OutputAbsDistMatrixType>> m_outputs;
+  /** Tensors that output tensors are written into.
+   *  Each entry is a target tensor and a row offset, as set by
+   *  set_output_alias. Not copied with the layer.
+   */
+  std::vector<std::pair<BaseDistMat*, El::Int>> m_output_aliases;
   /** Objective function gradients w.r.t. the output tensors.
    *  Each matrix column corresponds to a flattened mini-batch sample.
    */
@@ -560,6 +560,119 @@ public:
   /** @brief Get error signal tensor corresponding to parent layer. */
   virtual const BaseDistMat& get_error_signals(const Layer& parent) const = 0;
 
+  /** @brief Write the activation tensor for a child layer into
+   *         another tensor.
+   *
+   *  The output tensor corresponding to @c child becomes a view into
+   *  the rows of @c target starting at @c row_offset and its leading
+   *  mini-batch columns, so the child can use @c target without
+   *  copying the data. @c target is never resized by the layer and
+   *  must be wide enough for the max mini-batch size. The request is
+   *  ignored if the tensors are incompatible or if the layer sets up
+   *  its own output tensors. A null @c target clears the request.
+   */
+  virtual void set_output_alias(const Layer& child,
+                                BaseDistMat* target,
+                                El::Int row_offset) {}
+
+  ///@}
+  /** @name Activation recomputation */
+  ///@{
+
+  /** @brief Whether the output tensors can be discarded after
+   *         forward prop and recomputed from the input tensors.
+   *
+   *  Requires a cheap forward prop that is deterministic and has no
+   *  side effects, e.g. entrywise activations.
+   */
+  virtual bool can_recompute_outputs() const { return false; }
+  /** @brief Free the memory of the output tensors.
+   *
+   *  Output tensors that are views into other tensors are left
+   *  alone.
+   */
+  virtual void discard_outputs() {}
+  /** @brief Recompute output tensors freed with discard_outputs.
+   *
+   *  The input tensors must be available. Child layers must call
+   *  refresh_inputs afterward.
+   */
+  virtual void recompute_outputs() {}
+  /** @brief Set up the input tensors again after a parent layer has
+   *         recomputed its output tensors. */
+  virtual void refresh_inputs() {}
+
+  ///@}
+  /** @name Memory usage
+   *  Local memory in bytes, estimated from the tensor dimensions and
+   *  distributions for a given mini-batch size.
+   */
+  ///@{
+
+  /** @brief Memory needed by the output tensors. */
+  virtual size_t get_output_memory_usage(El::Int mini_batch_size) const {
+    return 0;
+  }
+  /** @brief Memory needed by the error signals w.r.t. the input
+   *         tensors. */
+  virtual size_t get_error_signal_memory_usage(El::Int mini_batch_size) const {
+    return 0;
+  }
+  /** @brief Memory needed by workspaces.
+   *
+   *  Includes buffers kept from forward prop to backprop (e.g. dropout
+   *  masks) and temporary buffers (e.g. im2col matrices).
+   */
+  virtual size_t get_workspace_memory_usage(El::Int mini_batch_size) const {
+    return 0;
+  }
+
+  ///@}
+
+  /** @brief Whether forward prop draws from the global random number
+   *         generators.
+   *
+   *  The generators are not thread-safe and must be drawn from in a
+   *  reproducible order, so such layers are never run concurrently.
+   */
+  virtual bool uses_random_number_generators() const { return false; }
+
+  /** @name Split forward prop
+   *  Some layers have a blocking allreduce in the middle of forward
+   *  prop, e.g. batch statistics. If split, forward prop stops before
+   *  the allreduce and leaves a pending reduction buffer. The model
+   *  then sums the buffer, possibly together with other layers or
+   *  while running layers that do not depend on this one, and calls
+   *  finish_forward_prop before any child runs.
+   */
+  ///@{
+
+  /** @brief Whether forward prop can be split around an allreduce. */
+  virtual bool can_split_forward_prop() const { return false; }
+  /** @brief Stop forward prop before its allreduce. */
+  virtual void set_split_forward_prop(bool split) {}
+  /** @brief Buffer waiting to be summed over
+   *         get_pending_reduction_comm.
+   *
+   *  Null if forward prop is not waiting on an allreduce or if it has
+   *  already been started with start_pending_reduction.
+   */
+  virtual El::BaseDistMatrix* get_pending_reduction() { return nullptr; }
+  /** @brief Communicator for the pending reduction. */
+  virtual const El::mpi::Comm* get_pending_reduction_comm() const {
+    return nullptr;
+  }
+  /** @brief Start a non-blocking allreduce on the pending reduction
+   *         buffer. */
+  virtual void start_pending_reduction() {}
+  /** @brief Complete a split forward prop.
+   *
+   *  The pending reduction buffer must have been summed, or the
+   *  allreduce started with start_pending_reduction, which is waited
+   *  on. Does nothing if forward prop is not waiting.
+   */
+  virtual void finish_forward_prop() {}
+
   ///@}
   /** @name Tensor dimension access functions */
   ///@{
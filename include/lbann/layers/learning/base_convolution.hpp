@@ -172,6 +172,8 @@ public:
 #endif // LBANN_HAS_DNN_LIB
 
   description get_description() const override;
+  /** @brief Memory needed by the im2col matrix of one sample on CPU. */
+  size_t get_workspace_memory_usage(El::Int mini_batch_size) const override;
   void setup_dims(DataReaderMetaData& dr_metadata) override;
 
   /** @brief Setup layer data.
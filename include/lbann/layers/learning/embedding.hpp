@@ -104,7 +104,6 @@ protected:
   friend class cereal::access;
   embedding_layer();
 
-  void setup_matrices(const El::Grid& grid) override;
   void setup_dims(DataReaderMetaData& dr_metadata) override;
   void setup_data(size_t max_mini_batch_size) override;
 
@@ -123,9 +122,6 @@ private:
    */
   El::Int m_padding_idx;
 
-  /** Gradient w.r.t. embedding weights. */
-  std::unique_ptr<AbsDistMatrixType> m_embeddings_grad;
-
 };
 
 // =========================================================
@@ -153,10 +149,7 @@ embedding_layer<TensorDataType,Layout,Device>::embedding_layer(
   : data_type_layer<TensorDataType>(other),
     m_num_embeddings{other.m_num_embeddings},
     m_embedding_dim{other.m_embedding_dim},
-    m_padding_idx{other.m_padding_idx},
-    m_embeddings_grad(other.m_embeddings_grad
-                      ? other.m_embeddings_grad->Copy()
-                      : nullptr) {}
+    m_padding_idx{other.m_padding_idx} {}
 
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 embedding_layer<TensorDataType,Layout,Device>& embedding_layer<TensorDataType,Layout,Device>::operator=(
@@ -165,9 +158,6 @@ embedding_layer<TensorDataType,Layout,Device>& embedding_layer<TensorDataType,La
   m_num_embeddings = other.m_num_embeddings;
   m_embedding_dim = other.m_embedding_dim;
   m_padding_idx = other.m_padding_idx;
-  m_embeddings_grad.reset(other.m_embeddings_grad
-                          ? other.m_embeddings_grad->Copy()
-                          : nullptr);
   return *this;
 }
 
@@ -257,9 +247,6 @@ void embedding_layer<TensorDataType,Layout,Device>::setup_data(size_t max_mini_b
     El::Zero(*pad_embedding);
   }
 
-  // Initialize gradient w.r.t. embeddings
-  m_embeddings_grad->Resize(m_embedding_dim, m_num_embeddings);
-
 }
 
 LBANN_DEFINE_LAYER_BUILDER(embedding);
@@ -77,6 +77,8 @@ protected:
   void setup_dims(DataReaderMetaData& dr_metadata) override;
   void fp_compute() override;
   void bp_compute() override;
+  /** Mini-batch samples are processed as a strided batch. */
+  bool supports_strided_tensors() const override { return false; }
 
 private:
 
@@ -80,6 +80,7 @@ public:
   std::string get_type() const final;
   data_layout get_data_layout() const final;
   El::Device get_device_allocation() const final;
+  bool can_recompute_outputs() const final { return true; }
 
   void fp_compute() final;
   void bp_compute() final;
@@ -30,6 +30,9 @@
 #include "lbann/layers/data_type_layer.hpp"
 #include "lbann/models/model.hpp"
 #include "lbann/utils/distconv.hpp"
+#include "lbann/weights/weights_helpers.hpp"
+
+#include <limits>
 
 namespace lbann {
 
@@ -121,6 +124,30 @@ private:
    * Indexed by effective mini-batch size.
    */
   std::unordered_map<El::Int, El::Int> m_num_per_sum_cache;
+  /** @brief Training steps between averaging the running statistics
+   *         over all processes
+   *
+   *  Only used with local or grouped statistics, so that the running
+   *  statistics used in inference are the same on every process. If
+   *  this is 0, the running statistics are never averaged.
+   */
+  size_t m_running_statistics_sync_interval;
+  /** @brief Training step when the running statistics were last
+   *         averaged
+   *
+   *  A step with several micro-batches runs forward prop several
+   *  times, but the running statistics are averaged only once.
+   */
+  size_t m_last_sync_step = std::numeric_limits<size_t>::max();
+
+  /** Whether forward prop stops before the statistics allreduce. */
+  bool m_split_forward_prop = false;
+  /** Whether forward prop is waiting on the statistics allreduce. */
+  bool m_statistics_pending = false;
+  /** Whether a non-blocking statistics allreduce is in progress. */
+  bool m_statistics_allreduce_started = false;
+  /** Request for non-blocking statistics allreduce. */
+  Al::request m_statistics_allreduce_req;
 
   /** @brief Current minibatch means and standard deviations.
    *
@@ -153,14 +180,19 @@ public:
    *  @param epsilon A small number to avoid division by zero.
    *  @param statistics_group_size Number of processors to aggregate
    *         statistics over. Defaults to 1 (i.e. local aggregation).
+   *  @param running_statistics_sync_interval Training steps between
+   *         averaging the running statistics over all processes.
+   *         Defaults to 0 (i.e. never).
    */
   batch_normalization_layer(TensorDataType decay=0.9,
                             TensorDataType epsilon=1e-5,
-                            int statistics_group_size=1)
+                            int statistics_group_size=1,
+                            size_t running_statistics_sync_interval=0)
     : data_type_layer<TensorDataType>(nullptr),
       m_decay(decay),
       m_epsilon(epsilon),
-      m_statistics_group_size(statistics_group_size) {
+      m_statistics_group_size(statistics_group_size),
+      m_running_statistics_sync_interval(running_statistics_sync_interval) {
 #ifdef LBANN_DETERMINISTIC
     // Force global computation.
     m_statistics_group_size = 0;
@@ -173,6 +205,9 @@ public:
       m_epsilon(other.m_epsilon),
       m_statistics_group_size(other.m_statistics_group_size),
       m_num_per_sum_cache(other.m_num_per_sum_cache),
+      m_running_statistics_sync_interval(other.m_running_statistics_sync_interval),
+      m_last_sync_step(other.m_last_sync_step),
+      m_split_forward_prop(other.m_split_forward_prop),
       m_mean_and_var(other.m_mean_and_var ?
                      other.m_mean_and_var->Copy() : nullptr),
       m_mean_v(other.m_mean_v ? other.m_mean_v->Copy() : nullptr),
@@ -194,6 +229,9 @@ public:
     m_epsilon = other.m_epsilon;
     m_statistics_group_size = other.m_statistics_group_size;
     m_num_per_sum_cache = other.m_num_per_sum_cache;
+    m_running_statistics_sync_interval = other.m_running_statistics_sync_interval;
+    m_last_sync_step = other.m_last_sync_step;
+    m_split_forward_prop = other.m_split_forward_prop;
 
     // Deep copy matrices
     m_mean_and_var.reset(other.m_mean_and_var ?
@@ -226,9 +264,44 @@ public:
     desc.add("Decay", m_decay);
     desc.add("Epsilon", m_epsilon);
     desc.add("Statistics group size", m_statistics_group_size);
+    if (m_running_statistics_sync_interval > 0) {
+      desc.add("Running statistics sync interval",
+               m_running_statistics_sync_interval);
+    }
     return desc;
   }
 
+  /** @name Split forward prop */
+  ///@{
+
+  bool can_split_forward_prop() const override {
+    return Dev == El::Device::CPU && m_statistics_group_size != 1;
+  }
+  void set_split_forward_prop(bool split) override {
+    m_split_forward_prop = split;
+  }
+  El::BaseDistMatrix* get_pending_reduction() override {
+    if (!m_statistics_pending || m_statistics_allreduce_started) {
+      return nullptr;
+    }
+    return m_mean_and_var.get();
+  }
+  const El::mpi::Comm* get_pending_reduction_comm() const override {
+    return &get_statistics_comm();
+  }
+  void start_pending_reduction() override {
+    if (m_statistics_pending && !m_statistics_allreduce_started) {
+      this->get_comm()->nb_allreduce(*m_mean_and_var,
+                                     get_statistics_comm(),
+                                     m_statistics_allreduce_req,
+                                     El::mpi::SUM);
+      m_statistics_allreduce_started = true;
+    }
+  }
+  void finish_forward_prop() override;
+
+  ///@}
+
   /** @name Serialization */
   ///@{
 
@@ -386,6 +459,45 @@ protected:
   void fp_compute() override;
   void bp_compute() override;
 
+  /** @brief Communicator for aggregating statistics. */
+  const El::mpi::Comm& get_statistics_comm() const {
+    if (m_statistics_group_size == 0) {
+      return m_mean_and_var->RedundantComm();
+    } else {
+      return this->get_comm()->get_packed_group_comm(m_statistics_group_size);
+    }
+  }
+
+  /** @brief Average the running statistics over all processes
+   *
+   *  Called after the running statistics are updated in training.
+   *  Does nothing with global statistics, which are already the same
+   *  on every process, or if the sync interval has not elapsed. With
+   *  micro-batches, only the first forward prop of a step averages.
+   */
+  void sync_running_statistics() {
+    if (m_running_statistics_sync_interval == 0
+        || m_statistics_group_size == 0) {
+      return;
+    }
+    const auto& c = this->m_model->get_execution_context();
+    if ((c.get_step() + 1) % m_running_statistics_sync_interval != 0
+        || c.get_step() == m_last_sync_step) {
+      return;
+    }
+    m_last_sync_step = c.get_step();
+    using ValuesGetter = weights_details::SafeWeightsAccessor<TensorDataType>;
+    auto& running_mean = ValuesGetter::mutable_values(this->get_weights(2));
+    auto& running_var = ValuesGetter::mutable_values(this->get_weights(3));
+    auto& comm = *this->get_comm();
+    comm.allreduce(running_mean, running_mean.RedundantComm(), El::mpi::SUM);
+    comm.allreduce(running_var, running_var.RedundantComm(), El::mpi::SUM);
+    const auto scale = (El::TypeTraits<TensorDataType>::One()
+                        / El::To<TensorDataType>(running_mean.RedundantSize()));
+    El::Scale(scale, running_mean);
+    El::Scale(scale, running_var);
+  }
+
 #ifdef LBANN_HAS_DISTCONV
   friend class batch_normalization_distconv_adapter<TensorDataType, T_layout, Dev>;
  protected:
@@ -28,6 +28,7 @@
 #define LBANN_LAYER_REGULARIZER_DROPOUT_HPP_INCLUDED
 
 #include "lbann/layers/data_type_layer.hpp"
+#include "lbann/layers/regularizers/dropout_mask.hpp"
 #include "lbann/models/model.hpp"
 #ifdef LBANN_HAS_DNN_LIB
 #include "lbann/utils/dnn_lib/helpers.hpp"
@@ -41,7 +42,11 @@ namespace lbann {
  *
  *  The weights are multiplied by 1/(keep probability) at training
  *  time. Keep probabilities of 0.5 for fully-connected layers and 0.8
- *  for input layers are good starting points. See:
+ *  for input layers are good starting points.
+ *
+ *  On CPU, the mask is generated, scaled and applied in one pass and
+ *  kept as one bit per entry; see dropout_mask. With
+ *  @c recompute_mask, it is regenerated in backprop instead. See:
  *
  *  Nitish Srivastava, Geoffrey Hinton, Alex Krizhevsky, Ilya
  *  Sutskever, and Ruslan Salakhutdinov. "Dropout: a simple way to
@@ -61,19 +66,21 @@ public:
 
 public:
   /** Keep units with probabiliy keep_prob. */
-  dropout(EvalType keep_prob = EvalType(0.5))
+  dropout(EvalType keep_prob = EvalType(0.5), bool recompute_mask = false)
     : data_type_layer<TensorDataType>(nullptr),
       m_keep_prob(keep_prob)
 #ifdef LBANN_HAS_DNN_LIB
     , m_tensors_dnn_desc(this)
 #endif // LBANN_HAS_DNN_LIB
-  {}
+  {
+    m_mask.set_recompute(recompute_mask);
+  }
 
 
   dropout(const dropout& other)
     : data_type_layer<TensorDataType>(other),
       m_keep_prob(other.m_keep_prob),
-      m_mask(other.m_mask ? other.m_mask->Copy() : nullptr)
+      m_mask(other.m_mask)
 #ifdef LBANN_HAS_DNN_LIB
       ,
       m_tensors_dnn_desc(other.m_tensors_dnn_desc)
@@ -92,7 +99,7 @@ public:
   dropout& operator=(const dropout& other) {
     data_type_layer<TensorDataType>::operator=(other);
     m_keep_prob = other.m_keep_prob;
-    m_mask = other.m_mask ? std::unique_ptr<AbsDistMatrixType>(other.m_mask->Copy()) : nullptr;
+    m_mask = other.m_mask;
 #ifdef LBANN_HAS_DNN_LIB
     m_tensors_dnn_desc = other.m_tensors_dnn_desc;
     m_tensors_dnn_desc.set_layer(this);
@@ -115,8 +122,19 @@ public:
   description get_description() const override {
     auto desc = data_type_layer<TensorDataType>::get_description();
     desc.add("Keep probability", m_keep_prob);
+    if (m_mask.get_recompute()) {
+      desc.add("Recompute mask in backprop");
+    }
     return desc;
   }
+  size_t get_workspace_memory_usage(El::Int mini_batch_size) const override {
+    if (this->using_gpus() || m_mask.get_recompute()) { return 0; }
+    const auto& input = this->get_prev_activations();
+    return dropout_mask::get_stored_bytes(
+      El::MaxLength(this->get_input_size(), input.ColStride()),
+      El::MaxLength(mini_batch_size, input.RowStride()));
+  }
+
   /** @brief get prob for keep each unit. */
   EvalType get_keep_prob() const {
     return m_keep_prob;
@@ -141,11 +159,6 @@ protected:
     this->set_output_dims(this->get_input_dims());
   }
 
-  void setup_matrices(const El::Grid& grid) override {
-    data_type_layer<TensorDataType>::setup_matrices(grid);
-    m_mask = std::unique_ptr<AbsDistMatrixType>(this->get_activations().Copy());
-  }
-
   void setup_gpu() override {
     data_type_layer<TensorDataType>::setup_gpu();
 #ifndef LBANN_HAS_DNN_LIB
@@ -198,26 +211,15 @@ protected:
       return;
     }
 
-    // Construct mask matrix
+    // Generate mask and apply it to get activations
     const TensorDataType scale = static_cast<TensorDataType>(1 / m_keep_prob);
-    const auto& height = input.Height();
-    const auto& width = input.Width();
-    m_mask->Resize(height, width);
-#ifdef LBANN_DETERMINISTIC
-    bernoulli_fill_procdet(*m_mask, height, width, TensorDataType(m_keep_prob));
-    El::Scale(scale, *m_mask);
-#else
-    El::EntrywiseMap(*m_mask,
-                     (std::function<TensorDataType(const TensorDataType&)>)
-                     ([this,scale](const TensorDataType& z)->TensorDataType {
-                       auto& gen = get_fast_generator();
-                       std::bernoulli_distribution dist(m_keep_prob);
-                       return dist(gen) ? scale : El::TypeTraits<TensorDataType>::Zero();
-                     }));
-#endif // LBANN_DETERMINISTIC
-
-    // Apply mask matrix to get activations
-    El::Hadamard(input, *m_mask, output);
+    const TensorDataType zero = El::TypeTraits<TensorDataType>::Zero();
+    const auto& local_input = static_cast<const CPUMatDT<TensorDataType>&>(input.LockedMatrix());
+    auto& local_output = static_cast<CPUMatDT<TensorDataType>&>(output.Matrix());
+    m_mask.draw(this->get_name(), m_keep_prob);
+    m_mask.generate(input, [&](El::Int row, El::Int col, bool keep) {
+      local_output(row, col) = keep ? local_input(row, col) * scale : zero;
+    });
 
   }
 
@@ -229,7 +231,13 @@ protected:
     if (mode != execution_mode::training || m_keep_prob < EvalType(0)) {
       El::Copy(gradient_wrt_output, gradient_wrt_input);
     } else {
-      El::Hadamard(gradient_wrt_output, *m_mask, gradient_wrt_input);
+      const TensorDataType scale = static_cast<TensorDataType>(1 / m_keep_prob);
+      const TensorDataType zero = El::TypeTraits<TensorDataType>::Zero();
+      const auto& local_gradient_wrt_output = static_cast<const CPUMatDT<TensorDataType>&>(gradient_wrt_output.LockedMatrix());
+      auto& local_gradient_wrt_input = static_cast<CPUMatDT<TensorDataType>&>(gradient_wrt_input.Matrix());
+      m_mask.apply(gradient_wrt_output, [&](El::Int row, El::Int col, bool keep) {
+        local_gradient_wrt_input(row, col) = keep ? local_gradient_wrt_output(row, col) * scale : zero;
+      });
     }
   }
 
@@ -318,8 +326,8 @@ protected:
 
   /** Probability of keeping each unit. */
   EvalType m_keep_prob;
-  /** Current dropout mask (a scaled Bernoulli random matrix). */
-  std::unique_ptr<AbsDistMatrixType> m_mask;
+  /** Current dropout mask (CPU). */
+  dropout_mask m_mask;
 
 #ifdef LBANN_HAS_DNN_LIB
   /** Dropout DNN library descriptor. */
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef LBANN_LAYERS_REGULARIZERS_DROPOUT_MASK_HPP_INCLUDED
+#define LBANN_LAYERS_REGULARIZERS_DROPOUT_MASK_HPP_INCLUDED
+
+#include "lbann/base.hpp"
+#include "lbann/utils/hash.hpp"
+#include "lbann/utils/random_number_generators.hpp"
+
+#include <cereal/cereal.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lbann {
+
+/** @brief Bernoulli dropout mask for CPU layers
+ *
+ *  Entries are drawn with the counter-based generator, keyed by the
+ *  layer name and the number of masks drawn so far, with the global
+ *  index of the entry as the counter. The mask therefore does not
+ *  depend on the process or thread count, and can be rebuilt from
+ *  its key instead of being stored. If stored, it takes one bit per
+ *  local entry.
+ */
+class dropout_mask {
+public:
+
+  /** @brief Start a new mask
+   *
+   *  Must be called on every process that holds part of the tensor.
+   */
+  void draw(const std::string& layer_name, double keep_prob) {
+    m_key.seed = get_counter_rng_seed();
+    m_key.stream = hash_combine(std::hash<std::string>()(layer_name),
+                                m_num_draws++);
+    // Keep an entry if its 32 random bits are below keep_prob * 2^32
+    const double threshold = keep_prob * 4294967296.0;
+    m_threshold = (threshold <= 0. ? 0 :
+                   threshold >= 4294967296.0 ? uint64_t{1} << 32 :
+                   static_cast<uint64_t>(threshold));
+  }
+
+  /** @brief Rebuild the mask in backprop instead of storing it */
+  void set_recompute(bool recompute) { m_recompute = recompute; }
+  bool get_recompute() const { return m_recompute; }
+
+  /** @brief Call @c f(row, col, keep) for each local entry
+   *
+   *  Generates the mask drawn last, and stores it unless it is
+   *  recomputed.
+   */
+  template <typename TensorDataType, typename F>
+  void generate(const El::AbstractDistMatrix<TensorDataType>& mat, F f) {
+    const El::Int local_height = mat.LocalHeight();
+    const El::Int local_width = mat.LocalWidth();
+    m_words_per_col = (local_height + 31) / 32;
+    if (!m_recompute) {
+      m_bits.assign(m_words_per_col * local_width, 0);
+    }
+    else {
+      m_bits.clear();
+    }
+    visit(mat, [this,&f](El::Int row, El::Int col, bool keep) {
+      if (keep && !m_recompute) {
+        m_bits[col*m_words_per_col + row/32] |= uint32_t{1} << (row % 32);
+      }
+      f(row, col, keep);
+    });
+  }
+
+  /** @brief Call @c f(row, col, keep) with the mask from generate */
+  template <typename TensorDataType, typename F>
+  void apply(const El::AbstractDistMatrix<TensorDataType>& mat, F f) const {
+    if (m_recompute) {
+      visit(mat, f);
+      return;
+    }
+    const El::Int local_height = mat.LocalHeight();
+    const El::Int local_width = mat.LocalWidth();
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int col = 0; col < local_width; ++col) {
+      const uint32_t* bits = &m_bits[col*m_words_per_col];
+      for (El::Int row = 0; row < local_height; ++row) {
+        f(row, col, (bits[row/32] >> (row % 32)) & 1);
+      }
+    }
+  }
+
+  /** @brief Bytes held for the stored mask */
+  size_t get_stored_bytes() const { return m_bits.size() * sizeof(uint32_t); }
+
+  /** @brief Bytes needed to store the mask of a local matrix */
+  static size_t get_stored_bytes(El::Int local_height, El::Int local_width) {
+    return ((local_height + 31) / 32) * local_width * sizeof(uint32_t);
+  }
+
+  /** @brief Checkpoint the number of masks drawn
+   *
+   *  The draw count keys the next mask, so a restarted run draws the
+   *  same masks as an uninterrupted one.
+   */
+  template <typename ArchiveT>
+  void serialize(ArchiveT& ar) {
+    ar(CEREAL_NVP(m_num_draws));
+  }
+
+private:
+
+  /** Generate the mask for each local entry. Columns start on word
+   *  boundaries, so threads never share a word.
+   */
+  template <typename TensorDataType, typename F>
+  void visit(const El::AbstractDistMatrix<TensorDataType>& mat, F f) const {
+    const uint64_t height = mat.Height();
+    const El::Int local_height = mat.LocalHeight();
+    const El::Int local_width = mat.LocalWidth();
+    std::vector<uint64_t> global_rows(local_height);
+    for (El::Int row = 0; row < local_height; ++row) {
+      global_rows[row] = mat.GlobalRow(row);
+    }
+    const auto key = m_key;
+    const auto threshold = m_threshold;
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int col = 0; col < local_width; ++col) {
+      const uint64_t offset = height * mat.GlobalCol(col);
+      // Each block of random bits covers four consecutive entries
+      uint64_t block = ~uint64_t{0};
+      philox4x32::result_type r{};
+      for (El::Int row = 0; row < local_height; ++row) {
+        const uint64_t index = offset + global_rows[row];
+        if (index / 4 != block) {
+          block = index / 4;
+          r = key(block);
+        }
+        f(row, col, r[index % 4] < threshold);
+      }
+    }
+  }
+
+  counter_rng_key m_key{0, 0};
+  uint64_t m_threshold = 0;
+  uint64_t m_num_draws = 0;
+  bool m_recompute = false;
+  El::Int m_words_per_col = 0;
+  std::vector<uint32_t> m_bits;
+};
+
+} // namespace lbann
+
+#endif // LBANN_LAYERS_REGULARIZERS_DROPOUT_MASK_HPP_INCLUDED
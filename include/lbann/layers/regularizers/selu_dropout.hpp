@@ -28,6 +28,7 @@
 #define LBANN_LAYER_REGULARIZER_SELU_DROPOUT_HPP_INCLUDED
 
 #include "lbann/layers/data_type_layer.hpp"
+#include "lbann/layers/regularizers/dropout_mask.hpp"
 #include "lbann/models/model.hpp"
 
 namespace lbann {
@@ -46,9 +47,6 @@ public:
   /** @name Public Types */
   ///@{
 
-  /** @brief The tensor type expected in this object. */
-  using AbsDistMatrixType = El::AbstractDistMatrix<TensorDataType>;
-
   /** @brief The tensor type expected in this object. */
   using CPUMatrixType = El::Matrix<TensorDataType, El::Device::CPU>;
 
@@ -60,11 +58,7 @@ public:
                TensorDataType alpha = El::To<TensorDataType>(1.6732632423543772848170429916717),
                TensorDataType scale = El::To<TensorDataType>(1.0507009873554804934193349852946)) :
     data_type_layer<TensorDataType>(nullptr),
-    m_keep_prob(keep_prob),
-    m_mask(nullptr) {
-#ifdef LBANN_DETERMINISTIC
-    throw lbann_exception("selu_dropout: deterministic dropout not supported");
-#endif
+    m_keep_prob(keep_prob) {
     // Compute alpha' and the affine transform.
     m_alpha_prime = -scale*alpha;
     m_a = keep_prob +
@@ -79,9 +73,7 @@ public:
     m_a(other.m_a),
     m_b(other.m_b),
     m_keep_prob(other.m_keep_prob),
-    m_mask(other.m_mask) {
-    if (m_mask != nullptr) { m_mask = m_mask->Copy(); }
-  }
+    m_mask(other.m_mask) {}
 
   selu_dropout& operator=(const selu_dropout& other) {
     data_type_layer<TensorDataType>::operator=(other);
@@ -89,15 +81,11 @@ public:
     m_a = other.m_a;
     m_b = other.m_b;
     m_keep_prob = other.m_keep_prob;
-    if (m_mask != nullptr) { delete m_mask; }
     m_mask = other.m_mask;
-    if (m_mask != nullptr) { m_mask = m_mask->Copy(); }
     return *this;
   }
 
-  ~selu_dropout() override {
-    if (m_mask != nullptr) { delete m_mask; }
-  }
+  ~selu_dropout() override = default;
 
   selu_dropout* copy() const override { return new selu_dropout(*this); }
 
@@ -112,10 +100,15 @@ public:
     this->set_output_dims(this->get_input_dims());
   }
 
-  void setup_matrices(const El::Grid& grid) override {
-    data_type_layer<TensorDataType>::setup_matrices(grid);
-    if (m_mask != nullptr) { delete m_mask; }
-    m_mask = this->get_activations().Copy();
+  /** @brief Regenerate the mask in backprop instead of storing it */
+  void set_recompute_mask(bool recompute) { m_mask.set_recompute(recompute); }
+
+  size_t get_workspace_memory_usage(El::Int mini_batch_size) const override {
+    if (this->using_gpus() || m_mask.get_recompute()) { return 0; }
+    const auto& input = this->get_prev_activations();
+    return dropout_mask::get_stored_bytes(
+      El::MaxLength(this->get_input_size(), input.ColStride()),
+      El::MaxLength(mini_batch_size, input.RowStride()));
   }
 
   /** @name Serialization */
@@ -135,26 +128,18 @@ public:
       El::Copy(this->get_prev_activations(), this->get_activations());
     } else {
 
-      const auto *input_acts = &this->get_prev_activations();
-      const El::Int height = input_acts->Height();
-      const El::Int width = input_acts->Width();
-      const El::Int local_height = input_acts->LocalHeight();
-      const El::Int local_width = input_acts->LocalWidth();
-
-      const auto& local_input_acts = input_acts->LockedMatrix();
-      CPUMatrixType& local_output_acts = this->get_local_activations();
-      CPUMatrixType& local_mask = m_mask->Matrix();
-
-      // Construct and apply mask and the affine transform.
-      // TODO: Optimize.
-      El::Bernoulli(*m_mask, height, width, m_keep_prob);
-      for (El::Int col = 0; col < local_width; ++col) {
-        for (El::Int row = 0; row < local_height; ++row) {
-          local_output_acts(row, col) = m_a *
-            (local_input_acts(row, col)*local_mask(row, col) +
-             m_alpha_prime*(El::TypeTraits<TensorDataType>::One() - local_mask(row, col))) + m_b;
-        }
-      }
+      const auto& input_acts = this->get_prev_activations();
+      const auto& local_input_acts = static_cast<const CPUMatrixType&>(input_acts.LockedMatrix());
+      auto& local_output_acts = static_cast<CPUMatrixType&>(this->get_local_activations());
+
+      // Generate and apply mask and the affine transform in one pass
+      const TensorDataType a = m_a;
+      const TensorDataType b = m_b;
+      const TensorDataType dropped = m_a * m_alpha_prime + m_b;
+      m_mask.draw(this->get_name(), static_cast<double>(m_keep_prob));
+      m_mask.generate(input_acts, [&](El::Int row, El::Int col, bool keep) {
+        local_output_acts(row, col) = keep ? a * local_input_acts(row, col) + b : dropped;
+      });
 
     }
   }
@@ -166,18 +151,14 @@ public:
       El::Copy(this->get_prev_error_signals(), this->get_error_signals());
     } else {
 
-      const auto& local_prev_error_signal = this->get_local_prev_error_signals();
-      CPUMatrixType& local_error_signal = this->get_local_error_signals();
-      CPUMatrixType& local_mask = m_mask->Matrix();
-      const El::Int local_height = local_prev_error_signal.Height();
-      const El::Int local_width = local_prev_error_signal.Width();
+      const auto& local_prev_error_signal = static_cast<const CPUMatrixType&>(this->get_local_prev_error_signals());
+      auto& local_error_signal = static_cast<CPUMatrixType&>(this->get_local_error_signals());
       // Reweight with the affine scale factor and the dropout mask.
-      for (El::Int col = 0; col < local_width; ++col) {
-        for (El::Int row = 0; row < local_height; ++row) {
-          local_error_signal(row, col) =
-            m_a * local_prev_error_signal(row, col) * local_mask(row, col);
-        }
-      }
+      const TensorDataType a = m_a;
+      const TensorDataType zero = El::TypeTraits<TensorDataType>::Zero();
+      m_mask.apply(this->get_prev_error_signals(), [&](El::Int row, El::Int col, bool keep) {
+        local_error_signal(row, col) = keep ? a * local_prev_error_signal(row, col) : zero;
+      });
 
     }
   }
@@ -191,8 +172,8 @@ public:
   TensorDataType m_b;
   /** Probability of keeping each unit. */
   TensorDataType m_keep_prob;
-  /** Current dropout mask (a scaled Bernoulli random matrix). */
-  AbsDistMatrixType *m_mask;
+  /** Current dropout mask. */
+  dropout_mask m_mask;
 };
 
 #ifndef LBANN_SELU_DROPOUT_LAYER_INSTANTIATE
@@ -28,8 +28,10 @@
 #define LBANN_LAYERS_TRANSFORM_CONCATENATE_HPP_INCLUDED
 
 #include "lbann/layers/data_type_layer.hpp"
+#include "lbann/utils/argument_parser.hpp"
 #include "lbann/utils/exception.hpp"
 #include "lbann/utils/distconv.hpp"
+#include "lbann/utils/options.hpp"
 
 #include <lbann/proto/proto_common.hpp>
 #include <layers.pb.h>
@@ -55,6 +57,17 @@ class concatenate_distconv_adapter : public data_type_distconv_adapter<TensorDat
  *
  *  All input tensors must have identical dimensions, except for the
  *  concatenation dimension.
+ *
+ *  With the data-parallel layout, each input tensor occupies a
+ *  contiguous block of rows in the output matrix if all dimensions
+ *  before the concatenation dimension are 1. In that case the parent
+ *  layers are asked to write their outputs directly into views of
+ *  the output matrix, so the forward pass does not copy any data
+ *  (see Layer::set_output_alias). Parents that cannot do so are
+ *  handled by copying, as are all other cases. The output matrix is
+ *  then a view into a buffer that is allocated for the max
+ *  mini-batch size during setup and never resized, so parents that
+ *  run concurrently never reallocate each other's views.
  */
 template <typename TensorDataType,
           data_layout Layout = data_layout::DATA_PARALLEL,
@@ -63,8 +76,8 @@ class concatenate_layer : public data_type_layer<TensorDataType> {
 public:
 
   concatenate_layer(lbann_comm *comm, size_t concat_dim);
-  concatenate_layer(const concatenate_layer& other) = default;
-  concatenate_layer& operator=(const concatenate_layer& other) = default;
+  concatenate_layer(const concatenate_layer& other);
+  concatenate_layer& operator=(const concatenate_layer& other);
 
   concatenate_layer* copy() const override;
 
@@ -92,6 +105,7 @@ protected:
 
   void setup_pointers() override;
   void setup_dims(DataReaderMetaData& dr_metadata) override;
+  void setup_data(size_t max_mini_batch_size) override;
 
   void fp_setup_outputs(El::Int mini_batch_size) override;
   void bp_setup_gradient_wrt_inputs(El::Int mini_batch_size) override;
@@ -103,6 +117,25 @@ private:
   /** @brief Tensor dimension to concatenate along. */
   size_t m_concat_dim;
 
+  /** @brief Whether parent layers write into the output tensor.
+   *
+   *  Set during setup if the input tensors are row blocks of the
+   *  output matrix.
+   */
+  bool m_alias_inputs = false;
+
+  /** @brief Buffer that parent layers write into.
+   *
+   *  Sized for the max mini-batch size. The output tensor views its
+   *  leading columns.
+   */
+  std::unique_ptr<El::AbstractDistMatrix<TensorDataType>> m_alias_buffer;
+
+  /** @brief Whether every input tensor is a view into the
+   *         corresponding rows of the output tensor.
+   */
+  bool inputs_are_aliased() const;
+
 #ifdef LBANN_HAS_GPU
   /** @brief Workspace buffer.
    *
@@ -159,6 +192,39 @@ concatenate_layer<TensorDataType,Layout,Device>::concatenate_layer(
   this->m_expected_num_parent_layers = -1; // No limit on parents
 }
 
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+concatenate_layer<TensorDataType,Layout,Device>::concatenate_layer(
+  const concatenate_layer& other)
+  : data_type_layer<TensorDataType>(other),
+    syncSubGridCommunication(other.syncSubGridCommunication),
+    m_concat_dim(other.m_concat_dim),
+    m_alias_inputs(other.m_alias_inputs),
+    m_alias_buffer(other.m_alias_buffer
+                   ? other.m_alias_buffer->Copy()
+                   : nullptr)
+#ifdef LBANN_HAS_GPU
+  , m_workspace(other.m_workspace),
+    m_workspace_event(other.m_workspace_event)
+#endif // LBANN_HAS_GPU
+{}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+auto concatenate_layer<TensorDataType,Layout,Device>::operator=(
+  const concatenate_layer& other) -> concatenate_layer& {
+  data_type_layer<TensorDataType>::operator=(other);
+  syncSubGridCommunication = other.syncSubGridCommunication;
+  m_concat_dim = other.m_concat_dim;
+  m_alias_inputs = other.m_alias_inputs;
+  m_alias_buffer.reset(other.m_alias_buffer
+                       ? other.m_alias_buffer->Copy()
+                       : nullptr);
+#ifdef LBANN_HAS_GPU
+  m_workspace = other.m_workspace;
+  m_workspace_event = other.m_workspace_event;
+#endif // LBANN_HAS_GPU
+  return *this;
+}
+
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 concatenate_layer<TensorDataType, Layout,Device>* concatenate_layer<TensorDataType,Layout,Device>::copy() const {
   return new concatenate_layer(*this);
@@ -258,6 +324,68 @@ void concatenate_layer<TensorDataType,Layout,Device>::setup_dims(DataReaderMetaD
 
 }
 
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void concatenate_layer<TensorDataType,Layout,Device>::setup_data(size_t max_mini_batch_size) {
+  data_type_layer<TensorDataType>::setup_data(max_mini_batch_size);
+
+  // Input tensors are row blocks of the output matrix if the
+  // dimensions before the concatenation dimension are all 1
+  const auto& output_dims = this->get_output_dims();
+  const auto& parents = this->get_parent_layers();
+  m_alias_inputs = (Layout == data_layout::DATA_PARALLEL
+                    && this->get_num_parents() > 1
+                    && !this->is_subgraph_parallelism_enabled()
+                    && !this->get_parallel_strategy().enable_subgraph
+                    && std::accumulate(output_dims.begin(),
+                                       output_dims.begin() + m_concat_dim,
+                                       1, std::multiplies<int>()) == 1
+                    && !global_argument_parser().get<bool>(
+                         LBANN_OPTION_NO_TENSOR_ALIASING));
+#ifdef LBANN_HAS_DISTCONV
+  m_alias_inputs = m_alias_inputs && !this->distconv_enabled();
+#endif // LBANN_HAS_DISTCONV
+  for (size_t j=0; j<parents.size(); ++j) {
+    if (std::count(parents.begin(), parents.end(), parents[j]) > 1) {
+      m_alias_inputs = false;
+    }
+  }
+
+  // Allocate the buffer once, so parent layers never resize it
+  m_alias_buffer.reset();
+  if (m_alias_inputs) {
+    const auto& output = this->get_activations();
+    m_alias_buffer.reset(output.Construct(output.Grid(), output.Root()));
+    m_alias_buffer->AlignWith(output.DistData());
+    m_alias_buffer->Resize(this->get_output_size(), max_mini_batch_size);
+  }
+
+  // Ask parent layers to write into the buffer
+  El::Int offset = 0;
+  for (size_t j=0; j<parents.size(); ++j) {
+    auto& parent = const_cast<Layer&>(*parents[j]);
+    parent.set_output_alias(*this, m_alias_buffer.get(), offset);
+    offset += this->get_input_size(j);
+  }
+
+}
+
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+bool concatenate_layer<TensorDataType,Layout,Device>::inputs_are_aliased() const {
+  if (!m_alias_inputs) { return false; }
+  const auto& output = this->get_activations();
+  if (output.LocalHeight() < 1 || output.LocalWidth() < 1) { return true; }
+  El::Int offset = 0;
+  for (int j=0; j<this->get_num_parents(); ++j) {
+    const auto& input = this->get_prev_activations(j);
+    if (input.LockedBuffer() != output.LockedBuffer(offset, 0)
+        || input.LDim() != output.LDim()) {
+      return false;
+    }
+    offset += input.LocalHeight();
+  }
+  return true;
+}
+
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 void concatenate_layer<TensorDataType,Layout,Device>::fp_setup_outputs(El::Int mini_batch_size) {
 #ifdef LBANN_HAS_DISTCONV
@@ -265,6 +393,16 @@ void concatenate_layer<TensorDataType,Layout,Device>::fp_setup_outputs(El::Int m
 #endif // LBANN_HAS_DISTCONV
   const auto& input0 = this->get_prev_activations(0);
   auto& output = this->get_activations();
+
+  // View the buffer that parent layers have written into
+  // Note: The buffer is not resized, since parents' output tensors
+  // may still view it.
+  if (m_alias_buffer != nullptr
+      && m_alias_buffer->Width() >= input0.Width()) {
+    El::View(output, *m_alias_buffer, El::ALL, El::IR(0, input0.Width()));
+    return;
+  }
+
   output.Empty(false);
   if (this->get_num_parents() == 1) {
     El::LockedView(output, input0);
@@ -336,6 +474,11 @@ void concatenate_layer<TensorDataType,Layout,Device>::fp_compute() {
     return;
   }
 
+  // Nothing to do if parent layers wrote into the output tensor
+  if (inputs_are_aliased()) {
+    return;
+  }
+
   // Perform concatenation
   if(m_concat_dim==num_dims-1 && this->is_subgraph_parallelism_enabled() && this->get_parallel_strategy().enable_subgraph==true)
   {
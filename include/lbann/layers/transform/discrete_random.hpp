@@ -74,6 +74,7 @@ class discrete_random_layer : public data_type_layer<TensorDataType> {
   std::string get_type() const override { return "discrete random"; }
   data_layout get_data_layout() const override { return T_layout; }
   El::Device get_device_allocation() const override { return Dev; }
+  bool uses_random_number_generators() const override { return true; }
 
  protected:
 
@@ -74,6 +74,7 @@ public:
   std::string get_type() const override { return "Gaussian"; }
   data_layout get_data_layout() const override { return T_layout; }
   El::Device get_device_allocation() const override { return Dev; }
+  bool uses_random_number_generators() const override { return true; }
 
   description get_description() const override {
     auto desc = data_type_layer<TensorDataType>::get_description();
@@ -28,7 +28,9 @@
 #define LBANN_LAYERS_TRANSFORM_SLICE_HPP_INCLUDED
 
 #include "lbann/layers/data_type_layer.hpp"
+#include "lbann/utils/argument_parser.hpp"
 #include "lbann/utils/exception.hpp"
+#include "lbann/utils/options.hpp"
 #include "lbann/data_readers/data_reader_jag_conduit.hpp"
 #include "lbann/models/model.hpp"
 #include "lbann/trainers/trainer.hpp"
@@ -39,6 +41,11 @@ namespace lbann {
  *
  *  The tensor is split along one dimension at user-specified points,
  *  and each child layer recieves one piece.
+ *
+ *  With the data-parallel layout, each piece is a contiguous block of
+ *  rows in the input matrix if all dimensions before the slice
+ *  dimension are 1. In that case the output tensors are views into
+ *  the input tensor and the forward pass does not copy any data.
  */
 template <typename TensorDataType,
           data_layout Layout = data_layout::DATA_PARALLEL,
@@ -90,6 +97,7 @@ protected:
   {}
 
   void setup_dims(DataReaderMetaData& dr_metadata) override;
+  void setup_data(size_t max_mini_batch_size) override;
 
   void fp_setup_outputs(El::Int mini_batch_size) override;
   void bp_setup_gradient_wrt_inputs(El::Int mini_batch_size) override;
@@ -108,6 +116,11 @@ private:
   bool m_set_slice_points_from_data_reader;
   /** Category for retrieving slice points from data reader */
   slice_points_mode m_var_category;
+  /** Whether output tensors are views into the input tensor.
+   *  Set during setup if the output tensors are row blocks of the
+   *  input matrix.
+   */
+  bool m_alias_outputs = false;
 
 #ifdef LBANN_HAS_GPU
   /** @brief Workspace buffer.
@@ -270,6 +283,22 @@ void fp_setup_outputs_impl(
 
   const size_t num_outputs = l.get_num_children();
   const auto& input = l.get_prev_activations();
+
+  // View row blocks of input matrix
+  if (l.m_alias_outputs) {
+    const auto& input_dims = l.get_input_dims();
+    const El::Int stride = std::accumulate(
+      input_dims.begin() + l.m_slice_dim + 1, input_dims.end(),
+      1, std::multiplies<int>());
+    for (size_t j=0; j<num_outputs; ++j) {
+      auto& output = l.get_activations(j);
+      const El::Int offset = l.m_slice_points[j] * stride;
+      El::LockedView(output, input,
+                     El::IR(offset, offset + l.get_output_size(j)), El::ALL);
+    }
+    return;
+  }
+
   for (size_t j=0; j<num_outputs; ++j) {
     auto& output = l.get_activations(j);
     //output.AlignWith(input);
@@ -278,6 +307,24 @@ void fp_setup_outputs_impl(
 
 }
 
+template <typename TensorDataType, data_layout Layout, El::Device Device>
+void slice_layer<TensorDataType,Layout,Device>::setup_data(size_t max_mini_batch_size) {
+
+  // Output tensors are row blocks of the input matrix if the
+  // dimensions before the slice dimension are all 1
+  const auto& input_dims = this->get_input_dims();
+  m_alias_outputs = (Layout == data_layout::DATA_PARALLEL
+                     && !this->is_subgraph_parallelism_enabled()
+                     && !this->get_parallel_strategy().enable_subgraph
+                     && std::accumulate(input_dims.begin(),
+                                        input_dims.begin() + m_slice_dim,
+                                        1, std::multiplies<int>()) == 1
+                     && !global_argument_parser().get<bool>(
+                          LBANN_OPTION_NO_TENSOR_ALIASING));
+
+  data_type_layer<TensorDataType>::setup_data(max_mini_batch_size);
+}
+
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 void slice_layer<TensorDataType,Layout,Device>::fp_setup_outputs(El::Int mini_batch_size) {
   fp_setup_outputs_impl(*this);
@@ -330,6 +377,11 @@ void slice_layer<TensorDataType,Layout,Device>::fp_compute() {
   const auto& input_dims = this->get_input_dims();
   const size_t num_dims = input_dims.size();
 
+  // Nothing to do if output tensors are views into the input tensor
+  if (m_alias_outputs) {
+    return;
+  }
+
   if(this->m_slice_dim==num_dims-1 && this->get_parallel_strategy().enable_subgraph==true)
   {
     fp_compute_subgrid();
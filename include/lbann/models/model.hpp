@@ -50,9 +50,13 @@
 // `IncompleteType*`, which is annoying.
 #include <optimizers.pb.h>
 
+#include <functional>
+#include <mutex>
+#include <set>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 // Forward-declare protobuf class
 namespace lbann_data {
@@ -66,6 +70,20 @@ class lbann_callback;
 class TrainingAlgorithm;
 class callback_base;
 
+/** @brief How layers reduce statistics in forward prop
+ *  @details See Layer::can_split_forward_prop.
+ */
+enum class statistics_reduction_mode {
+  /** Each layer runs a blocking allreduce. */
+  blocking,
+  /** Each layer starts a non-blocking allreduce, which completes
+   *  before the first child of the layer runs. */
+  overlap,
+  /** Reductions of consecutive layers are packed into one allreduce,
+   *  which runs before the first child of any of them. */
+  batch
+};
+
 /** @brief Abstract base class for neural network models. */
 class model {
 public:
@@ -131,6 +149,57 @@ public:
     enable_subgraph_topology = type;
   }
 
+  /** @brief Set the number of layers that may run concurrently.
+   *  @details If larger than one, layers that do not depend on each
+   *  other (e.g. separate branches of the layer graph) are run
+   *  concurrently on a thread pool, and the OpenMP threads of the
+   *  process are split among them. Only supported for CPU models on
+   *  single-process trainers. Takes effect at setup.
+   */
+  void set_layer_parallel_threads(size_t num_threads)
+  {
+    m_layer_parallel_threads = num_threads;
+  }
+
+  size_t get_layer_parallel_threads() const noexcept
+  {
+    return m_layer_parallel_threads;
+  }
+
+  /** @brief Choose layers whose outputs are recomputed in backprop.
+   *  @details The outputs of a chosen layer are discarded once all of
+   *  its children have run forward prop during training and are
+   *  recomputed from its inputs before its first child runs backprop.
+   *  Only layers with a cheap, deterministic forward prop can be
+   *  chosen (see Layer::can_recompute_outputs).
+   *  @param layer_names Names of layers to recompute.
+   *  @param layer_types Types of layers to recompute (e.g. "relu",
+   *                     "operator"). Layers that cannot recompute
+   *                     their outputs are skipped.
+   *  @param interval    If nonzero, recompute every layer that can
+   *                     recompute its outputs, except for every
+   *                     interval-th such layer in execution order,
+   *                     which is kept as a checkpoint.
+   *  Takes effect at setup.
+   */
+  void set_activation_recomputation(std::set<std::string> layer_names,
+                                    std::set<std::string> layer_types,
+                                    size_t interval)
+  {
+    m_recompute_layer_names = std::move(layer_names);
+    m_recompute_layer_types = std::move(layer_types);
+    m_recompute_interval = interval;
+  }
+
+  /** @brief Choose how layers reduce statistics in forward prop.
+   *  @details Only applies to training on CPU with layers run one at
+   *  a time. Takes effect at setup.
+   */
+  void set_statistics_reduction(statistics_reduction_mode mode)
+  {
+    m_statistics_reduction = mode;
+  }
+
   bool get_subgrid_topology()
   {
     return enable_subgraph_topology;
@@ -314,6 +383,20 @@ public:
     DataReaderMetaData& dr_metadata,
     bool force=false);
 
+  /** @brief Setup model for inference only.
+   *
+   *  Optimizers are released and all layers and weights are frozen
+   *  before the usual setup, so no gradient buffers or optimizer
+   *  state (e.g. Adam moments) are allocated. The model can no
+   *  longer be trained afterwards.
+   *
+   *  @return Estimated local memory that the optimizers would have
+   *          allocated, in bytes.
+   */
+  virtual size_t setup_inference(
+    size_t max_mini_batch_size,
+    DataReaderMetaData& dr_metadata);
+
   virtual void make_data_store_preloaded(execution_mode mode);
 
   virtual void mark_data_store_explicitly_loading(execution_mode mode);
@@ -442,6 +525,25 @@ protected:
    */
   virtual void setup_weights();
 
+  /** @brief Set up layer-parallel execution.
+   *  @details Called in setup function. Groups layers into waves of
+   *  layers that do not depend on each other.
+   */
+  virtual void setup_layer_parallel_execution();
+
+  /** @brief Set up activation recomputation.
+   *  @details Called in setup function. Chooses the layers whose
+   *  outputs are recomputed and reports the memory saved.
+   */
+  virtual void setup_activation_recomputation(size_t max_mini_batch_size);
+
+  /** @brief Set up split forward prop.
+   *  @details Called in setup function, after activation
+   *  recomputation. Finds the layer before which each split layer
+   *  must finish forward prop.
+   */
+  virtual void setup_statistics_reduction();
+
 public:
   // ===========================================
   // Execution
@@ -452,8 +554,13 @@ public:
   /** @brief Reset model statistics for an epoch. */
   virtual void reset_epoch_statistics(execution_mode mode);
 
-  /** @brief Forward propagation step. */
-  virtual void forward_prop(execution_mode mode);
+  /** @brief Forward propagation step.
+   *  @param mode Execution mode.
+   *  @param run_callbacks Whether to dispatch the model and layer
+   *         forward prop callbacks. Inference engines that handle
+   *         their own outputs disable them.
+   */
+  virtual void forward_prop(execution_mode mode, bool run_callbacks=true);
   /** @brief Backward propagation step. */
   virtual void backward_prop();
   /** Evaluate any metrics in the model */
@@ -462,11 +569,31 @@ public:
   /** @brief Clear each optimizer's gradient.
    *
    *  This must be called before training forward prop since layers
-   *  set an optimizer flag during forward prop.
+   *  set an optimizer flag during forward prop. The gradient scales
+   *  are reset for a single micro-batch.
    */
   virtual void clear_gradients();
-  /** @brief Update weights step. */
-  virtual void update_weights();
+  /** @brief Set each optimizer's gradient scale.
+   *
+   *  The scale undoes loss scaling and averages the gradients over
+   *  @c num_micro_batches micro-batches. It must be set before the
+   *  gradients are read, e.g. by callbacks at the end of backprop.
+   */
+  void set_gradient_scales(size_t num_micro_batches);
+  /** @brief Defer each optimizer's gradient allreduce.
+   *
+   *  While deferred, gradient contributions from successive backprops
+   *  accumulate locally, e.g. over micro-batches, and are reduced
+   *  once per optimization step.
+   */
+  void defer_gradient_allreduces(bool defer);
+  /** @brief Update weights step.
+   *
+   *  @param num_micro_batches Number of micro-batches whose
+   *  gradients have been accumulated. The gradients are averaged
+   *  over them (see set_gradient_scales).
+   */
+  virtual void update_weights(size_t num_micro_batches = 1);
   /** @brief Update layers step. */
   virtual bool update_layers();
   /** @brief Reconcile weight values.
@@ -597,6 +724,101 @@ private:
    */
   bool m_model_is_setup = false;
 
+  /** @brief Max number of layers that run concurrently
+   *  @details Layers are run one at a time if this is 0 or 1.
+   */
+  size_t m_layer_parallel_threads = 0;
+
+  /** @brief Layer indices grouped into waves
+   *  @details Layers in a wave do not depend on each other and every
+   *  layer depends only on layers in earlier waves. Empty if layers
+   *  are run one at a time.
+   */
+  std::vector<std::vector<El::Int>> m_layer_waves;
+
+  /** @brief OpenMP threads given to each layer of a wave */
+  std::vector<int> m_layer_wave_omp_threads;
+
+  /** @brief Worker threads for layer-parallel execution */
+  std::unique_ptr<thread_pool> m_layer_thread_pool;
+
+  /** @brief Serializes layer callbacks from concurrent layers */
+  std::mutex m_layer_callback_mutex;
+
+  /** @brief Apply a function to each layer in a wave
+   *  @details Layers are run concurrently, except for those that
+   *  run on the calling thread.
+   */
+  void run_layer_wave(size_t wave, std::function<void(Layer&)> const& f);
+  /** @brief Whether a layer of a wave runs on the calling thread
+   *  @details Input layers share the data coordinator and random
+   *  layers share the random number generators, which are seeded
+   *  for the calling thread's OpenMP threads only.
+   */
+  static bool runs_on_calling_thread(const Layer& l);
+
+  /** @brief Names of layers whose outputs are recomputed */
+  std::set<std::string> m_recompute_layer_names;
+  /** @brief Types of layers whose outputs are recomputed */
+  std::set<std::string> m_recompute_layer_types;
+  /** @brief Recompute all eligible layers except every k-th layer
+   *  @details Disabled if 0.
+   */
+  size_t m_recompute_interval = 0;
+
+  /** @brief Layers whose outputs are discarded after forward prop
+   *  @details Indexed by execution order, or by wave with
+   *  layer-parallel execution. Entry i lists the layers whose last
+   *  child is layer (or in wave) i.
+   */
+  std::vector<std::vector<Layer*>> m_recompute_discard_after;
+
+  /** @brief Layers whose outputs are currently discarded */
+  std::unordered_set<const Layer*> m_discarded_layers;
+
+  /** @brief Discard outputs of layers whose children have all run
+   *         forward prop
+   *  @param index Layer index in execution order, or wave index with
+   *               layer-parallel execution.
+   */
+  void discard_recomputed_outputs(size_t index);
+
+  /** @brief Recompute discarded outputs needed by a layer's backprop
+   *  @details Recomputes the discarded parents of the layer, and
+   *  their discarded parents first.
+   */
+  void recompute_parent_outputs(Layer& l);
+
+  /** @brief How layers reduce statistics in forward prop */
+  statistics_reduction_mode m_statistics_reduction
+    = statistics_reduction_mode::blocking;
+
+  /** @brief Layers that must finish forward prop before a layer runs
+   *  @details Indexed by execution order. Entry i lists the split
+   *  layers whose first child is layer i.
+   */
+  std::vector<std::vector<Layer*>> m_split_finish_before;
+
+  /** @brief Split layers waiting to finish forward prop */
+  std::unordered_set<Layer*> m_split_pending_layers;
+
+  /** @brief Split layers whose reduction has not been started */
+  std::vector<Layer*> m_split_unreduced_layers;
+
+  /** @brief Finish forward prop of split layers due before a layer
+   *  @param index Layer index in execution order.
+   */
+  void finish_split_forward_props(size_t index,
+                                  execution_mode mode,
+                                  bool run_callbacks);
+
+  /** @brief Sum the pending reductions of split layers
+   *  @details Reductions of type DataType on CPU with the same
+   *  communicator are packed into one allreduce. The others are
+   *  started separately.
+   */
+  void reduce_split_layers();
+
   // ===========================================
   // Functions to add utility layers
   // ===========================================
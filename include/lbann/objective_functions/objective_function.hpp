@@ -83,6 +83,36 @@ class objective_function {
    */
   void compute_weight_regularization();
 
+  /** Configure loss scaling.
+   *  The objective function gradient is multiplied by the loss scale
+   *  so that small gradients remain representable in reduced
+   *  precision layers. Optimizers undo the scaling in the precision
+   *  of the master weights. With dynamic loss scaling, the scale is
+   *  reduced by the backoff factor whenever the gradient overflows
+   *  (and the optimization step is skipped) and increased by the
+   *  growth factor after a number of consecutive finite steps.
+   */
+  void set_loss_scaling(EvalType initial_scale,
+                        bool dynamic,
+                        EvalType growth_factor = EvalType(2),
+                        EvalType backoff_factor = EvalType(0.5),
+                        El::Int growth_interval = 2000);
+  /** Get the current loss scale. */
+  EvalType get_loss_scale() const noexcept { return m_loss_scale; }
+  /** Whether the loss scale is adjusted during training. */
+  bool is_loss_scaling_dynamic() const noexcept {
+    return m_dynamic_loss_scaling;
+  }
+  /** Adjust the dynamic loss scale after an optimization step.
+   *  @param gradient_is_finite Whether all weight gradients were
+   *                            finite, i.e. the step was applied.
+   */
+  void update_loss_scale(bool gradient_is_finite);
+  /** Number of optimization steps skipped due to gradient overflow. */
+  El::Int get_num_skipped_steps() const noexcept {
+    return m_num_skipped_steps;
+  }
+
   /** Clear all statistics. */
   void reset_statistics() {
     for (auto& stats : m_statistics) {
@@ -132,6 +162,22 @@ class objective_function {
   /** Time spent computing the objective function gradient. */
   EvalType m_differentiation_time = EvalType(0);
 
+  /** Factor applied to the objective function gradient. */
+  EvalType m_loss_scale = EvalType(1);
+  /** Whether the loss scale is adjusted during training. */
+  bool m_dynamic_loss_scaling = false;
+  /** Factor applied to the loss scale after m_loss_scale_growth_interval
+   *  consecutive finite steps. */
+  EvalType m_loss_scale_growth_factor = EvalType(2);
+  /** Factor applied to the loss scale after a gradient overflow. */
+  EvalType m_loss_scale_backoff_factor = EvalType(0.5);
+  /** Number of consecutive finite steps before growing the loss scale. */
+  El::Int m_loss_scale_growth_interval = 2000;
+  /** Consecutive finite steps since the loss scale last changed. */
+  El::Int m_num_finite_steps = 0;
+  /** Optimization steps skipped due to gradient overflow. */
+  El::Int m_num_skipped_steps = 0;
+
 };
 
 } // namespace lbann
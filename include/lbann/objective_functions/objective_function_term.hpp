@@ -87,10 +87,20 @@ class objective_function_term {
   /** Set list of pointers to weights. */
   void set_weights_pointers(std::vector<ViewingWeightsPtr> w);
 
+  /** Set loss scaling factor.
+   *  Gradients computed by differentiate and
+   *  compute_weight_regularization are multiplied by this factor in
+   *  addition to the term's scaling factor. The objective function
+   *  value is not affected.
+   */
+  void set_loss_scale(EvalType loss_scale) { m_loss_scale = loss_scale; }
+
  protected:
 
   /** Scaling factor for objective function term. */
   EvalType m_scale_factor;
+  /** Loss scaling factor applied to gradients. */
+  EvalType m_loss_scale = EvalType(1);
 
   /** Layers used to compute objective function term. */
   std::vector<ViewingLayerPtr> m_layers;
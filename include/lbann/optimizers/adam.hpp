@@ -141,6 +141,11 @@ public:
   using OptimizerType::setup;
   void setup(WeightsType* w = nullptr) override;
 
+  size_t get_state_memory_usage() const override;
+  size_t get_num_state_buffers() const override {
+    return OptimizerType::get_num_state_buffers() + 2;
+  }
+
   ///@}
 
 protected:
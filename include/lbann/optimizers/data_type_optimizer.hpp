@@ -79,6 +79,9 @@ public:
   void setup(weights* w) override;
   virtual void setup(data_type_weights<TensorDataType>* w = nullptr);
   void setup_base(data_type_weights<TensorDataType>* w);
+
+  size_t get_state_memory_usage() const override;
+  size_t get_num_state_buffers() const override { return 1; }
   /** @name Weights management */
   ///@{
 
@@ -95,7 +98,13 @@ public:
 
   /** @brief Objective function gradient w.r.t. the weights.
    *
-   *  An allreduce may be launched and/or synchronized if needed.
+   *  An allreduce may be launched and/or synchronized if needed. The
+   *  gradient scale has been applied, so loss scaling is undone and
+   *  micro-batch contributions are averaged. It is an error to call
+   *  this while the gradient allreduce is deferred, since the
+   *  gradient is incomplete until the last micro-batch of the step.
+   *  It is also an error if optimizer state is sharded, since each
+   *  process only reduces its own shard of the gradient.
    */
   AbsDistMatrixType& get_gradient();
 
@@ -128,12 +137,42 @@ protected:
   virtual void step_compute(AbsDistMatrixType& values,
                             const AbsDistMatrixType& gradient) = 0;
 
+  /** @brief Whether the optimizer can update a shard of the weights.
+   *
+   *  Sharding requires that @c step_compute is entrywise, i.e. each
+   *  entry of the weights only depends on matching entries of the
+   *  gradient and optimizer state.
+   */
+  virtual bool supports_state_sharding() const { return true; }
+
+  /** @brief Gradient buffer, for the shape of optimizer state.
+   *
+   *  Optimizer state has the same shape and distribution as the
+   *  gradient buffer, which only holds the local shard if state is
+   *  sharded. The buffer is not reduced or scaled.
+   */
+  const AbsDistMatrixType& get_state_layout() const;
+
   /** @brief Get the info needed to construct a new gradient matrix.
    *  @return Tuple of height, width, and DistData.
    */
   std::tuple<El::Int, El::Int, El::DistData> get_matrix_info() const final;
 
+  /** @brief Local memory held by an optimizer matrix, in bytes. */
+  static size_t get_memory_usage(const AbsDistMatrixType* m) {
+    return (m == nullptr ? 0
+            : m->LocalHeight() * m->LocalWidth() * sizeof(TensorDataType));
+  }
+
 private:
+  /** @brief Optimization step on the local shard of the weights.
+   *
+   *  The gradient is reduce-scattered over the redundant
+   *  communicator, @c step_compute is applied to the local shard,
+   *  and the updated weights are allgathered.
+   */
+  void step_sharded();
+
   /** @brief Weights being optimized. */
   data_type_weights<TensorDataType>* m_weights = nullptr;
 
@@ -154,6 +193,12 @@ private:
    */
   Al::request m_gradient_allreduce_req;
 
+  /** @brief Number of weight entries updated by each process.
+   *
+   *  Zero if optimizer state is not sharded.
+   */
+  El::Int m_shard_size = 0;
+
   /** @brief Scaling factor for optimization step sizes.
    *
    *  This is not used by the base optimizer class, but is currently
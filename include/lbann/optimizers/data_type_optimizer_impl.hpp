@@ -33,6 +33,8 @@
 
 #include "lbann/optimizers/data_type_optimizer.hpp"
 
+#include <algorithm>
+
 namespace lbann {
 
 template <typename TensorDataType>
@@ -48,6 +50,7 @@ data_type_optimizer<TensorDataType>::data_type_optimizer(
     m_weights(other.m_weights),
     m_gradient(other.m_gradient ? other.m_gradient->Copy() : nullptr),
     m_gradient_v(other.m_gradient_v ? other.m_gradient_v->Copy() : nullptr),
+    m_shard_size(other.m_shard_size),
     m_learning_rate(other.m_learning_rate)
 {}
 
@@ -60,6 +63,7 @@ data_type_optimizer<TensorDataType>::operator=(
   m_weights = other.m_weights;
   m_gradient.reset(other.m_gradient ? other.m_gradient->Copy() : nullptr);
   m_gradient_v.reset(other.m_gradient_v ? other.m_gradient_v->Copy() : nullptr);
+  m_shard_size = other.m_shard_size;
   m_learning_rate = other.m_learning_rate;
   return *this;
 }
@@ -100,6 +104,20 @@ auto data_type_optimizer<TensorDataType>::get_gradient() -> AbsDistMatrixType&
     LBANN_ERROR("attempted to access gradient before it is set up");
   }
 
+  // Each process only reduces its shard in the optimization step
+  if (m_shard_size > 0) {
+    LBANN_ERROR("attempted to access gradient w.r.t. weights ",
+                "\"", get_weights().get_name(), "\" ",
+                "while its optimizer state is sharded");
+  }
+
+  // Accumulated micro-batch contributions are not complete
+  if (this->get_defer_gradient_allreduce()) {
+    LBANN_ERROR("attempted to access gradient w.r.t. weights ",
+                "\"", get_weights().get_name(), "\" ",
+                "while its allreduce is deferred");
+  }
+
   // Make sure gradient values are ready
   this->start_gradient_allreduce();
   this->finish_gradient_allreduce();
@@ -107,10 +125,29 @@ auto data_type_optimizer<TensorDataType>::get_gradient() -> AbsDistMatrixType&
   // Gather all gradients to the master precision
   this->accumulate_all_gradient_contributions(*m_gradient);
 
+  // Undo loss scaling and average micro-batches in the master
+  // precision
+  const auto gradient_scale = this->get_gradient_scale();
+  if (gradient_scale != EvalType(1)) {
+    El::Copy(*m_gradient, *m_gradient_v);
+    El::Scale(El::To<TensorDataType>(gradient_scale), *m_gradient_v);
+    return *m_gradient_v;
+  }
+
   // Return gradient
   return *m_gradient;
 }
 
+template <typename TensorDataType>
+auto data_type_optimizer<TensorDataType>::get_state_layout() const
+  -> const AbsDistMatrixType&
+{
+  if (m_gradient == nullptr) {
+    LBANN_ERROR("attempted to access gradient before it is set up");
+  }
+  return *m_gradient;
+}
+
 template <typename TensorDataType>
 void data_type_optimizer<TensorDataType>::setup(weights* w_in)
 {
@@ -140,13 +177,51 @@ void data_type_optimizer<TensorDataType>::setup_base(WeightsType* w)
     LBANN_ERROR("attempted to setup optimizer without weights");
   }
 
+  // Determine whether to shard optimizer state
+  const AbsDistMatrixType& values = m_weights->get_values();
+  m_shard_size = 0;
+  if (this->get_shard_state()) {
+    const bool print = this->get_comm().am_trainer_master();
+    const El::Int num_shards = values.RedundantSize();
+    if (!this->supports_state_sharding()) {
+      if (print) {
+        LBANN_WARNING(this->get_type(), " optimizer for weights \"",
+                      m_weights->get_name(), "\" does not support ",
+                      "sharded state");
+      }
+    }
+    else if (values.GetLocalDevice() != El::Device::CPU
+             || !values.Contiguous()) {
+      if (print) {
+        LBANN_WARNING("optimizer for weights \"", m_weights->get_name(),
+                      "\" can only shard state for contiguous CPU weights");
+      }
+    }
+    else if (num_shards > 1) {
+      const El::Int local_size = values.LocalHeight() * values.LocalWidth();
+      m_shard_size = (local_size + num_shards - 1) / num_shards;
+    }
+    this->set_shard_state(m_shard_size > 0);
+  }
+
   // Initialize matrices
   const auto& height = m_weights->get_matrix_height();
   const auto& width = m_weights->get_matrix_width();
-  const AbsDistMatrixType& values = m_weights->get_values();
-  m_gradient.reset(AbsDistMatrixType::Instantiate(values.DistData()));
-  m_gradient->AlignWith(values);
-  m_gradient->Resize(height, width);
+  if (m_shard_size > 0) {
+    // Optimizer state is allocated with the same shape as the
+    // gradient, so it only holds the local shard.
+    using ShardMatrixType = El::DistMatrix<TensorDataType,
+                                           El::STAR, El::STAR,
+                                           El::ELEMENT,
+                                           El::Device::CPU>;
+    m_gradient.reset(new ShardMatrixType(values.Grid(), values.Root()));
+    m_gradient->Resize(m_shard_size, 1);
+  }
+  else {
+    m_gradient.reset(AbsDistMatrixType::Instantiate(values.DistData()));
+    m_gradient->AlignWith(values);
+    m_gradient->Resize(height, width);
+  }
   m_gradient_v.reset(AbsDistMatrixType::Instantiate(values.DistData()));
   m_gradient_v->AlignWith(values);
 #ifdef HYDROGEN_HAVE_CUB
@@ -156,6 +231,12 @@ void data_type_optimizer<TensorDataType>::setup_base(WeightsType* w)
 #endif // HYDROGEN_HAVE_CUB
 }
 
+template <typename TensorDataType>
+size_t data_type_optimizer<TensorDataType>::get_state_memory_usage() const
+{
+  return get_memory_usage(m_gradient.get()) + get_memory_usage(m_gradient_v.get());
+}
+
 template <typename TensorDataType>
 double data_type_optimizer<TensorDataType>::get_learning_rate() const
 {
@@ -176,10 +257,80 @@ void data_type_optimizer<TensorDataType>::step()
     LBANN_ERROR("attempted to perform optimization step without weights");
   }
   const auto start_time = get_time();
-  this->step_compute(m_weights->get_values(), this->get_gradient());
+  if (m_shard_size > 0) {
+    this->step_sharded();
+    this->inc_step_time(get_time() - start_time);
+    return;
+  }
+  const auto& gradient = this->get_gradient();
+  this->step_compute(m_weights->get_values(), gradient);
   this->inc_step_time(get_time() - start_time);
 }
 
+template <typename TensorDataType>
+void data_type_optimizer<TensorDataType>::step_sharded()
+{
+  using CPUMatType = El::Matrix<TensorDataType, El::Device::CPU>;
+  using ShardMatrixType = El::DistMatrix<TensorDataType,
+                                         El::STAR, El::STAR,
+                                         El::ELEMENT,
+                                         El::Device::CPU>;
+  auto& comm = this->get_comm();
+  auto& values = m_weights->get_values();
+  auto& local_values = dynamic_cast<CPUMatType&>(values.Matrix());
+  auto& gradient_shard = dynamic_cast<CPUMatType&>(m_gradient->Matrix());
+  const auto& redundant_comm = values.RedundantComm();
+
+  // Local entries are split into equal blocks, one per process. The
+  // last blocks may be padded or empty.
+  const El::Int num_shards = values.RedundantSize();
+  const El::Int local_size = local_values.Height() * local_values.Width();
+  const El::Int shard_offset = std::min(values.RedundantRank() * m_shard_size,
+                                        local_size);
+  const El::Int shard_height = std::min(m_shard_size,
+                                        local_size - shard_offset);
+
+  // Reduce-scatter gradient contributions
+  CPUMatType workspace;
+  El::Zeros(workspace, m_shard_size * num_shards, 1);
+  this->accumulate_local_gradient_contributions(workspace.Buffer());
+  comm.reduce_scatter(workspace.LockedBuffer(),
+                      gradient_shard.Buffer(),
+                      m_shard_size,
+                      redundant_comm);
+  const auto gradient_scale = this->get_gradient_scale();
+  if (gradient_scale != EvalType(1)) {
+    // Undo loss scaling in the master precision
+    El::Scale(El::To<TensorDataType>(gradient_scale), gradient_shard);
+  }
+
+  // Update local shard of weights
+  // Note: Processes with an empty shard still run the step, so that
+  // per-step state (e.g. Adam bias corrections) stays consistent
+  // across processes.
+  ShardMatrixType values_shard(values.Grid(), values.Root());
+  ShardMatrixType gradient_shard_v(values.Grid(), values.Root());
+  values_shard.Attach(shard_height, 1, values.Grid(), 0, 0,
+                      local_values.Buffer() + shard_offset,
+                      std::max(shard_height, El::Int(1)), values.Root());
+  gradient_shard_v.LockedAttach(shard_height, 1, values.Grid(), 0, 0,
+                                gradient_shard.LockedBuffer(),
+                                std::max(shard_height, El::Int(1)),
+                                values.Root());
+  this->step_compute(values_shard, gradient_shard_v);
+
+  // Allgather updated weights
+  CPUMatType values_send;
+  El::Zeros(values_send, m_shard_size, 1);
+  std::copy_n(local_values.LockedBuffer() + shard_offset,
+              shard_height,
+              values_send.Buffer());
+  comm.all_gather(values_send.LockedBuffer(), m_shard_size,
+                  workspace.Buffer(), m_shard_size,
+                  redundant_comm);
+  std::copy_n(workspace.LockedBuffer(), local_size, local_values.Buffer());
+}
+
 template <typename TensorDataType>
 std::tuple<El::Int, El::Int, El::DistData>
 data_type_optimizer<TensorDataType>::get_matrix_info() const
@@ -195,6 +346,17 @@ template <class Archive>
 void data_type_optimizer<TensorDataType>::serialize(Archive& ar)
 {
   ar(cereal::base_class<optimizer>(this), CEREAL_NVP(m_learning_rate));
+
+  // Rooted archives only keep the root's copy of replicated
+  // matrices, but each process holds a different shard of the
+  // optimizer state
+  if constexpr (utils::IsRootedArchive<Archive>) {
+    if (this->get_shard_state()) {
+      LBANN_ERROR("sharded optimizer state cannot be saved to or ",
+                  "loaded from a shared checkpoint; use distributed ",
+                  "checkpoints instead");
+    }
+  }
 }
 
 } // namespace lbann
@@ -97,12 +97,20 @@ public:
   using OptimizerType::setup;
   void setup(WeightsType* w = nullptr) override;
 
+  size_t get_state_memory_usage() const override;
+  size_t get_num_state_buffers() const override {
+    return OptimizerType::get_num_state_buffers() + 3;
+  }
+
 protected:
 
   /** @brief Computation for an optimization step. */
   void step_compute(AbsDistMatrixType& values,
                     const AbsDistMatrixType& gradient) override;
 
+  /** @brief The learning rate update depends on the full gradient. */
+  bool supports_state_sharding() const override { return false; }
+
 private:
 
   /** @brief Hypergradient learning rate. */
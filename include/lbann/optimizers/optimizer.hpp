@@ -100,6 +100,20 @@ public:
 
   virtual void setup(weights* w) = 0;
 
+  /** @brief Local memory held by the optimizer, in bytes.
+   *
+   *  Includes the gradient buffers and optimizer-specific state,
+   *  e.g. momentum or moment estimates.
+   */
+  virtual size_t get_state_memory_usage() const { return 0; }
+
+  /** @brief Number of weights-sized buffers allocated in setup.
+   *
+   *  Includes the gradient buffer. Used to estimate optimizer memory
+   *  without allocating it.
+   */
+  virtual size_t get_num_state_buffers() const { return 0; }
+
   /** @brief Add to the objective function gradient w.r.t. the weights.
    *  @param contrib            Contribution to gradient.
    *  @param scale              Scaling factor for gradient
@@ -158,6 +172,56 @@ public:
   /** @brief Perform optimization step. */
   virtual void step() = 0;
 
+  /** @brief Whether the local gradient entries are all finite.
+   *
+   *  Completes any outstanding gradient allreduce. The gradient
+   *  contributions are checked in their own data types, so an
+   *  overflow in a reduced-precision contribution is detected.
+   */
+  bool gradient_is_finite();
+
+  /** @brief Set scaling factor applied to the gradient.
+   *
+   *  The gradient is scaled in the optimizer's data type, e.g. to
+   *  undo loss scaling in the master precision. The scale applies to
+   *  the gradient returned by get_gradient as well as to the
+   *  optimization step.
+   */
+  void set_gradient_scale(EvalType scale) { m_gradient_scale = scale; }
+  /** @brief Scaling factor applied to the gradient in the
+   *         optimization step. */
+  EvalType get_gradient_scale() const noexcept { return m_gradient_scale; }
+
+  /** @brief Whether optimizer state is sharded over the redundant
+   *         communicator of the weights.
+   *
+   *  If true, the gradient is reduce-scattered instead of
+   *  allreduced, each process updates its own shard of the weights
+   *  and optimizer state, and the weights are allgathered after the
+   *  optimization step.
+   */
+  bool get_shard_state() const noexcept { return m_shard_state; }
+  /** @brief Set whether optimizer state is sharded.
+   *
+   *  Optimizers that cannot shard their state fall back to the
+   *  replicated update during setup.
+   */
+  void set_shard_state(bool shard_state) { m_shard_state = shard_state; }
+
+  /** @brief Whether the gradient allreduce is deferred. */
+  bool get_defer_gradient_allreduce() const noexcept {
+    return m_defer_gradient_allreduce;
+  }
+  /** @brief Set whether the gradient allreduce is deferred.
+   *
+   *  While deferred, removing the last gradient source does not
+   *  launch the gradient allreduce, so contributions from several
+   *  backprops (e.g. micro-batches) accumulate locally.
+   */
+  void set_defer_gradient_allreduce(bool defer) {
+    m_defer_gradient_allreduce = defer;
+  }
+
   /** @brief Get the gradient buffer.
    *
    *  This provides access to the underlying gradient buffer, which
@@ -228,6 +292,7 @@ protected:
     virtual void start_allreduce(lbann_comm&) = 0;
     virtual void complete_allreduce(lbann_comm&) = 0;
     virtual void clear() = 0;
+    virtual bool is_finite() const = 0;
   private:
     optimizer_gradient_status status_ = optimizer_gradient_status::cleared;
   };// class GradientHelper
@@ -283,6 +348,24 @@ protected:
     void clear() override {
       this->set_status(optimizer_gradient_status::cleared);
     }
+    bool is_finite() const override {
+      using CPUMatType = El::Matrix<TensorDataType, El::Device::CPU>;
+      const auto& local_gradient = gradient_->LockedMatrix();
+      const auto* cpu_gradient = dynamic_cast<const CPUMatType*>(&local_gradient);
+      CPUMatType host_gradient;
+      if (cpu_gradient == nullptr) {
+        El::Copy(local_gradient, host_gradient);
+        cpu_gradient = &host_gradient;
+      }
+      for (El::Int col = 0; col < cpu_gradient->Width(); ++col) {
+        for (El::Int row = 0; row < cpu_gradient->Height(); ++row) {
+          if (!std::isfinite(El::To<double>(cpu_gradient->CRef(row, col)))) {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
   private:
     std::unique_ptr<AbsDistMatType> gradient_;
     Al::request allreduce_req_;
@@ -314,6 +397,16 @@ protected:
   void accumulate_all_gradient_contributions(
     El::AbstractDistMatrix<TensorDataType>& gradient);
 
+  /** @brief Sum local gradient contributions into a CPU buffer.
+   *
+   *  Used instead of the gradient allreduce when optimizer state is
+   *  sharded. Contributions are scaled so that summing @c buffer
+   *  over the redundant communicator recovers the gradient. Entries
+   *  are packed in column-major order.
+   */
+  template <typename TensorDataType>
+  void accumulate_local_gradient_contributions(TensorDataType* buffer);
+
   /** @brief Launch non-blocking allreduce on the gradient, if needed.
    *
    *  Does nothing if an allreduce is not needed or has already been
@@ -358,6 +451,17 @@ private:
   /** @brief Time spent in optimization step. */
   EvalType m_step_time = 0;
 
+  /** @brief Scaling factor applied to the gradient in the
+   *         optimization step. */
+  EvalType m_gradient_scale = 1;
+
+  /** @brief Whether optimizer state is sharded over the redundant
+   *         communicator of the weights. */
+  bool m_shard_state = false;
+
+  /** @brief Whether the gradient allreduce is deferred. */
+  bool m_defer_gradient_allreduce = false;
+
   /** @brief Map from data types to gradient contributions.
    *  @todo Refactor this out. It's a hack.
    */
@@ -505,6 +609,62 @@ void optimizer::accumulate_all_gradient_contributions(
   }
 }
 
+template <typename TensorDataType>
+void optimizer::accumulate_local_gradient_contributions(TensorDataType* buffer)
+{
+  using AbsDistMatType = El::AbstractDistMatrix<TensorDataType>;
+  using CPUMatType = El::Matrix<TensorDataType, El::Device::CPU>;
+  auto const this_type_idx = std::type_index(typeid(TensorDataType));
+
+  std::unique_ptr<AbsDistMatType> tmp;
+  for (auto const& grad_mgr_v : this->gradients_) {
+    auto const& grad_mgr = *(grad_mgr_v.second);
+    auto const& grad_base = grad_mgr.gradient();
+
+    // Contributions that are already identical over the redundant
+    // communicator are split evenly between processes.
+    TensorDataType scale;
+    switch (grad_mgr.get_status()) {
+    case optimizer_gradient_status::allreduce_needed:
+      scale = TensorDataType(1.f);
+      break;
+    case optimizer_gradient_status::ready:
+      scale = TensorDataType(1.f) / El::To<TensorDataType>(grad_base.RedundantSize());
+      break;
+    case optimizer_gradient_status::cleared:
+      continue;
+    case optimizer_gradient_status::allreduce_started:
+    default:
+      LBANN_ERROR("unexpected gradient status ("
+                  + to_string(grad_mgr.get_status()) + ")");
+    }
+
+    // Convert contribution to TensorDataType, if needed
+    AbsDistMatType const* contrib = nullptr;
+    if (grad_mgr_v.first == this_type_idx) {
+      contrib = &dynamic_cast<AbsDistMatType const&>(grad_base);
+    }
+    else {
+      if (tmp == nullptr) {
+        tmp.reset(AbsDistMatType::Instantiate(grad_base.DistData()));
+      }
+      El::Copy(grad_base, *tmp);
+      contrib = tmp.get();
+    }
+
+    // Accumulate local entries
+    auto const& local_contrib =
+      dynamic_cast<CPUMatType const&>(contrib->LockedMatrix());
+    const El::Int local_height = local_contrib.Height();
+    const El::Int local_width = local_contrib.Width();
+    for (El::Int col = 0; col < local_width; ++col) {
+      for (El::Int row = 0; row < local_height; ++row) {
+        buffer[row + col * local_height] += scale * local_contrib.CRef(row, col);
+      }
+    }
+  }
+}
+
 } // namespace lbann
 
 #endif // LBANN_OPTIMIZERS_OPTIMIZER_HPP_INCLUDED
@@ -36,6 +36,10 @@ namespace lbann {
 const int lbann_default_random_seed = 42;
 
 /** @brief Loads a trained model from checkpoint for inference only
+ *
+ * The model is set up without optimizers, so no gradients or
+ * optimizer state are allocated, and its weights are frozen.
+ *
  * @param[in] lc An LBANN Communicator
  * @param[in] cp_dir The model checkpoint directory
  * @param[in] mbs The max mini-batch size
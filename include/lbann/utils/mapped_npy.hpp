@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef LBANN_UTILS_MAPPED_NPY_HPP_INCLUDED
+#define LBANN_UTILS_MAPPED_NPY_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace lbann {
+
+/** @brief Read-only NumPy array backed by a memory-mapped file.
+ *
+ *  Maps a .npy file, or an uncompressed member of a .npz file, into
+ *  the address space instead of reading it into private memory.
+ *  Pages are loaded on demand and live in the page cache, so
+ *  processes on a node that read the same file share one copy and
+ *  each one only touches the samples it fetches. Copies of the
+ *  object share the mapping.
+ *
+ *  Arrays that are already in memory (e.g. decompressed .npz
+ *  members) can be wrapped with the same interface.
+ *
+ *  Entries are not necessarily aligned (members of .npz files start
+ *  at arbitrary offsets), so they are accessed through @c read and
+ *  @c get rather than typed pointers.
+ */
+class mapped_npy_array {
+public:
+
+  mapped_npy_array() = default;
+
+  /** @brief Map a .npy file. */
+  explicit mapped_npy_array(const std::string& filename);
+
+  /** @brief Map an array in a .npz file.
+   *
+   *  @param filename .npz file.
+   *  @param key      Array name, without the ".npy" suffix.
+   *
+   *  The member must be stored uncompressed (@c numpy.savez). See
+   *  @c is_npz_member_mappable.
+   */
+  mapped_npy_array(const std::string& filename, const std::string& key);
+
+  /** @brief Wrap an array that is already in memory.
+   *
+   *  @param shape      Array dimensions.
+   *  @param type_code  NumPy type kind ('f', 'i', 'u', or 'b').
+   *  @param word_size  Size of an entry in bytes.
+   *  @param data       Buffer holding the entries in C order.
+   */
+  mapped_npy_array(std::vector<size_t> shape,
+                   char type_code,
+                   size_t word_size,
+                   std::shared_ptr<const char> data);
+
+  /** @brief Whether a .npz file contains an array. */
+  static bool has_npz_member(const std::string& filename,
+                             const std::string& key);
+
+  /** @brief Whether an array in a .npz file is stored uncompressed. */
+  static bool is_npz_member_mappable(const std::string& filename,
+                                     const std::string& key);
+
+  const std::vector<size_t>& shape() const noexcept { return m_shape; }
+  /** @brief NumPy type kind ('f', 'i', 'u', or 'b'). */
+  char type_code() const noexcept { return m_type_code; }
+  size_t word_size() const noexcept { return m_word_size; }
+  bool fortran_order() const noexcept { return m_fortran_order; }
+  size_t num_entries() const noexcept;
+  /** @brief Whether the array holds data. */
+  bool empty() const noexcept { return m_data == nullptr; }
+
+  /** @brief Raw bytes of the array entries. */
+  const char* data() const noexcept { return m_data; }
+
+  /** @brief Read a contiguous range of entries.
+   *
+   *  Entries are converted from the stored type to @c T. If the types
+   *  match, this is a single memcpy.
+   */
+  template <typename T>
+  void read(size_t offset, size_t count, T* dest) const;
+
+  /** @brief Read one entry. */
+  template <typename T>
+  T get(size_t index) const {
+    T val;
+    read(index, 1, &val);
+    return val;
+  }
+
+private:
+
+  /** @brief Parse .npy header and set array metadata.
+   *  @returns Pointer to start of array entries.
+   */
+  const char* parse_header(const char* begin, size_t size,
+                           const std::string& name);
+
+  template <typename SrcT, typename T>
+  void convert(size_t offset, size_t count, T* dest) const;
+
+  /** @brief Report a NumPy type that cannot be read. */
+  [[noreturn]] static void throw_unsupported_type(char type_code,
+                                                  size_t word_size);
+
+  /** @brief Owns the mapping or the in-memory buffer. */
+  std::shared_ptr<const char> m_buffer;
+  /** @brief Start of array entries. */
+  const char* m_data = nullptr;
+  std::vector<size_t> m_shape;
+  char m_type_code = 'f';
+  size_t m_word_size = 0;
+  bool m_fortran_order = false;
+
+};
+
+// ---------------------------------------------------------------
+// Implementation
+// ---------------------------------------------------------------
+
+template <typename SrcT, typename T>
+void mapped_npy_array::convert(size_t offset, size_t count, T* dest) const {
+  const char* src = m_data + offset * sizeof(SrcT);
+  if (std::is_same<SrcT, T>::value) {
+    std::memcpy(dest, src, count * sizeof(T));
+  }
+  else {
+    for (size_t i = 0; i < count; ++i) {
+      SrcT val;
+      std::memcpy(&val, src + i * sizeof(SrcT), sizeof(SrcT));
+      dest[i] = static_cast<T>(val);
+    }
+  }
+}
+
+template <typename T>
+void mapped_npy_array::read(size_t offset, size_t count, T* dest) const {
+  switch (m_type_code) {
+  case 'f':
+    switch (m_word_size) {
+    case 4: convert<float>(offset, count, dest); return;
+    case 8: convert<double>(offset, count, dest); return;
+    default: break;
+    }
+    break;
+  case 'i':
+    switch (m_word_size) {
+    case 1: convert<int8_t>(offset, count, dest); return;
+    case 2: convert<int16_t>(offset, count, dest); return;
+    case 4: convert<int32_t>(offset, count, dest); return;
+    case 8: convert<int64_t>(offset, count, dest); return;
+    default: break;
+    }
+    break;
+  case 'u':
+  case 'b':
+    switch (m_word_size) {
+    case 1: convert<uint8_t>(offset, count, dest); return;
+    case 2: convert<uint16_t>(offset, count, dest); return;
+    case 4: convert<uint32_t>(offset, count, dest); return;
+    case 8: convert<uint64_t>(offset, count, dest); return;
+    default: break;
+    }
+    break;
+  default: break;
+  }
+  throw_unsupported_type(m_type_code, m_word_size);
+}
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_MAPPED_NPY_HPP_INCLUDED
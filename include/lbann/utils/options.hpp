@@ -18,6 +18,7 @@ namespace lbann {
 #define LBANN_OPTION_LTFB_ALLOW_GLOBAL_STATISTICS "LTFB Allow global statistics"
 #define LBANN_OPTION_LTFB_VERBOSE "ltfb_verbose"
 #define LBANN_OPTION_NO_IM_COMM "no_im_comm"
+#define LBANN_OPTION_NO_TENSOR_ALIASING "no_tensor_aliasing"
 #define LBANN_OPTION_PRELOAD_DATA_STORE "preload_data_store"
 #define LBANN_OPTION_PRINT_AFFINITY "print_affinity"
 #define LBANN_OPTION_SERIALIZE_IO "serialize_io"
@@ -60,9 +61,11 @@ namespace lbann {
 /****** datastore options ******/
 // Bool flags
 #define LBANN_OPTION_DATA_STORE_CACHE "data_store_cache"
+#define LBANN_OPTION_DATA_STORE_COMPRESS "data_store_compress"
 #define LBANN_OPTION_DATA_STORE_DEBUG "data_store_debug"
 #define LBANN_OPTION_DATA_STORE_FAIL "data_store_fail"
 #define LBANN_OPTION_DATA_STORE_MIN_MAX_TIMING "data_store_min_max_timing"
+#define LBANN_OPTION_DATA_STORE_NODE_LOCAL "data_store_node_local"
 #define LBANN_OPTION_DATA_STORE_NO_THREAD "data_store_no_thread"
 #define LBANN_OPTION_DATA_STORE_PROFILE "data_store_profile"
 #define LBANN_OPTION_DATA_STORE_SPILL "data_store_spill"
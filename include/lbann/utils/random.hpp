@@ -148,7 +148,9 @@ void uniform_fill(El::AbstractDistMatrix<TensorDataType>& mat, El::Int m, El::In
  * Make mat into an m x n matrix where each entry is independently drawn from
  * a Gaussian distribution with given mean and standard deviation.
  * This always ensures that the entries of the matrix do not change as the grid
- * it is distributed over changes.
+ * it is distributed over changes: each process generates its local entries
+ * with a counter-based generator keyed by the global entry index (see
+ * next_counter_rng_key), independent of the number of processes and threads.
  */
 template <typename TensorDataType>
 void gaussian_fill_procdet(El::AbstractDistMatrix<TensorDataType>& mat, El::Int m, El::Int n,
@@ -29,6 +29,8 @@
 
 #include "lbann/comm.hpp"
 #include "lbann/utils/exception.hpp"
+#include <array>
+#include <cstdint>
 #include <random>
 #include <atomic>
 #include <thread>
@@ -76,6 +78,68 @@ struct locked_io_rng_ref {
   locked_io_rng_ref(locked_io_rng_ref&& ) = default;
 };
 
+/** @brief Philox4x32-10 counter-based random number generator
+ *
+ *  A stateless bijection from a 128-bit counter to 128 random bits,
+ *  parameterized by a 64-bit key (Salmon et al., "Parallel random
+ *  numbers: as easy as 1, 2, 3", SC 2011). Any process or thread can
+ *  generate the value for a given counter independently, so results
+ *  do not depend on how the work is divided.
+ */
+class philox4x32 {
+public:
+  using counter_type = std::array<uint32_t, 4>;
+  using key_type = std::array<uint32_t, 2>;
+  using result_type = std::array<uint32_t, 4>;
+
+  static constexpr result_type generate(counter_type ctr, key_type key) {
+    for (int round = 0; round < 10; ++round) {
+      const uint64_t p0 = uint64_t(0xD2511F53u) * ctr[0];
+      const uint64_t p1 = uint64_t(0xCD9E8D57u) * ctr[2];
+      ctr = {uint32_t(p1 >> 32) ^ ctr[1] ^ key[0], uint32_t(p1),
+             uint32_t(p0 >> 32) ^ ctr[3] ^ key[1], uint32_t(p0)};
+      key[0] += 0x9E3779B9u;
+      key[1] += 0xBB67AE85u;
+    }
+    return ctr;
+  }
+};
+
+/** @brief Key for counter-based generation of one tensor fill
+ *
+ *  @c seed is identical on every process in a trainer; @c stream
+ *  distinguishes successive fills (tensors and steps). The counter
+ *  for an entry is its global index in the tensor.
+ */
+struct counter_rng_key {
+  uint64_t seed;
+  uint64_t stream;
+
+  /** @brief Random bits for the entry with the given global index */
+  philox4x32::result_type operator()(uint64_t index) const {
+    return philox4x32::generate(
+      {uint32_t(index), uint32_t(index >> 32),
+       uint32_t(stream), uint32_t(stream >> 32)},
+      {uint32_t(seed), uint32_t(seed >> 32)});
+  }
+};
+
+/**
+ * Return the key for the next counter-based fill and advance the
+ * stream. Every process must request keys in the same order.
+ */
+counter_rng_key next_counter_rng_key();
+
+/**
+ * Return the seed of the counter-based generator, for callers that
+ * derive their own streams (e.g, from a layer and a step).
+ */
+uint64_t get_counter_rng_seed();
+
+/** @brief Position of the counter-based stream, for checkpointing */
+uint64_t get_counter_rng_stream();
+void set_counter_rng_stream(uint64_t stream);
+
 /**
  * Return a reference to the global LBANN random number generator.
  * @note If compiling with OpenMP, this is stored in a threadprivate variable.
@@ -124,7 +188,13 @@ fast_rng_gen& get_fast_io_generator();
 
 /** @brief Initialize the random number generator (with optional seed).
  *
- *  @param seed Seed value for the random number generator
+ *  Also seeds the counter-based generator with @c seed before the
+ *  rank is mixed in and resets its stream.
+ *
+ *  @param seed Seed value for the random number generator. If -1, a
+ *              seed is drawn on the first process and broadcast, so
+ *              this must be called on every process of the trainer
+ *              (or of MPI_COMM_WORLD if @c comm is not given).
  *  @param num_io_RNGs The number of RNGs for I/O.
  *  @param comm If present, mixes the process's rank within the
  *              trainer into the seed; if not, uses the MPI world
@@ -35,6 +35,7 @@
 
 #include <optional>
 #include <string>
+#include <type_traits>
 
 namespace details
 {
@@ -205,6 +206,29 @@ private:
   El::Int root_;
 };// RootedInputArchiveAdaptor
 
+namespace utils
+{
+namespace details
+{
+template <typename ArchiveT>
+struct IsRootedArchiveT : std::false_type {};
+template <typename ArchiveT>
+struct IsRootedArchiveT<RootedOutputArchiveAdaptor<ArchiveT>>
+  : std::true_type
+{};
+template <typename ArchiveT>
+struct IsRootedArchiveT<RootedInputArchiveAdaptor<ArchiveT>>
+  : std::true_type
+{};
+}// namespace details
+
+/** @brief Variable template for checking that an archive collects
+ *         data to the root of a grid.
+ */
+template <typename ArchiveT>
+constexpr bool IsRootedArchive = details::IsRootedArchiveT<ArchiveT>::value;
+}// namespace utils
+
 #ifdef LBANN_HAS_CEREAL_BINARY_ARCHIVES
 using RootedBinaryInputArchive =
   RootedInputArchiveAdaptor<cereal::BinaryInputArchive>;
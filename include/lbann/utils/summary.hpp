@@ -29,6 +29,7 @@
 #ifndef LBANN_SUMMARY_HPP_INCLUDED
 #define LBANN_SUMMARY_HPP_INCLUDED
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "lbann/base.hpp"
@@ -106,8 +107,10 @@ public:
                     int /*step*/);
   /**
    * Write all summaries out.
-   * @todo This can be made faster by combining collective operations element-
-   * wise for each type of summary.
+   * Pending operations are packed into one buffer and reduced with a
+   * single non-blocking collective. The reduction is completed, and
+   * its summaries are written, by the next call to flush (or by the
+   * destructor), so summaries appear one flush late.
    */
   void flush();
 
@@ -180,22 +183,46 @@ public:
   /** Currently-pending reduce_histograms. */
   std::vector<pending_histogram> m_pending_histograms;
 
-  /** Execute all pending mean operations. */
-  void flush_means();
-  /** Execute all pending min operations. */
-  void flush_mins();
-  /** Execute all pending max operations. */
-  void flush_maxes();
-  /** Execute all pending stdev operations. */
-  void flush_stdevs();
-  /** Execute all pending scalar operations. */
-  void flush_scalars();
-  /** Execute all pending sum-scalar operations. */
-  void flush_sum_scalars();
+  /** Operations being reduced by a non-blocking collective.
+   *  The packed buffer begins with the number of entries that are
+   *  summed and the number of entries that are maxed (mins are
+   *  negated), followed by those entries.
+   */
+  struct pending_flush {
+    std::vector<pending_op> means;
+    std::vector<pending_op> mins;
+    std::vector<pending_op> maxes;
+    std::vector<pending_op> stdevs;
+    std::vector<pending_op> scalars;
+    std::vector<pending_op> sum_scalars;
+    std::vector<pending_histogram> histograms;
+    /** Packed local values. */
+    std::vector<float> local;
+    /** Packed reduced values (only on trainer master). */
+    std::vector<float> reduced;
+    /** Datatype for the whole packed buffer.
+     *  MPI applies the reduction to whole elements, so this keeps it
+     *  from splitting the buffer and losing the layout.
+     */
+    MPI_Datatype type = MPI_DATATYPE_NULL;
+    MPI_Request request = MPI_REQUEST_NULL;
+  };
+
+  /** Reduction in flight, if any. */
+  std::unique_ptr<pending_flush> m_pending_flush;
+  /** Reduction that sums and maxes packed buffers in one pass. */
+  MPI_Op m_packed_op = MPI_OP_NULL;
+
+  /** Pack pending operations and start a non-blocking reduction. */
+  void start_flush();
+  /** Complete the reduction in flight and write its summaries. */
+  void finish_flush();
+  /** Write summaries from a reduced packed buffer for one model.
+   *  @param values Reduced packed buffer, followed by scalars.
+   */
+  void write_packed(const pending_flush& f, const float* values, int model);
   /** Execute all pending scalar-all operations. */
   void flush_scalar_alls();
-  /** Execute all pending histogram operations. */
-  void flush_histograms();
 
   /** Compute the sum of elements in mat. */
   template <typename TensorDataType>
@@ -216,9 +243,6 @@ public:
   std::string prepend_model(const std::string tag, int model) const;
   /** Gather and write out a scalar summary for each model. */
   void gather_scalar_summary(const std::string tag, float s, int step);
-  /** Gather and write out a scalar summary for each entry in a vector. */
-  void gather_scalar_summary(const std::vector<pending_op>& ops,
-                             std::vector<float>& scalars);
 };
 
 #else
@@ -45,9 +45,9 @@ namespace lbann {
 template <typename TDT>
 void do_tensor_copy(const BaseDistMat& src, El::AbstractDistMatrix<TDT>& tgt);
 
-/// @brief If distributed tensors have the same distribution setup the
-/// target to use a view to the source tensor, otherwise copy the src
-/// to target.
+/// @brief If distributed tensors have the same distribution and data
+/// type setup the target to use a view to the source tensor,
+/// otherwise copy the src to target.
 template <typename TDT>
 void view_or_copy_tensor(const BaseDistMat& src,
                          El::AbstractDistMatrix<TDT>& tgt);
@@ -57,9 +57,11 @@ template <typename TDT>
 void view_or_copy_tensor(const BaseDistMat& src,
                          El::AbstractDistMatrix<TDT>& tgt) {
 
-  if (src.DistData() == tgt.DistData()) {
-    El::LockedView(tgt,
-                   dynamic_cast<const El::AbstractDistMatrix<TDT>&>(src));
+  // Tensors with different data types are converted with a copy
+  const auto* src_same_type =
+    dynamic_cast<const El::AbstractDistMatrix<TDT>*>(&src);
+  if (src_same_type != nullptr && src.DistData() == tgt.DistData()) {
+    El::LockedView(tgt, *src_same_type);
   }
   else {
     do_tensor_copy(src, tgt);
@@ -130,6 +130,7 @@ public:
   AbsDistMatrixType& get_values() override;
   /** Get the weight matrix. */
   const AbsDistMatrixType& get_values() const override;
+  size_t get_values_memory_usage() const override;
   using weights::set_values;
   /** Set the weight matrix. */
   void set_values(const AbsDistMatrixType& values);
@@ -191,6 +191,8 @@ public:
   /** @brief Access the matrix of weights values. */
   virtual El::BaseDistMatrix& get_values() = 0;
   virtual El::BaseDistMatrix const& get_values() const = 0;
+  /** @brief Local memory held by the weights values, in bytes. */
+  virtual size_t get_values_memory_usage() const = 0;
   ///@}
 
   // -----------------------------------------------
@@ -29,7 +29,12 @@ class Model:
                  summary_dir=None,
                  subgraph_communication=SubgraphCommunication.PT2PT,
                  subgraph_topology=False,
-                 subgraph_num_common_resources=0):
+                 subgraph_num_common_resources=0,
+                 layer_parallel_threads=0,
+                 recompute_layers=[],
+                 recompute_layer_types=[],
+                 recompute_interval=0,
+                 statistics_reduction='blocking'):
 
         # Scalar fields
         self.epochs = epochs
@@ -59,6 +64,15 @@ class Model:
         self.subgraph_communication = subgraph_communication
         self.subgraph_topology = subgraph_topology
         self.subgraph_num_common_resources = subgraph_num_common_resources
+        self.layer_parallel_threads = layer_parallel_threads
+
+        # Activation recomputation
+        self.recompute_layers = make_iterable(recompute_layers)
+        self.recompute_layer_types = make_iterable(recompute_layer_types)
+        self.recompute_interval = recompute_interval
+
+        # Statistics reductions in forward prop
+        self.statistics_reduction = statistics_reduction
 
     def export_proto(self):
         """Construct and return a protobuf message."""
@@ -70,6 +84,13 @@ class Model:
         model.subgraph_communication = convert_to_protbuf_enums(self.subgraph_communication)
         model.enable_subgraph_topology = self.subgraph_topology
         model.subgraph_parent_grid_resources = self.subgraph_num_common_resources
+        model.layer_parallel_threads = self.layer_parallel_threads
+        model.recompute_layers = ' '.join(
+            l.name if isinstance(l, lbann.core.layer.Layer) else l
+            for l in self.recompute_layers)
+        model.recompute_layer_types = ' '.join(self.recompute_layer_types)
+        model.recompute_interval = self.recompute_interval
+        model.statistics_reduction = self.statistics_reduction
         if self.summary_dir is not None:
             model.summarizer.dir = self.summary_dir
         # Add model components
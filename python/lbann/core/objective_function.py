@@ -41,13 +41,19 @@ class L2WeightRegularization(ObjectiveFunctionTerm):
 class ObjectiveFunction:
     """Objective function for optimization algorithm."""
 
-    def __init__(self, terms=[]):
+    def __init__(self, terms=[], loss_scale=1.0, dynamic_loss_scaling=False):
         """Create an objective function with layer terms and regularization.
 
         `terms` should be a sequence of `ObjectiveFunctionTerm`s and
-        `Layer`s.
+        `Layer`s. `loss_scale` multiplies the objective function
+        gradient so that small gradients remain representable in
+        reduced precision layers. If `dynamic_loss_scaling` is set,
+        the scale is reduced and the optimization step is skipped
+        whenever the gradient overflows.
 
         """
+        self.loss_scale = loss_scale
+        self.dynamic_loss_scaling = dynamic_loss_scaling
         self.terms = []
         for t in make_iterable(terms):
             self.add_term(t)
@@ -72,4 +78,7 @@ class ObjectiveFunction:
                 proto.layer_term.extend([term_message])
             elif type(term) is L2WeightRegularization:
                 proto.l2_weight_regularization.extend([term_message])
+        if self.loss_scale != 1.0 or self.dynamic_loss_scaling:
+            proto.loss_scaling.initial_scale = self.loss_scale
+            proto.loss_scaling.dynamic = self.dynamic_loss_scaling
         return proto
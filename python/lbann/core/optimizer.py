@@ -3,10 +3,21 @@ from lbann import optimizers_pb2
 import lbann.core.util
 
 class Optimizer(abc.ABC):
-    """Optimization algorithm for a neural network's parameters."""
+    """Optimization algorithm for a neural network's parameters.
+
+    Args:
+        shard_state (bool): Shard optimizer state over data-parallel
+            processes.
+
+    """
+    def __init__(self, shard_state=False):
+        self.shard_state = shard_state
+
     def export_proto(self):
         """Construct and return a protobuf message."""
-        return optimizers_pb2.Optimizer()
+        proto = optimizers_pb2.Optimizer()
+        proto.shard_state = self.shard_state
+        return proto
 
 # Generate Optimizer sub-classes from lbann.proto
 # Note: The list of skip fields must be updated if any new fields are
@@ -14,7 +25,9 @@ class Optimizer(abc.ABC):
 if optimizers_pb2:
     classes = lbann.core.util.generate_classes_from_protobuf_message(
         optimizers_pb2.Optimizer,
+        skip_fields = set(['shard_state']),
         base_class = Optimizer,
+        base_kwargs = set(['shard_state']),
         base_has_export_proto = True)
     for c in classes:
         globals()[c.__name__] = c
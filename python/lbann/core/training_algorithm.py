@@ -82,7 +82,8 @@ class BatchedIterativeOptimizer(TrainingAlgorithm):
             """Construct a new BatchedIterativeOptimizer stopping criteria.
 
             Args:
-              batch_count: Number of minibatches.
+              batch_count: Number of optimization steps. Each step
+                runs num_micro_batches minibatches.
               epoch_count: Number of epochs.
               seconds: Maximum training duration.
             """
@@ -102,24 +103,29 @@ class BatchedIterativeOptimizer(TrainingAlgorithm):
             return msg
 
     def __init__(self, name: str, num_iterations: int = 0, epoch_count: int = 0,
-                 max_seconds: float = 0.):
+                 max_seconds: float = 0., num_micro_batches: int = 1):
         """Construct a new BatchedIterativeOptimizer instance.
 
         Args:
             name: A user-defined name to identify this object in logs.
-            num_iterations: Number of minibatches.
+            num_iterations: Number of optimization steps. Each step
+                runs num_micro_batches minibatches.
             epoch_count: Number of epochs.
             max_seconds: Maximum training duration (seconds)
+            num_micro_batches: Number of minibatches whose gradients
+                are accumulated before each optimization step.
         """
         self.name = name
         self.stopping = self.StoppingCriteria(batch_count=num_iterations,
                                               epoch_count=epoch_count,
                                               seconds=max_seconds)
+        self.num_micro_batches = num_micro_batches
 
     def do_export_proto(self):
         """Get a protobuf representation of this object."""
         params = AlgoProto.SGD()
         params.stopping_criteria.CopyFrom(self.stopping.export_proto())
+        params.num_micro_batches = self.num_micro_batches
         return params
 
 class MetaLearningStrategy:
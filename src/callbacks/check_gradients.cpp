@@ -240,14 +240,13 @@ void check_gradients::do_check_gradients(model& m) const {
   if (!m_modes.empty() && m_modes.count(mode) == 0) { return; }
 
   // Reset statistics and gradients
+  // Note: This also resets the gradient scales, which undo loss
+  // scaling in the gradients.
   m.get_objective_function()->reset_statistics(mode);
   for (auto&& met : m.get_metrics()) {
     met->reset_statistics(mode);
   }
-  for (auto&& w : m.get_weights()) {
-    auto&& opt = w->get_optimizer();
-    if (opt != nullptr) { opt->clear_gradient(); }
-  }
+  m.clear_gradients();
 
   // Load data in input layers
   data_coordinator& dc = get_trainer().get_data_coordinator();
@@ -147,8 +147,9 @@ struct DumpWeightsFunctor : DefaultErrorReporter
     El::Write(dtw.get_values().LockedMatrix(),
               prefix + "Weights",
               El::ASCII);
+    // Gradients are incomplete before the last micro-batch of a step
     auto* opt = dtw.get_optimizer();
-    if (opt != nullptr) {
+    if (opt != nullptr && !opt->get_defer_gradient_allreduce()) {
       El::Write(opt->get_gradient().LockedMatrix(),
                 prefix + "Gradient",
                 El::ASCII);
@@ -258,7 +259,7 @@ void check_nan::on_backward_prop_end(model *m) {
   for (weights *w : m->get_weights()) {
     auto& dtw = dynamic_cast<data_type_weights<DataType>&>(*w);
     auto* opt = dtw.get_optimizer();
-    if (opt != nullptr) {
+    if (opt != nullptr && !opt->get_defer_gradient_allreduce()) {
       El::Int row, col;
       proxy_type mat_proxy(opt->get_gradient());
       if (has_nan(mat_proxy.GetLocked(), row, col)) {
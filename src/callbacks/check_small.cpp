@@ -78,7 +78,9 @@ void check_small::on_backward_prop_end(model *m) {
   for (weights *w : m->get_weights()) {
     auto& dtw = dynamic_cast<data_type_weights<DataType>&>(*w);
     auto* opt = dtw.get_optimizer();
-    if (opt != nullptr && !is_good(opt->get_gradient())) {
+    if (opt != nullptr
+        && !opt->get_defer_gradient_allreduce()
+        && !is_good(opt->get_gradient())) {
       LBANN_ERROR(name(), ": "
                   "[", std::to_string(m->get_comm()->get_rank_in_world()), "]: "
                   "error in weights gradient of ", dtw.get_name(), " "
@@ -53,7 +53,7 @@ void dump_gradients::on_backward_prop_end(model *m) {
   const auto& c = static_cast<const SGDExecutionContext&>(m->get_execution_context());
   for (weights *w : m->get_weights()) {
     optimizer *opt = w->get_optimizer();
-    if (opt != nullptr) {
+    if (opt != nullptr && !opt->get_defer_gradient_allreduce()) {
       const std::string file
         = (m_basename
            + "model" + std::to_string(m->get_comm()->get_trainer_rank())
@@ -30,9 +30,18 @@
 #include "lbann/utils/trainer_file_utils.hpp"
 #include "lbann/layers/data_type_layer.hpp"
 #include "lbann/utils/serialize.hpp"
+#include "lbann/utils/threads/thread_pool.hpp"
+#include "lbann/data_coordinator/data_coordinator.hpp"
+#include "lbann/trainers/trainer.hpp"
 
 #include <callbacks.pb.h>
 
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <map>
+
 #ifdef LBANN_HAS_CNPY
 #include <cnpy.h>
 #endif // LBANN_HAS_CNPY
@@ -98,18 +107,188 @@ void save_npz(const std::string& file_name,
 #endif // LBANN_HAS_CNPY
 }
 
+/** NumPy type descriptor for DataType. */
+std::string npy_descr() {
+  return (sizeof(DataType) == 8 ? "<f8" : "<f4");
+}
+
+/** Header for NumPy binary file.
+ *
+ *  The number of samples is padded to a fixed width so that the
+ *  header can be rewritten in place as the file grows.
+ */
+std::string npy_header(const std::string& descr,
+                       size_t num_samples,
+                       const std::vector<int>& dims) {
+  std::ostringstream ss;
+  ss << "{'descr': '" << descr << "', "
+     << "'fortran_order': False, "
+     << "'shape': (" << std::setw(20) << num_samples << ",";
+  for (const auto& d : dims) { ss << " " << d << ","; }
+  ss << "), }";
+  std::string dict = ss.str();
+  dict.append((64 - (10 + dict.size() + 1) % 64) % 64, ' ');
+  dict.push_back('\n');
+  std::string header("\x93NUMPY\x01\x00", 8);
+  header.push_back(static_cast<char>(dict.size() & 0xFF));
+  header.push_back(static_cast<char>((dict.size() >> 8) & 0xFF));
+  return header + dict;
+}
+
+/** Shard file names for a process. */
+std::string shard_data_file(const std::string& prefix, int rank) {
+  return prefix + "_rank" + std::to_string(rank) + ".npy";
+}
+std::string shard_indices_file(const std::string& prefix, int rank) {
+  return prefix + "_rank" + std::to_string(rank) + "_indices.npy";
+}
+
 } // namespace
 
+/** Writes output shards on a background thread.
+ *
+ *  Jobs are executed in order on a single thread, which is the only
+ *  thread that accesses open shards.
+ */
+class dump_outputs::shard_writer {
+public:
+
+  shard_writer() : m_thread_pool(1) {}
+  ~shard_writer() {
+    for (auto& f : m_pending) { f.wait(); }
+  }
+
+  /** Append samples and their indices to a shard. */
+  void append(std::string data_file,
+              std::string indices_file,
+              std::vector<int> dims,
+              std::shared_ptr<const CPUMat> data,
+              std::shared_ptr<const std::vector<int64_t>> indices) {
+    submit([this, data_file, indices_file, dims, data, indices]() {
+      auto& s = m_shards[data_file];
+      if (s == nullptr) {
+        s = make_unique<shard>();
+        s->dims = dims;
+        open(s->data, data_file);
+        open(s->indices, indices_file);
+      }
+      s->data.seekp(0, std::ios::end);
+      s->data.write(reinterpret_cast<const char*>(data->LockedBuffer()),
+                    data->Height() * data->Width() * sizeof(DataType));
+      s->indices.seekp(0, std::ios::end);
+      s->indices.write(reinterpret_cast<const char*>(indices->data()),
+                       indices->size() * sizeof(int64_t));
+      s->num_samples += data->Width();
+      write_headers(*s);
+      if (!s->data.good() || !s->indices.good()) {
+        LBANN_ERROR("failed to write output shard (", data_file, ")");
+      }
+    });
+  }
+
+  /** Write a small text file. */
+  void write_file(std::string file_name, std::string contents) {
+    submit([file_name, contents]() {
+      std::ofstream fs(file_name);
+      fs << contents;
+      if (!fs.good()) {
+        LBANN_ERROR("failed to write file (", file_name, ")");
+      }
+    });
+  }
+
+  /** Close shards whose file names start with a prefix. */
+  void close(std::string prefix) {
+    submit([this, prefix]() {
+      auto it = m_shards.lower_bound(prefix);
+      while (it != m_shards.end()
+             && it->first.compare(0, prefix.size(), prefix) == 0) {
+        it = m_shards.erase(it);
+      }
+    });
+  }
+
+  /** Wait for pending jobs and report errors. */
+  void flush() {
+    while (!m_pending.empty()) {
+      auto f = std::move(m_pending.front());
+      m_pending.pop_front();
+      f.get();
+    }
+  }
+
+private:
+
+  /** Output shard. */
+  struct shard {
+    std::ofstream data;
+    std::ofstream indices;
+    std::vector<int> dims;
+    size_t num_samples = 0;
+  };
+
+  /** Maximum number of pending jobs.
+   *
+   *  Each pending append holds a copy of the outputs, so the main
+   *  thread waits if the writer falls too far behind.
+   */
+  static constexpr size_t max_pending = 16;
+
+  template <typename Job>
+  void submit(Job job) {
+    while (!m_pending.empty()
+           && (m_pending.size() >= max_pending
+               || (m_pending.front().wait_for(std::chrono::seconds(0))
+                   == std::future_status::ready))) {
+      auto f = std::move(m_pending.front());
+      m_pending.pop_front();
+      f.get();
+    }
+    m_pending.emplace_back(m_thread_pool.submit_job(std::move(job)));
+  }
+
+  static void open(std::ofstream& fs, const std::string& file_name) {
+    fs.open(file_name, std::ios::binary | std::ios::trunc);
+    if (!fs.is_open()) {
+      LBANN_ERROR("failed to open output file (", file_name, ")");
+    }
+  }
+
+  /** Rewrite headers so that shards are always valid NumPy files. */
+  static void write_headers(shard& s) {
+    const auto data_header = npy_header(npy_descr(), s.num_samples, s.dims);
+    s.data.seekp(0);
+    s.data.write(data_header.data(), data_header.size());
+    s.data.flush();
+    const auto indices_header = npy_header("<i8", s.num_samples, {});
+    s.indices.seekp(0);
+    s.indices.write(indices_header.data(), indices_header.size());
+    s.indices.flush();
+  }
+
+  /** Open shards, keyed by data file name. */
+  std::map<std::string, std::unique_ptr<shard>> m_shards;
+  /** Futures for submitted jobs, in order. */
+  std::deque<std::future<void>> m_pending;
+  /** Single worker thread.
+   *  @note Declared last so that it is destroyed first.
+   */
+  thread_pool m_thread_pool;
+
+};
+
 dump_outputs::dump_outputs(std::set<std::string> layer_names,
                            std::set<execution_mode> modes,
                            El::Int batch_interval,
                            std::string directory,
-                           std::string file_format)
+                           std::string file_format,
+                           bool sharded)
   : callback_base(std::max(batch_interval, El::Int(1))),
     m_layer_names(std::move(layer_names)),
     m_modes(std::move(modes)),
     m_directory(std::move(directory)),
-    m_file_format(std::move(file_format)) {
+    m_file_format(std::move(file_format)),
+    m_sharded(sharded) {
   std::stringstream err;
 
   // Initialize directory for output files
@@ -119,9 +298,15 @@ dump_outputs::dump_outputs(std::set<std::string> layer_names,
   if (m_directory.back() != '/') { m_directory += "/"; }
 
   // Initialize file format
-  if (m_file_format.empty()) { m_file_format = "csv"; }
+  if (m_file_format.empty()) { m_file_format = m_sharded ? "npy" : "csv"; }
+  if (m_sharded && m_file_format != "npy") {
+    err << "callback \"" << this->name() << "\" attempted "
+        << "to write shards with file format (" << m_file_format << "), "
+        << "but only npy is supported";
+    LBANN_ERROR(err.str());
+  }
 #ifndef LBANN_HAS_CNPY
-  if (m_file_format == "npy" || m_file_format == "npz") {
+  if (!m_sharded && (m_file_format == "npy" || m_file_format == "npz")) {
     err << "callback \"" << this->name() << "\" attempted "
         << "to use NumPy file format (" << m_file_format << "), "
         << "but CNPY was not detected";
@@ -141,6 +326,28 @@ dump_outputs::dump_outputs()
   : dump_outputs({}, {}, 0, "", "")
 {}
 
+dump_outputs::dump_outputs(const dump_outputs& other)
+  : callback_base(other),
+    m_layer_names(other.m_layer_names),
+    m_modes(other.m_modes),
+    m_directory(other.m_directory),
+    m_file_format(other.m_file_format),
+    m_sharded(other.m_sharded) {}
+
+dump_outputs& dump_outputs::operator=(const dump_outputs& other) {
+  callback_base::operator=(other);
+  m_layer_names = other.m_layer_names;
+  m_modes = other.m_modes;
+  m_directory = other.m_directory;
+  m_file_format = other.m_file_format;
+  m_sharded = other.m_sharded;
+  m_shard_writer.reset();
+  m_manifests.clear();
+  return *this;
+}
+
+dump_outputs::~dump_outputs() = default;
+
 template <class Archive>
 void dump_outputs::serialize(Archive & ar) {
   ar(::cereal::make_nvp(
@@ -149,7 +356,8 @@ void dump_outputs::serialize(Archive & ar) {
      CEREAL_NVP(m_layer_names),
      CEREAL_NVP(m_modes),
      CEREAL_NVP(m_directory),
-     CEREAL_NVP(m_file_format));
+     CEREAL_NVP(m_file_format),
+     CEREAL_NVP(m_sharded));
 }
 
 void dump_outputs::do_dump_outputs(const model& m, const Layer& l) {
@@ -162,6 +370,10 @@ void dump_outputs::do_dump_outputs(const model& m, const Layer& l) {
   if (!m_modes.empty() && m_modes.count(mode) == 0) { return; }
   if (!m_layer_names.empty()
       && m_layer_names.count(l.get_name()) == 0) { return; }
+  if (m_sharded) {
+    do_dump_sharded_outputs(m, l);
+    return;
+  }
 
   // Create directory
   const std::string root_file_path = get_multi_trainer_model_path(m, m_directory);
@@ -195,6 +407,96 @@ void dump_outputs::do_dump_outputs(const model& m, const Layer& l) {
 
 }
 
+void dump_outputs::do_dump_sharded_outputs(const model& m, const Layer& l) {
+  const auto& c = static_cast<const SGDExecutionContext&>(m.get_execution_context());
+  const auto& mode = c.get_execution_mode();
+  const auto& comm = *m.get_comm();
+  const int rank = comm.get_rank_in_trainer();
+  if (m_shard_writer == nullptr) {
+    m_shard_writer = make_unique<shard_writer>();
+  }
+
+  // Create directory
+  const std::string root_file_path = get_multi_trainer_model_path(m, m_directory);
+  file::trainer_master_make_directory(root_file_path, m.get_comm());
+
+  // Data sample indices for local mini-batch samples
+  const auto& dc = get_const_trainer().get_data_coordinator();
+  const auto* mb_indices = dc.get_sample_indices_per_mb(mode);
+
+  const auto& dtl = dynamic_cast<const data_type_layer<DataType>&>(l);
+  for (int i = 0; i < l.get_num_children(); ++i) {
+
+    // Copy local samples
+    // Note: Samples are distributed like the data coordinator's I/O
+    // buffers, so local columns match the local sample indices. The
+    // index matrix is sized for a full mini-batch, so only its
+    // leading rows are valid on a partial mini-batch. The copy is
+    // owned by the writer thread.
+    StarVCMatDT<DataType, El::Device::CPU> local_data(dtl.get_activations(i));
+    auto data = std::make_shared<CPUMat>(local_data.LockedMatrix());
+    const El::Int num_local_samples = data->Width();
+    if (mb_indices == nullptr || mb_indices->Height() < num_local_samples) {
+      LBANN_ERROR("callback \"", this->name(), "\" could not match ",
+                  num_local_samples, " local samples in ",
+                  "layer \"", l.get_name(), "\" to data sample indices");
+    }
+    auto indices = std::make_shared<std::vector<int64_t>>(num_local_samples);
+    for (El::Int j = 0; j < num_local_samples; ++j) {
+      (*indices)[j] = mb_indices->Get(j, 0);
+    }
+
+    // Write manifest on trainer master
+    const std::string prefix = (to_string(mode)
+                                + "-epoch" + std::to_string(c.get_epoch())
+                                + "_" + l.get_name()
+                                + "_output" + std::to_string(i));
+    const auto dims = dtl.get_output_dims(i);
+    if (comm.am_trainer_master() && m_manifests.count(prefix) == 0) {
+      m_manifests.insert(prefix);
+      std::ostringstream manifest;
+      manifest << "{\n"
+               << "  \"tensor\": \"" << l.get_name() << "_output" << i << "\",\n"
+               << "  \"execution_mode\": \"" << to_string(mode) << "\",\n"
+               << "  \"epoch\": " << c.get_epoch() << ",\n"
+               << "  \"dims\": [";
+      for (size_t j = 0; j < dims.size(); ++j) {
+        manifest << (j > 0 ? ", " : "") << dims[j];
+      }
+      manifest << "],\n"
+               << "  \"dtype\": \"" << npy_descr() << "\",\n"
+               << "  \"index_dtype\": \"<i8\",\n"
+               << "  \"shards\": [\n";
+      const int num_shards = comm.get_procs_per_trainer();
+      for (int r = 0; r < num_shards; ++r) {
+        manifest << "    {\"data\": \"" << shard_data_file(prefix, r) << "\", "
+                 << "\"indices\": \"" << shard_indices_file(prefix, r) << "\"}"
+                 << (r < num_shards - 1 ? "," : "") << "\n";
+      }
+      manifest << "  ]\n"
+               << "}\n";
+      m_shard_writer->write_file(root_file_path + prefix + "_manifest.json",
+                                 manifest.str());
+    }
+
+    // Append to shard in background
+    m_shard_writer->append(root_file_path + shard_data_file(prefix, rank),
+                           root_file_path + shard_indices_file(prefix, rank),
+                           dims,
+                           std::move(data),
+                           std::move(indices));
+
+  }
+
+}
+
+void dump_outputs::close_shards(const model& m, execution_mode mode) {
+  if (m_shard_writer == nullptr) { return; }
+  m_shard_writer->close(get_multi_trainer_model_path(m, m_directory)
+                        + to_string(mode) + "-epoch");
+  m_shard_writer->flush();
+}
+
 std::unique_ptr<callback_base>
 build_dump_outputs_callback_from_pbuf(
   const google::protobuf::Message& proto_msg, const std::shared_ptr<lbann_summary>&) {
@@ -207,7 +509,8 @@ build_dump_outputs_callback_from_pbuf(
                                                   modes,
                                                   params.batch_interval(),
                                                   params.directory(),
-                                                  params.format());
+                                                  params.format(),
+                                                  params.sharded());
 }
 
 } // namespace callback
@@ -111,6 +111,9 @@ void imcomm::on_backward_prop_end(model *m) {
       continue;
     }
     auto *opt = real_w.get_optimizer();
+    if (opt->get_defer_gradient_allreduce()) {
+      continue;
+    }
     auto& real_opt = dynamic_cast<data_type_optimizer<DataType>&>(*opt);
     auto gradient = to_unique_ptr(real_opt.get_gradient().Copy());
     auto& local_gradients = gradient->Matrix();
@@ -121,8 +124,12 @@ void imcomm::on_backward_prop_end(model *m) {
     default:
       LBANN_ERROR("imcomm: unknown comm type");
     }
+    // Note: The gradient scale has already been applied, so it is
+    // undone for the optimization step.
     real_opt.clear_gradient();
-    real_opt.add_to_gradient(*gradient);
+    real_opt.add_to_gradient(
+      *gradient,
+      El::To<DataType>(EvalType(1) / real_opt.get_gradient_scale()));
     EvalType im_time = get_time() - start_time;
     do_summary(*m, real_w, im_time);
   }
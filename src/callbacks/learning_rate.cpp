@@ -101,6 +101,11 @@ void learning_rate::on_epoch_end(model *m) {
 void learning_rate::on_backward_prop_end(model *m) {
   for (weights *w : this->get_weights()) {
     auto &opt = *w->get_optimizer();
+    // Schedules may read the gradient, which is only complete after
+    // the last micro-batch of the step
+    if (opt.get_defer_gradient_allreduce()) {
+      continue;
+    }
     const float old_lr = opt.get_learning_rate();
     const float new_lr = optimizer_schedule(m, opt);
     if (old_lr != new_lr) {
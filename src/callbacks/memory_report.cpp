@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "lbann/callbacks/memory_report.hpp"
+#include "lbann/comm_impl.hpp"
+#include "lbann/data_coordinator/data_coordinator.hpp"
+#include "lbann/models/model.hpp"
+#include "lbann/optimizers/optimizer.hpp"
+#include "lbann/trainers/trainer.hpp"
+#include "lbann/utils/serialize.hpp"
+#include "lbann/weights/weights.hpp"
+
+#include <callbacks.pb.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+namespace lbann {
+namespace callback {
+
+memory_report::memory_report(El::Int mini_batch_size)
+  : callback_base(), m_mini_batch_size(mini_batch_size) {}
+
+template <class Archive>
+void memory_report::serialize(Archive & ar) {
+  ar(::cereal::make_nvp(
+       "BaseCallback",
+       ::cereal::base_class<callback_base>(this)),
+     CEREAL_NVP(m_mini_batch_size));
+}
+
+auto memory_report::compute_usage(const model& m, El::Int mini_batch_size)
+  -> usage {
+  usage u;
+
+  // Layers
+  const auto layers = m.get_layers();
+  std::unordered_map<const Layer*, size_t> layer_index;
+  size_t activations = 0, error_signals = 0, workspace = 0;
+  for (const auto* l : layers) {
+    layer_index[l] = u.layers.size();
+    layer_usage lu;
+    lu.name = l->get_name();
+    lu.type = l->get_type();
+    lu.activations = l->get_output_memory_usage(mini_batch_size);
+    lu.error_signals = l->get_error_signal_memory_usage(mini_batch_size);
+    lu.workspace = l->get_workspace_memory_usage(mini_batch_size);
+    activations += lu.activations;
+    error_signals += lu.error_signals;
+    workspace += lu.workspace;
+    u.layers.push_back(std::move(lu));
+  }
+
+  // Weights and optimizers
+  size_t weights_total = 0;
+  for (const auto* w : m.get_weights()) {
+    weights_usage wu;
+    wu.name = w->get_name();
+    wu.values = w->get_values_memory_usage();
+    if (const auto* opt = w->get_optimizer()) {
+      wu.optimizer = opt->get_state_memory_usage();
+    }
+    weights_total += wu.values + wu.optimizer;
+    u.weights.push_back(std::move(wu));
+  }
+
+  // I/O buffers
+  u.io_buffers = get_trainer().get_data_coordinator().get_buffer_memory_usage();
+
+  // Error signals computed by a layer are released once all of its
+  // parents have run backprop. Layers run backprop in reverse
+  // execution order.
+  std::vector<size_t> remaining_parents(layers.size());
+  for (size_t i = 0; i < layers.size(); ++i) {
+    remaining_parents[i] = layers[i]->get_num_parents();
+  }
+  size_t live_error_signals = 0, peak_error_signals = 0;
+  for (size_t i = layers.size(); i-- > 0;) {
+    live_error_signals += u.layers[i].error_signals;
+    peak_error_signals = std::max(peak_error_signals, live_error_signals);
+    for (const auto* child : layers[i]->get_child_layers()) {
+      const auto it = layer_index.find(child);
+      if (it != layer_index.end() && --remaining_parents[it->second] == 0) {
+        live_error_signals -= u.layers[it->second].error_signals;
+      }
+    }
+  }
+
+  const size_t persistent = (activations + workspace
+                             + weights_total + u.io_buffers);
+  u.total = persistent + error_signals;
+  u.peak = persistent + peak_error_signals;
+  return u;
+}
+
+void memory_report::on_setup_end(model *m) {
+  const auto mini_batch_size = (m_mini_batch_size > 0
+                                ? m_mini_batch_size
+                                : El::Int(get_trainer().get_max_mini_batch_size()));
+  const auto u = compute_usage(*m, mini_batch_size);
+  auto* comm = m->get_comm();
+  const auto max_peak = comm->trainer_allreduce(double(u.peak), El::mpi::MAX);
+  if (!comm->am_trainer_master()) { return; }
+
+  const auto to_mib = [](size_t bytes) { return bytes / (1024. * 1024.); };
+  size_t name_width = 8;
+  for (const auto& lu : u.layers) {
+    name_width = std::max(name_width, lu.name.size() + lu.type.size() + 3);
+  }
+  for (const auto& wu : u.weights) {
+    name_width = std::max(name_width, wu.name.size());
+  }
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(2)
+     << "memory report for model \"" << m->get_name() << "\" "
+     << "at mini-batch size " << mini_batch_size
+     << " (MiB on trainer master)\n"
+     << "  " << std::left << std::setw(name_width) << "layer" << std::right
+     << std::setw(14) << "activations"
+     << std::setw(14) << "error sig."
+     << std::setw(14) << "workspace" << "\n";
+  for (const auto& lu : u.layers) {
+    ss << "  " << std::left << std::setw(name_width)
+       << (lu.name + " (" + lu.type + ")") << std::right
+       << std::setw(14) << to_mib(lu.activations)
+       << std::setw(14) << to_mib(lu.error_signals)
+       << std::setw(14) << to_mib(lu.workspace) << "\n";
+  }
+  ss << "  " << std::left << std::setw(name_width) << "weights" << std::right
+     << std::setw(14) << "values"
+     << std::setw(14) << "optimizer" << "\n";
+  for (const auto& wu : u.weights) {
+    ss << "  " << std::left << std::setw(name_width) << wu.name << std::right
+       << std::setw(14) << to_mib(wu.values)
+       << std::setw(14) << to_mib(wu.optimizer) << "\n";
+  }
+  ss << "  I/O buffers: " << to_mib(u.io_buffers) << "\n"
+     << "  total: " << to_mib(u.total) << ", "
+     << "predicted peak: " << to_mib(u.peak) << " "
+     << "(max over trainer processes: " << max_peak / (1024. * 1024.) << ")";
+  std::cout << ss.str() << std::endl;
+}
+
+std::unique_ptr<callback_base>
+build_memory_report_callback_from_pbuf(
+  const google::protobuf::Message& proto_msg,
+  const std::shared_ptr<lbann_summary>&) {
+  const auto& params =
+    dynamic_cast<const lbann_data::Callback::CallbackMemoryReport&>(proto_msg);
+  return make_unique<memory_report>(params.mini_batch_size());
+}
+
+} // namespace callback
+} // namespace lbann
+
+#define LBANN_CLASS_NAME callback::memory_report
+#include <lbann/macros/register_class_with_cereal.hpp>
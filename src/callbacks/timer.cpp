@@ -26,6 +26,8 @@
 
 #include "lbann/comm_impl.hpp"
 #include "lbann/callbacks/timer.hpp"
+#include "lbann/data_coordinator/data_coordinator.hpp"
+#include "lbann/trainers/trainer.hpp"
 #include "lbann/utils/timer.hpp"
 #include "lbann/utils/argument_parser.hpp"
 #include "lbann/utils/lbann_library.hpp"
@@ -44,7 +46,8 @@ void timer::serialize(Archive & ar) {
        ::cereal::base_class<callback_base>(this)),
      CEREAL_NVP(m_start_times),
      CEREAL_NVP(m_batch_start_times),
-     CEREAL_NVP(m_batch_times));
+     CEREAL_NVP(m_batch_times),
+     CEREAL_NVP(m_batch_io_times));
   /// @todo Consider what to do with m_summarizer (preferably remove)
 }
 
@@ -58,9 +61,12 @@ void timer::batch_timing_end(const model& m) {
   const auto& mode = c.get_execution_mode();
   const auto& batch_time = get_time() - m_batch_start_times[mode];
   m_batch_times[mode].push_back(batch_time);
+  const auto& io_time = get_const_trainer().get_data_coordinator().get_exposed_io_time(mode);
+  m_batch_io_times[mode].push_back(io_time);
   if (m_summarizer != nullptr) {
     m_summarizer->reduce_scalar("minibatch_time", batch_time, c.get_step()-1);
     m_summarizer->reduce_scalar_all("minibatch_time", batch_time, c.get_step()-1);
+    m_summarizer->reduce_scalar("exposed_io_time", io_time, c.get_step()-1);
   }
 }
 
@@ -69,6 +75,7 @@ void timer::timing_begin(const model& m) {
   const auto& mode = c.get_execution_mode();
   m_start_times[mode] = get_time();
   m_batch_times[mode].clear();
+  m_batch_io_times[mode].clear();
 }
 
 void timer::timing_end(model& m) {
@@ -108,6 +115,17 @@ void timer::timing_end(model& m) {
       batch_time_median = (sorted_times[(num_batches-1)/2] + sorted_times[num_batches/2] ) / 2;
     }
   }
+  // Compute exposed I/O statistics
+  const auto& io_times = m_batch_io_times[mode];
+  EvalType io_time_mean = std::nan("");
+  EvalType io_time_max = std::nan("");
+  if (!io_times.empty()) {
+    io_time_mean = std::accumulate(io_times.begin(),
+                                   io_times.end(),
+                                   zero) / io_times.size();
+    io_time_max = *std::max_element(io_times.begin(),
+                                    io_times.end());
+  }
   if (num_batches > 1) {
     batch_time_stdev = zero;
     for (const auto& bt : batch_times) {
@@ -154,12 +172,14 @@ void timer::timing_end(model& m) {
       std::vector<EvalType> min_list(num_trainers);
       std::vector<EvalType> max_list(num_trainers);
       std::vector<EvalType> stdev_list(num_trainers);
+      std::vector<EvalType> io_mean_list(num_trainers);
       if (comm.am_world_master()) {
         comm.intertrainer_gather(run_time, run_time_list);
         comm.intertrainer_gather(batch_time_mean, mean_list);
         comm.intertrainer_gather(batch_time_min, min_list);
         comm.intertrainer_gather(batch_time_max, max_list);
         comm.intertrainer_gather(batch_time_stdev, stdev_list);
+        comm.intertrainer_gather(io_time_mean, io_mean_list);
       } else {
         const auto& world_master = comm.get_intertrainer_master();
         comm.intertrainer_gather(run_time, world_master);
@@ -167,6 +187,7 @@ void timer::timing_end(model& m) {
         comm.intertrainer_gather(batch_time_min, world_master);
         comm.intertrainer_gather(batch_time_max, world_master);
         comm.intertrainer_gather(batch_time_stdev, world_master);
+        comm.intertrainer_gather(io_time_mean, world_master);
       }
 
 
@@ -206,6 +227,16 @@ void timer::timing_end(model& m) {
           }
           std::cout << " stdev" << std::endl;
         }
+        for (El::Int i = 0; i < num_trainers; ++i) {
+          std::cout << m.get_name() << " (instance " << i << ") " << mode_string << " "
+                    << "exposed I/O time : ";
+          if (std::isnan(io_mean_list[i])) {
+            std::cout << "N/A";
+          } else {
+            std::cout << io_mean_list[i] << "s mean";
+          }
+          std::cout << std::endl;
+        }
       }
     }else {
       // Print results for each trainer
@@ -239,6 +270,16 @@ void timer::timing_end(model& m) {
         report << batch_time_stdev << "s";
       }
       report << " stdev" << std::endl;
+      report << m.get_name() << " (instance " << comm.get_trainer_rank() << ") " << mode_string << " "
+                << "exposed I/O time : ";
+      if (std::isnan(io_time_mean)) {
+        report << "N/A";
+      } else {
+        report << io_time_mean << "s mean, "
+               << io_time_max << "s max, "
+               << 100 * io_time_mean / batch_time_mean << "% of mini-batch time";
+      }
+      report << std::endl;
 
       std::cout << report.str() << std::flush;
     }
@@ -36,6 +36,7 @@
 #include "lbann/utils/distconv.hpp"
 #include "lbann/utils/serialize.hpp"
 #include "lbann/utils/tensor_impl.hpp"
+#include "lbann/utils/timer.hpp"
 #include "lbann/io/persist_impl.hpp"
 
 namespace lbann {
@@ -131,6 +132,23 @@ void buffered_data_coordinator<TensorDataType>::setup_data_fields(
   }
 }
 
+template <typename TensorDataType>
+size_t buffered_data_coordinator<TensorDataType>::get_buffer_memory_usage() const
+{
+  size_t bytes = 0;
+  for (const auto& buffer_map : m_data_buffers) {
+    for (const auto& [mode, data_buffer] : buffer_map) {
+      for (const auto& [data_field, input_buffer] : data_buffer->m_input_buffers) {
+        if (input_buffer != nullptr) {
+          bytes += (input_buffer->LocalHeight() * input_buffer->LocalWidth()
+                    * sizeof(IODataType));
+        }
+      }
+    }
+  }
+  return bytes;
+}
+
 template <typename TensorDataType>
 int buffered_data_coordinator<TensorDataType>::fetch_to_local_matrix(data_buffer_map_t& buffer_map, const execution_mode mode) {
   generic_data_reader *dr = get_data_reader(mode);
@@ -218,6 +236,7 @@ void buffered_data_coordinator<TensorDataType>::collect_background_data_fetch(ex
 template <typename TensorDataType>
 void buffered_data_coordinator<TensorDataType>::fetch_data(execution_mode mode) {
 
+  const auto start_time = get_time();
   increment_active_buffer_idx(mode);
 
   data_buffer<IODataType>& active_buffer = get_active_buffer(mode);
@@ -236,6 +255,7 @@ void buffered_data_coordinator<TensorDataType>::fetch_data(execution_mode mode)
     active_buffer.get_data_fetch_future().get();
     active_buffer.set_fetch_data_in_background(false);
   }
+  m_exposed_io_time[mode] = get_time() - start_time;
 
   //  int num_samples_in_batch = 0;
   if(active_buffer.num_samples_ready() > 0) {
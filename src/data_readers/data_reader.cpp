@@ -38,6 +38,7 @@
 
 #include <omp.h>
 #include <future>
+#include <numeric>
 
 namespace lbann {
 
@@ -66,8 +67,54 @@ void generic_data_reader::shuffle_indices() {
 void generic_data_reader::shuffle_indices(rng_gen& gen) {
   // Shuffle the data
   if (m_shuffle) {
-    std::shuffle(m_shuffled_indices.begin(), m_shuffled_indices.end(),
-                 gen);
+    if (m_shuffle_window > 0) {
+      block_shuffle_indices(gen);
+    } else {
+      std::shuffle(m_shuffled_indices.begin(), m_shuffled_indices.end(),
+                   gen);
+    }
+  }
+}
+
+void generic_data_reader::block_shuffle_indices(rng_gen& gen) {
+  // Group the indices by block, starting from a canonical order so
+  // that the result only depends on the state of the generator (as
+  // for the global shuffle, which is restored from checkpoints)
+  std::vector<std::pair<size_t, int>> blocked_indices;
+  blocked_indices.reserve(m_shuffled_indices.size());
+  for (const auto& index : m_shuffled_indices) {
+    blocked_indices.emplace_back(get_shuffle_block(index), index);
+  }
+  std::sort(blocked_indices.begin(), blocked_indices.end());
+
+  // Offsets of the first index of each block
+  std::vector<size_t> block_offsets;
+  for (size_t i = 0; i < blocked_indices.size(); ++i) {
+    if (i == 0 || blocked_indices[i].first != blocked_indices[i-1].first) {
+      block_offsets.push_back(i);
+    }
+  }
+  const size_t num_blocks = block_offsets.size();
+  block_offsets.push_back(blocked_indices.size());
+
+  // Shuffle the order of the blocks
+  std::vector<size_t> block_order(num_blocks);
+  std::iota(block_order.begin(), block_order.end(), 0);
+  std::shuffle(block_order.begin(), block_order.end(), gen);
+
+  // Lay out the blocks in window-sized groups and shuffle the samples
+  // within each window
+  auto pos = m_shuffled_indices.begin();
+  for (size_t w = 0; w < num_blocks; w += m_shuffle_window) {
+    const auto window_begin = pos;
+    const size_t window_end = std::min(w + m_shuffle_window, num_blocks);
+    for (size_t b = w; b < window_end; ++b) {
+      const size_t block = block_order[b];
+      for (size_t i = block_offsets[block]; i < block_offsets[block+1]; ++i) {
+        *pos++ = blocked_indices[i].second;
+      }
+    }
+    std::shuffle(window_begin, pos, gen);
   }
 }
 
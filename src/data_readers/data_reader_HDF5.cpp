@@ -32,9 +32,15 @@
 #include "lbann/data_readers/sample_list_open_files_impl.hpp"
 #include "lbann/utils/timer.hpp"
 
+#include <mutex>
+
 namespace lbann {
 namespace {
 
+/** Serializes streaming reads across reader instances; the HDF5
+ *  library is not guaranteed to be thread-safe. */
+std::mutex hdf5_streaming_mutex;
+
 /** @brief Copy a floating point array into a new floating point array.
  *  @tparam ToType The new data type.
  *  @tparam FromType (Inferred) The old data type.
@@ -164,7 +170,7 @@ void hdf5_data_reader::pack(std::string const& group_name,
   }
 }
 
-hdf5_data_reader::~hdf5_data_reader() {}
+hdf5_data_reader::~hdf5_data_reader() { discard_read_ahead(); }
 
 hdf5_data_reader::hdf5_data_reader(bool shuffle)
   : data_reader_sample_list(shuffle)
@@ -181,6 +187,7 @@ hdf5_data_reader& hdf5_data_reader::operator=(const hdf5_data_reader& rhs)
   if (this == &rhs) {
     return (*this);
   }
+  discard_read_ahead();
   data_reader_sample_list::operator=(rhs);
   copy_members(rhs);
   return (*this);
@@ -198,6 +205,10 @@ void hdf5_data_reader::copy_members(const hdf5_data_reader& rhs)
   m_experiment_schema = rhs.m_experiment_schema;
   m_data_schema = rhs.m_data_schema;
   m_useme_node_map = rhs.m_useme_node_map;
+  m_streaming = rhs.m_streaming;
+  // samples loaded for (or ahead of) the current mini-batch are not
+  // copied; they are reloaded on the next fetch
+  m_streamed_samples.clear();
   // m_data_map should not be copied, as it contains pointers, and is only
   // needed for setting up other structures during load
 
@@ -220,13 +231,13 @@ void hdf5_data_reader::load()
     m_delete_packed_fields = false;
   }
 
-  // May go away; for now, this reader only supports preloading mode
-  // with data store
-  // TODO MRW
-  // opts->set_option("preload_data_store", true);
-  if (!arg_parser.get<bool>(LBANN_OPTION_USE_DATA_STORE)) {
-    LBANN_ERROR("HDF5 data reader requires the data store.",
-                "Set command line arguments --use_data_store --preload_data_store");
+  // Without the data store, samples are streamed from disk one
+  // mini-batch at a time
+  m_streaming = !arg_parser.get<bool>(LBANN_OPTION_USE_DATA_STORE);
+  if (m_streaming && get_comm()->am_world_master()) {
+    std::cout << "hdf5_data_reader - data store is not in use; streaming "
+                 "samples from disk for role: "
+              << get_role() << std::endl;
   }
 
   // Load the sample list(s)
@@ -289,11 +300,17 @@ void hdf5_data_reader::do_preload_data_store()
               << get_role() << std::endl;
   }
 
-  for (size_t idx = 0; idx < m_shuffled_indices.size(); idx++) {
-    int index = m_shuffled_indices[idx];
-    if (m_data_store->get_index_owner(index) != get_comm()->get_rank_in_trainer()) {
-      continue;
+  // Visit the owned samples file by file, in sample list order, so
+  // that each file is opened once and read front to back
+  std::vector<size_t> owned_indices;
+  for (const auto& index : m_shuffled_indices) {
+    if (m_data_store->get_index_owner(index) == get_comm()->get_rank_in_trainer()) {
+      owned_indices.push_back(index);
     }
+  }
+  sort_indices_by_file(owned_indices);
+
+  for (const auto& index : owned_indices) {
     try {
       conduit::Node& node = m_data_store->get_empty_node(index);
       load_sample(node, index);
@@ -307,12 +324,7 @@ void hdf5_data_reader::do_preload_data_store()
     }
   }
   // Once all of the data has been preloaded, close all of the file handles
-
-  for (size_t idx = 0; idx < m_shuffled_indices.size(); idx++) {
-    int index = m_shuffled_indices[idx];
-    if (m_data_store->get_index_owner(index) != get_comm()->get_rank_in_trainer()) {
-      continue;
-    }
+  for (const auto& index : owned_indices) {
     close_file(index); // data_reader_sample_list::close_file
   }
 
@@ -337,13 +349,13 @@ void hdf5_data_reader::load_sample(conduit::Node& node,
     // do not load a "packed" field, as it doesn't exist on disk!
     if (!is_composite_node(path_node)) {
 
-      // check that the requested data (pathname) exists on disk
+      // check that the requested data (pathname) exists on disk; this
+      // costs an extra metadata lookup per field, so unless failures are
+      // to be ignored we let the read itself report a missing path
       const std::string original_path = "/" + sample_name + "/" + pathname;
-      if (!conduit::relay::io::hdf5_has_path(file_handle, original_path)) {
-        if (ignore_failure) {
-          continue;
-        }
-        LBANN_ERROR("hdf5_has_path failed for path: ", original_path);
+      if (ignore_failure &&
+          !conduit::relay::io::hdf5_has_path(file_handle, original_path)) {
+        continue;
       }
 
       // get the new path-name (prepend the index)
@@ -356,13 +368,21 @@ void hdf5_data_reader::load_sample(conduit::Node& node,
 
       // optionally coerce the data, e.g, from double to float, per settings
       // in the experiment_schema
-      if (metadata.has_child(s_coerce_name)) {
-        coerce(metadata, file_handle, original_path, new_pathname, node);
+      try {
+        if (metadata.has_child(s_coerce_name)) {
+          coerce(metadata, file_handle, original_path, new_pathname, node);
+        }
+        else {
+          conduit::relay::io::hdf5_read(file_handle,
+                                        original_path,
+                                        node[new_pathname]);
+        }
       }
-      else {
-        conduit::relay::io::hdf5_read(file_handle,
-                                      original_path,
-                                      node[new_pathname]);
+      catch (conduit::Error const& e) {
+        LBANN_ERROR("failed to read path: ",
+                    original_path,
+                    "; caught conduit exception: ",
+                    e.what());
       }
 
       // optionally normalize
@@ -381,6 +401,108 @@ void hdf5_data_reader::load_sample(conduit::Node& node,
   pack(node, index);
 }
 
+auto hdf5_data_reader::load_samples(std::vector<size_t> indices)
+  -> sample_cache
+{
+  // Visit samples grouped by file, in the order they appear in the
+  // sample list (which follows the layout of each file), so that a
+  // file's handle is opened once and reused for all of its samples
+  sort_indices_by_file(indices);
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  sample_cache samples;
+  std::lock_guard<std::mutex> lock(hdf5_streaming_mutex);
+  for (const auto& index : indices) {
+    try {
+      load_sample(samples[index], index);
+    }
+    catch (conduit::Error const& e) {
+      LBANN_ERROR("trying to load the node ",
+                  index,
+                  " and caught conduit exception: ",
+                  e.what());
+    }
+  }
+  return samples;
+}
+
+std::vector<size_t> hdf5_data_reader::get_mini_batch_indices(int pos,
+                                                             int mb_size) const
+{
+  std::vector<size_t> indices;
+  indices.reserve(mb_size);
+  for (int s = 0; s < mb_size; ++s) {
+    const size_t n = pos + s * m_sample_stride;
+    if (n >= m_shuffled_indices.size()) {
+      break;
+    }
+    indices.push_back(m_shuffled_indices[n]);
+  }
+  return indices;
+}
+
+void hdf5_data_reader::discard_read_ahead()
+{
+  if (m_read_ahead.valid()) {
+    // Note: rethrows if the read-ahead thread failed; that is not
+    // of interest here, since its samples are not used
+    try {
+      m_read_ahead.get();
+    }
+    catch (...) {
+    }
+  }
+}
+
+int hdf5_data_reader::fetch(std::map<data_field_type, CPUMat*>& input_buffers,
+                            El::Matrix<El::Int>& indices_fetched,
+                            size_t mb_size)
+{
+  if (!m_streaming || !position_valid()) {
+    return data_reader_sample_list::fetch(input_buffers,
+                                          indices_fetched,
+                                          mb_size);
+  }
+
+  // Samples of the current mini-batch, in the same order as
+  // generic_data_reader::fetch_data_block visits them
+  const auto indices = get_mini_batch_indices(m_current_pos, mb_size);
+
+  // Use whatever the read-ahead thread loaded and read the rest. The
+  // prediction misses, e.g., on the first mini-batch of an epoch or
+  // if the mini-batch size changed.
+  m_streamed_samples.clear();
+  if (m_read_ahead.valid()) {
+    m_streamed_samples = m_read_ahead.get();
+  }
+  std::vector<size_t> missing;
+  for (const auto& index : indices) {
+    if (m_streamed_samples.count(index) == 0) {
+      missing.push_back(index);
+    }
+  }
+  if (!missing.empty()) {
+    m_streamed_samples.merge(load_samples(std::move(missing)));
+  }
+
+  // Read the next mini-batch while the current one is being consumed
+  const int next_pos = get_next_position();
+  if (next_pos < static_cast<int>(m_shuffled_indices.size())) {
+    const bool next_is_last = (m_loaded_mini_batch_idx + m_iteration_stride >=
+                               m_num_iterations_per_epoch - 1);
+    const int next_mb_size =
+      next_is_last ? m_last_mini_batch_size : m_mini_batch_size;
+    m_read_ahead = std::async(std::launch::async,
+                              &hdf5_data_reader::load_samples,
+                              this,
+                              get_mini_batch_indices(next_pos, next_mb_size));
+  }
+
+  return data_reader_sample_list::fetch(input_buffers,
+                                        indices_fetched,
+                                        mb_size);
+}
+
 void hdf5_data_reader::normalize(conduit::Node& node,
                                  const std::string& path,
                                  const conduit::Node& metadata)
@@ -1051,7 +1173,20 @@ const void* hdf5_data_reader::get_data(const size_t sample_id_in,
 {
 
   // get the pathname to the data, and verify it exists in the conduit::Node
-  const conduit::Node& node = get_data_store().get_conduit_node(sample_id_in);
+  const conduit::Node* node_ptr = nullptr;
+  if (m_streaming) {
+    auto it = m_streamed_samples.find(sample_id_in);
+    if (it == m_streamed_samples.end()) {
+      LBANN_ERROR("sample ",
+                  sample_id_in,
+                  " was not loaded for the current mini-batch");
+    }
+    node_ptr = &it->second;
+  }
+  else {
+    node_ptr = &get_data_store().get_conduit_node(sample_id_in);
+  }
+  const conduit::Node& node = *node_ptr;
   std::ostringstream ss;
   ss << node.child(0).name() + "/" << data_field;
   if (!node.has_path(ss.str())) {
@@ -810,9 +810,7 @@ void data_reader_jag_conduit::do_preload_data_store() {
     try {
       const sample_t& s = m_sample_list[index];
       const std::string& sample_name = s.second;
-      sample_file_id_t id = s.first;
-      m_sample_list.open_samples_file_handle(index);
-      auto h = m_sample_list.get_samples_file_handle(id);
+      auto h = m_sample_list.open_samples_file_handle(index);
       conduit::Node & node = m_data_store->get_empty_node(index);
 
       preload_helper(h, sample_name, m_output_scalar_prefix, index, node);
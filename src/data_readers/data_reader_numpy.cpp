@@ -30,7 +30,6 @@
 #include <cstdio>
 #include <string>
 #include <unordered_set>
-#include <cnpy.h>
 
 namespace lbann {
 
@@ -65,20 +64,20 @@ void numpy_reader::load() {
   }
   ifs.close();
 
-  m_data = cnpy::npy_load(infile);
-  m_num_samples = m_data.shape[0];
+  m_data = mapped_npy_array(infile);
+  m_num_samples = m_data.shape()[0];
   m_num_features = std::accumulate(
-    m_data.shape.begin() + 1, m_data.shape.end(), (unsigned) 1,
+    m_data.shape().begin() + 1, m_data.shape().end(), (unsigned) 1,
     std::multiplies<unsigned>());
 
   // Ensure we understand the word size.
-  if (!(m_data.word_size == 4 || m_data.word_size == 8)) {
+  if (!(m_data.word_size() == 4 || m_data.word_size() == 8)) {
     throw lbann_exception(
-      "numpy_reader: word size " + std::to_string(m_data.word_size) +
+      "numpy_reader: word size " + std::to_string(m_data.word_size()) +
       " not supported");
   }
   // Fortran order not yet supported.
-  if (m_data.fortran_order) {
+  if (m_data.fortran_order()) {
     throw lbann_exception(
       "numpy_reader: fortran order not supported");
   }
@@ -95,13 +94,8 @@ void numpy_reader::load() {
     // Determine number of label classes.
     std::unordered_set<int> label_classes;
     for (int i = 0; i < m_num_samples; ++i) {
-      if (m_data.word_size == 4) {
-        float *data = m_data.data<float>() + i*(m_num_features+1);
-        label_classes.insert((int) data[m_num_features+1]);
-      } else if (m_data.word_size == 8) {
-        double *data = m_data.data<double>() + i*(m_num_features+1);
-        label_classes.insert((int) data[m_num_features+1]);
-      }
+      label_classes.insert(
+        m_data.get<int>(i*(m_num_features+1) + m_num_features));
     }
     // Sanity checks.
     auto minmax = std::minmax_element(label_classes.begin(), label_classes.end());
@@ -134,17 +128,10 @@ bool numpy_reader::fetch_datum(Mat& X, int data_id, int mb_idx) {
       m_supported_input_types[INPUT_DATA_TYPE_RESPONSES]) {
     features_size += 1;
   }
-  if (m_data.word_size == 4) {
-    float *data = m_data.data<float>() + data_id * features_size;
-    for (int j = 0; j < m_num_features; ++j) {
-      X(j, mb_idx) = data[j];
-    }
-  } else if (m_data.word_size == 8) {
-    double *data = m_data.data<double>() + data_id * features_size;
-    for (int j = 0; j < m_num_features; ++j) {
-      X(j, mb_idx) = data[j];
-    }
-  }
+  // Sample entries are contiguous in the file and in the column of X.
+  m_data.read(static_cast<size_t>(data_id) * features_size,
+              m_num_features,
+              X.Buffer(0, mb_idx));
   return true;
 }
 
@@ -152,14 +139,8 @@ bool numpy_reader::fetch_label(Mat& Y, int data_id, int mb_idx) {
   if (!m_supported_input_types[INPUT_DATA_TYPE_LABELS]) {
     throw lbann_exception("numpy_reader: do not have labels");
   }
-  int label = 0;
-  if (m_data.word_size == 4) {
-    float *data = m_data.data<float>() + data_id*(m_num_features+1);
-    label = (int) data[m_num_features+1];
-  } else if (m_data.word_size == 8) {
-    double *data = m_data.data<double>() + data_id*(m_num_features+1);
-    label = (int) data[m_num_features+1];
-  }
+  const int label = m_data.get<int>(
+    static_cast<size_t>(data_id)*(m_num_features+1) + m_num_features);
   Y(label, mb_idx) = 1;
   return true;
 }
@@ -168,15 +149,8 @@ bool numpy_reader::fetch_response(Mat& Y, int data_id, int mb_idx) {
   if (!m_supported_input_types[INPUT_DATA_TYPE_RESPONSES]) {
     throw lbann_exception("numpy_reader: do not have responses");
   }
-  auto response = DataType(0);
-  if (m_data.word_size == 4) {
-    float *data = m_data.data<float>() + data_id*(m_num_features+1);
-    response = (DataType) data[m_num_features+1];
-  } else if (m_data.word_size == 8) {
-    double *data = m_data.data<double>() + data_id*(m_num_features+1);
-    response = (DataType) data[m_num_features+1];
-  }
-  Y(0, mb_idx) = response;
+  Y(0, mb_idx) = m_data.get<DataType>(
+    static_cast<size_t>(data_id)*(m_num_features+1) + m_num_features);
   return true;
 }
 
@@ -78,9 +78,7 @@ namespace lbann {
     }
     ifs.close();
 
-    const cnpy::npz_t npz = cnpy::npz_load(infile);
-
-    std::vector<std::tuple<const bool, const std::string, cnpy::NpyArray &> > npyLoadList;
+    std::vector<std::tuple<const bool, const std::string, mapped_npy_array &> > npyLoadList;
     npyLoadList.push_back(std::forward_as_tuple(true,            NPZ_KEY_DATA,      m_data));
     npyLoadList.push_back(
       std::forward_as_tuple(m_supported_input_types[INPUT_DATA_TYPE_LABELS],
@@ -98,10 +96,9 @@ namespace lbann {
 
       // Load the tensor.
       const std::string key = std::get<1>(npyLoad);
-      cnpy::NpyArray &ary = std::get<2>(npyLoad);
-      const auto i = npz.find(key);
-      if(i != npz.end()) {
-        ary = i->second;
+      mapped_npy_array &ary = std::get<2>(npyLoad);
+      if(mapped_npy_array::has_npz_member(infile, key)) {
+        ary = load_array(infile, key);
       } else {
         throw lbann_exception(std::string{} + __FILE__ + " " + std::to_string(__LINE__) +
                               " numpy_npz_reader::load() - can't find npz key : " + key);
@@ -109,41 +106,40 @@ namespace lbann {
 
       // Check whether the labels/responses has the same number of samples.
       if(key == NPZ_KEY_DATA) {
-        m_num_samples = m_data.shape[0];
-      } else if(m_num_samples != (int) ary.shape[0]) {
+        m_num_samples = m_data.shape()[0];
+      } else if(m_num_samples != (int) ary.shape()[0]) {
         throw lbann_exception(std::string{} + __FILE__ + " " + std::to_string(__LINE__) +
                               " numpy_npz_reader::load() - the number of samples of data and " + key + " do not match : "
-                              + std::to_string(m_num_samples) + " vs. " + std::to_string(ary.shape[0]));
+                              + std::to_string(m_num_samples) + " vs. " + std::to_string(ary.shape()[0]));
       }
     }
 
-    m_num_features = std::accumulate(m_data.shape.begin() + 1,
-                                     m_data.shape.end(),
+    m_num_features = std::accumulate(m_data.shape().begin() + 1,
+                                     m_data.shape().end(),
                                      (unsigned) 1,
                                      std::multiplies<unsigned>());
     if (m_supported_input_types[INPUT_DATA_TYPE_RESPONSES]) {
-      m_num_response_features = std::accumulate(m_responses.shape.begin() + 1,
-                                                m_responses.shape.end(),
+      m_num_response_features = std::accumulate(m_responses.shape().begin() + 1,
+                                                m_responses.shape().end(),
                                                 (unsigned) 1,
                                                 std::multiplies<unsigned>());
     }
 
     // Ensure we understand the word size.
-    if (!(m_data.word_size == 2 || m_data.word_size == 4 || m_data.word_size == 8)) {
-      throw lbann_exception("numpy_npz_reader: word size " + std::to_string(m_data.word_size) +
+    if (!(m_data.word_size() == 2 || m_data.word_size() == 4 || m_data.word_size() == 8)) {
+      throw lbann_exception("numpy_npz_reader: word size " + std::to_string(m_data.word_size()) +
                             " not supported");
     }
 
     if (m_supported_input_types[INPUT_DATA_TYPE_LABELS]) {
       // Determine number of label classes.
       std::unordered_set<int> label_classes;
-      if (m_labels.word_size != 4) {
+      if (m_labels.word_size() != 4) {
         throw lbann_exception("numpy_npz_reader: label numpy array should be in int32");
       }
-      int *data = m_labels.data<int>();
-      for (int i = 0; i < m_num_samples; ++i) {
-        label_classes.insert((int) data[i]);
-      }
+      std::vector<int> data(m_num_samples);
+      m_labels.read(0, m_num_samples, data.data());
+      label_classes.insert(data.begin(), data.end());
 
       // Sanity checks.
       auto minmax = std::minmax_element(label_classes.begin(), label_classes.end());
@@ -165,26 +161,16 @@ namespace lbann {
   }
 
   bool numpy_npz_reader::fetch_datum(Mat& X, int data_id, int mb_idx) {
-    Mat X_v = El::View(X, El::IR(0, X.Height()), El::IR(mb_idx, mb_idx+1));
-
-    if (m_data.word_size == 2) {
-      // Convert int16 to DataType.
-      const short *data = m_data.data<short>() + data_id * m_num_features;
-      DataType *dest = X_v.Buffer();
-
-      // OPTIMIZE
-      LBANN_OMP_PARALLEL_FOR
-        for(int j = 0; j < m_num_features; j++)
-          dest[j] = data[j] * m_scaling_factor_int16;
-
-    } else {
-      void *data = NULL;
-      if (m_data.word_size == 4) {
-        data = (void *) (m_data.data<float>() + data_id * m_num_features);
-      } else if (m_data.word_size == 8) {
-        data = (void *) (m_data.data<double>() + data_id * m_num_features);
-      }
-      std::memcpy(X_v.Buffer(), data, m_num_features * m_data.word_size);
+    // Sample entries are contiguous in the file and in the column of X.
+    DataType *dest = X.Buffer(0, mb_idx);
+    m_data.read(static_cast<size_t>(data_id) * m_num_features,
+                m_num_features,
+                dest);
+
+    if (m_data.word_size() == 2) {
+      // Scale int16 data.
+      for(int j = 0; j < m_num_features; j++)
+        dest[j] *= m_scaling_factor_int16;
     }
     return true;
   }
@@ -193,7 +179,7 @@ namespace lbann {
     if (!m_supported_input_types[INPUT_DATA_TYPE_LABELS]) {
       throw lbann_exception("numpy_npz_reader: do not have labels");
     }
-    const int label = m_labels.data<int>()[data_id];
+    const int label = m_labels.get<int>(data_id);
     Y(label, mb_idx) = 1;
     return true;
   }
@@ -202,30 +188,28 @@ namespace lbann {
     if (!m_supported_input_types[INPUT_DATA_TYPE_RESPONSES]) {
       throw lbann_exception("numpy_npz_reader: do not have responses");
     }
+    m_responses.read(static_cast<size_t>(data_id) * m_num_response_features,
+                     m_num_response_features,
+                     Y.Buffer(0, mb_idx));
+    return true;
+  }
 
-    Mat Y_v = El::View(Y, El::IR(0, Y.Height()), El::IR(mb_idx, mb_idx + 1));
-    if(m_responses.word_size == 2) {
-      // Convert int16 to DataType.
-      const short *data = m_responses.data<short>() + data_id * m_num_response_features;
-      DataType *dest = Y_v.Buffer();
-      // OPTIMIZE
-      LBANN_OMP_PARALLEL_FOR
-        for(int j = 0; j < m_num_response_features; j++)
-          dest[j] = data[j];
-      return true;
+  mapped_npy_array numpy_npz_reader::load_array(const std::string& filename,
+                                                const std::string& key) {
+    if (mapped_npy_array::is_npz_member_mappable(filename, key)) {
+      return mapped_npy_array(filename, key);
     }
 
-    void *responses = NULL;
-    if (m_responses.word_size == 4) {
-      responses = (void *) (m_responses.data<float>()
-                            + data_id * m_num_response_features);
-    } else if (m_responses.word_size == 8) {
-      responses = (void *) (m_responses.data<double>()
-                            + data_id * m_num_response_features);
-    }
-    std::memcpy(Y_v.Buffer(), responses,
-                m_num_response_features * m_responses.word_size);
-    return true;
+    // Compressed arrays are decompressed into memory.
+    // Note: cnpy does not report the element type, so int16 is
+    // assumed for 2-byte entries, int32 for labels, and floating
+    // point otherwise.
+    cnpy::NpyArray ary = cnpy::npz_load(filename, key);
+    const char type_code = ((ary.word_size == 2 || key == NPZ_KEY_LABELS)
+                            ? 'i' : 'f');
+    std::shared_ptr<const char> data(ary.data_holder,
+                                     ary.data_holder->data());
+    return mapped_npy_array(ary.shape, type_code, ary.word_size, data);
   }
 
 }  // namespace lbann
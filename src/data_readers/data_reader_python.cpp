@@ -40,8 +40,19 @@ python_reader::python_reader(std::string module,
                              std::string sample_function,
                              std::string num_samples_function,
                              std::string sample_dims_function,
-                             bool shuffle)
-  : generic_data_reader(shuffle) {
+                             bool shuffle,
+                             std::string label_function,
+                             El::Int num_labels,
+                             std::string response_function,
+                             El::Int num_responses,
+                             El::Int num_prefetch_batches)
+  : generic_data_reader(shuffle),
+    m_num_prefetch_batches(num_prefetch_batches) {
+
+  if (m_num_prefetch_batches < 0) {
+    LBANN_ERROR("Python data reader got invalid number of prefetched "
+                "mini-batches (", m_num_prefetch_batches, ")");
+  }
 
   // Make sure Python is running and acquire GIL
   python::global_interpreter_lock gil;
@@ -76,11 +87,38 @@ python_reader::python_reader(std::string module,
   m_sample_function = PyObject_GetAttrString(data_module,
                                              sample_function.c_str());
 
+  // Get optional label access function
+  if (!label_function.empty()) {
+    if (num_labels <= 0) {
+      LBANN_ERROR("Python data reader has label function ",
+                  "\"", label_function, "\", ",
+                  "but invalid number of labels (", num_labels, ")");
+    }
+    m_label_function = PyObject_GetAttrString(data_module,
+                                              label_function.c_str());
+    m_num_labels = num_labels;
+    set_has_labels(true);
+  }
+
+  // Get optional response access function
+  if (!response_function.empty()) {
+    if (num_responses <= 0) {
+      LBANN_ERROR("Python data reader has response function ",
+                  "\"", response_function, "\", ",
+                  "but invalid number of responses (", num_responses, ")");
+    }
+    m_response_function = PyObject_GetAttrString(data_module,
+                                                 response_function.c_str());
+    m_num_responses = num_responses;
+    set_has_responses(true);
+  }
+
 }
 
 python_reader::~python_reader() {
   if (python::is_active() && m_process_pool != nullptr) {
     python::global_interpreter_lock gil;
+    m_pending_mini_batches.clear();
     PyObject_CallMethod(m_process_pool, "terminate", nullptr);
     PyObject_CallMethod(m_process_pool, "join", nullptr);
   }
@@ -94,7 +132,7 @@ const std::vector<int> python_reader::get_data_dims() const {
   return dims;
 }
 int python_reader::get_num_labels() const {
-  return 1;
+  return m_num_labels > 0 ? m_num_labels : 1;
 }
 int python_reader::get_linearized_data_size() const {
   const auto& dims = get_data_dims();
@@ -104,6 +142,124 @@ int python_reader::get_linearized_data_size() const {
 int python_reader::get_linearized_label_size() const {
   return get_num_labels();
 }
+int python_reader::get_num_responses() const {
+  return m_num_responses > 0 ? m_num_responses : 1;
+}
+int python_reader::get_linearized_response_size() const {
+  return get_num_responses();
+}
+
+namespace {
+
+/** @brief Point matrix at a mini-batch slot in shared memory.
+ *
+ *  The matrix becomes a view if the mini-batch fills the slot. The
+ *  data coordinator only ever shrinks the matrix afterwards, which
+ *  views support. Partial mini-batches are copied into memory owned
+ *  by the matrix so that it can grow again for the next epoch.
+ */
+void attach_to_slot(CPUMat& mat,
+                    DataType* slot_ptr,
+                    El::Int height,
+                    El::Int width,
+                    El::Int slot_size) {
+  if (width == slot_size) {
+    mat.Attach(height, width, slot_ptr, height);
+  }
+  else {
+    CPUMat shared_memory_matrix(height, width, slot_ptr, height);
+    if (mat.Viewing()) {
+      mat.Empty();
+    }
+    El::Copy(shared_memory_matrix, mat);
+  }
+}
+
+} // namespace
+
+std::vector<El::Int> python_reader::get_mini_batch_indices(
+  El::Int pos,
+  El::Int mb_size) const {
+  std::vector<El::Int> indices;
+  const El::Int num_indices = m_shuffled_indices.size();
+  for (El::Int i = 0; i < mb_size; ++i) {
+    const El::Int index_pos = pos + i * m_sample_stride;
+    if (index_pos >= num_indices) { break; }
+    indices.push_back(m_shuffled_indices[index_pos]);
+  }
+  return indices;
+}
+
+python::object python_reader::launch_mini_batch(
+  El::Int slot,
+  const std::vector<El::Int>& indices) {
+
+  // Get arguments for sample access function
+  python::object args_list = PyList_New(0);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const El::Int column = slot * m_slot_size + i;
+    PyList_Append(args_list,
+                  python::object(Py_BuildValue("(l,l)",
+                                               indices[i],
+                                               column)));
+  }
+
+  // Get samples asynchronously using Python process pool
+  return PyObject_CallMethod(m_process_pool,
+                             "starmap_async",
+                             "(O,O)",
+                             m_sample_function_wrapper.get(),
+                             args_list.get());
+
+}
+
+El::Int python_reader::get_free_slot(El::Int current_slot) const {
+  for (El::Int slot = 0; slot < m_num_slots; ++slot) {
+    if (slot == current_slot || slot == m_last_slot) { continue; }
+    const bool is_pending = std::any_of(
+      m_pending_mini_batches.begin(),
+      m_pending_mini_batches.end(),
+      [slot](const pending_mini_batch& b) { return b.slot == slot; });
+    if (!is_pending) { return slot; }
+  }
+  return -1;
+}
+
+void python_reader::prefetch_mini_batches(El::Int current_slot) {
+
+  // Predict positions of upcoming mini-batches in the current epoch
+  // Note: Predictions may be wrong, e.g. if the mini-batch size
+  // changes. Mismatches are detected when the mini-batch is fetched.
+  const El::Int num_indices = m_shuffled_indices.size();
+  const El::Int loaded_mb_size = get_loaded_mini_batch_size();
+  for (El::Int step = m_pending_mini_batches.size() + 1;
+       step <= m_num_prefetch_batches;
+       ++step) {
+    const El::Int pos = m_current_pos + step * m_stride_to_next_mini_batch;
+    if (pos >= num_indices) { break; }
+    const El::Int end_pos = std::min(pos + loaded_mb_size, num_indices);
+    const El::Int mb_size
+      = std::min(((end_pos - pos) + m_sample_stride - 1) / m_sample_stride,
+                 m_slot_size);
+    const El::Int slot = get_free_slot(current_slot);
+    if (slot < 0) { break; }
+    auto indices = get_mini_batch_indices(pos, mb_size);
+    auto result = launch_mini_batch(slot, indices);
+    m_pending_mini_batches.push_back({slot,
+                                      std::move(indices),
+                                      std::move(result)});
+  }
+
+}
+
+void python_reader::discard_pending_mini_batches() {
+  // Note: Workers may still be writing into the slots, so we wait
+  // for them to finish before the slots can be reused.
+  for (auto& batch : m_pending_mini_batches) {
+    python::object(PyObject_CallMethod(batch.result, "wait", nullptr));
+  }
+  m_pending_mini_batches.clear();
+}
 
 bool python_reader::fetch_data_block(
   std::map<data_field_type, CPUMat*>& input_buffers,
@@ -113,54 +269,85 @@ bool python_reader::fetch_data_block(
   El::Matrix<El::Int>& indices_fetched)
 {
 
-  CPUMat& X = *(input_buffers[INPUT_DATA_TYPE_SAMPLES]);
   // Acquire Python GIL on first IO thread
   // Note: Do nothing on other IO threads.
   if (block_offset != 0) { return true; }
   python::global_interpreter_lock gil;
 
-  // Check that shared memory array is large enough
-  const El::Int sample_size = get_linearized_data_size();
-  const El::Int array_size = PyObject_Length(m_shared_memory_array);
-  if (array_size < sample_size * mb_size) {
-    std::stringstream err;
-    err << "Python data reader attempted to load "
-        << sample_size * mb_size * sizeof(DataType) << " B "
-        << "into shared memory array, but only "
-        << array_size * sizeof(DataType) << " B is available";
-    LBANN_ERROR(err.str());
+  // Check that shared memory slots are large enough
+  if (mb_size > m_slot_size) {
+    LBANN_ERROR("Python data reader attempted to load ", mb_size, " ",
+                "samples into shared memory, but slots only hold ",
+                m_slot_size, " samples");
   }
 
-  // Get arguments for sample access function
-  python::object args_list = PyList_New(0);
+  // Sample indices for current mini-batch
+  const auto indices = get_mini_batch_indices(m_current_pos, mb_size);
   for (El::Int i = 0; i < mb_size; ++i) {
-    El::Int sample_index = m_shuffled_indices[m_current_pos + i * m_sample_stride];
-    El::Int array_offset = sample_size * i;
-    PyList_Append(args_list,
-                  python::object(Py_BuildValue("(l,l)",
-                                               sample_index,
-                                               array_offset)));
-    indices_fetched.Set(i, 0, sample_index);
+    indices_fetched.Set(i, 0, indices[i]);
   }
 
-  // Get samples using Python process pool
-  python::object samples = PyObject_CallMethod(m_process_pool,
-                                               "starmap",
-                                               "(O,O)",
-                                               m_sample_function_wrapper.get(),
-                                               args_list.get());
+  // Use prefetched mini-batch if it matches, otherwise discard
+  // prefetched mini-batches and request the current one
+  El::Int slot = -1;
+  python::object result;
+  if (!m_pending_mini_batches.empty()
+      && m_pending_mini_batches.front().indices == indices) {
+    slot = m_pending_mini_batches.front().slot;
+    result = m_pending_mini_batches.front().result;
+    m_pending_mini_batches.pop_front();
+  }
+  else {
+    discard_pending_mini_batches();
+    slot = get_free_slot(-1);
+    result = launch_mini_batch(slot, indices);
+  }
+
+  // Request upcoming mini-batches so that workers stay busy while
+  // the model is computing
+  prefetch_mini_batches(slot);
 
-  // Copy data from shared memory to output matrix
-  CPUMat shared_memory_matrix(sample_size,
-                              mb_size,
-                              m_shared_memory_array_ptr,
-                              sample_size);
-  El::Copy(shared_memory_matrix, X);
+  // Wait for current mini-batch
+  // Note: AsyncResult.get reraises exceptions from worker processes.
+  python::object(PyObject_CallMethod(result, "get", nullptr));
+  m_last_slot = slot;
+
+  // Hand over data in shared memory
+  const El::Int sample_size = get_linearized_data_size();
+  attach_to_slot(*input_buffers[INPUT_DATA_TYPE_SAMPLES],
+                 m_shared_memory_array_ptr + slot * m_slot_size * sample_size,
+                 sample_size,
+                 mb_size,
+                 m_slot_size);
+  if (m_label_function != nullptr
+      && input_buffers.count(INPUT_DATA_TYPE_LABELS) > 0) {
+    attach_to_slot(*input_buffers[INPUT_DATA_TYPE_LABELS],
+                   (m_shared_label_array_ptr
+                    + slot * m_slot_size * m_num_labels),
+                   m_num_labels,
+                   mb_size,
+                   m_slot_size);
+  }
+  if (m_response_function != nullptr
+      && input_buffers.count(INPUT_DATA_TYPE_RESPONSES) > 0) {
+    attach_to_slot(*input_buffers[INPUT_DATA_TYPE_RESPONSES],
+                   (m_shared_response_array_ptr
+                    + slot * m_slot_size * m_num_responses),
+                   m_num_responses,
+                   mb_size,
+                   m_slot_size);
+  }
 
   return true;
 }
 
 bool python_reader::fetch_label(CPUMat& Y, int data_id, int col) {
+  // Labels are written to shared memory in fetch_data_block
+  return true;
+}
+
+bool python_reader::fetch_response(CPUMat& Y, int data_id, int col) {
+  // Responses are written to shared memory in fetch_data_block
   return true;
 }
 
@@ -178,16 +365,19 @@ void python_reader::setup(int num_io_threads,
     = PyImport_ImportModule("multiprocessing");
 
   // Stop process pool if needed
+  m_pending_mini_batches.clear();
+  m_last_slot = -1;
   if (m_process_pool != nullptr) {
     PyObject_CallMethod(m_process_pool, "terminate", nullptr);
     m_process_pool = nullptr;
   }
 
-  // Allocate shared memory array
+  // Allocate shared memory arrays
+  // Note: Each array is partitioned into mini-batch slots.
   /// @todo Figure out more robust way to get max mini-batch size
   const El::Int sample_size = get_linearized_data_size();
-  const El::Int mini_batch_size
-    = get_trainer().get_max_mini_batch_size();
+  m_slot_size = get_trainer().get_max_mini_batch_size();
+  m_num_slots = m_num_prefetch_batches + 2;
   std::string datatype_typecode;
   switch (sizeof(DataType)) {
   case 4: datatype_typecode = "f"; break;
@@ -195,40 +385,63 @@ void python_reader::setup(int num_io_threads,
   default: LBANN_ERROR("invalid data type for Python data reader "
                        "(only float and double are supported)");
   }
-  m_shared_memory_array
-    = PyObject_CallMethod(multiprocessing_module,
-                          "RawArray",
-                          "(s, l)",
-                          datatype_typecode.c_str(),
-                          sample_size * mini_batch_size);
-
-  // Get address of shared memory buffer
-  python::object shared_memory_ptr
-    = PyObject_CallMethod(ctypes_module,
-                          "addressof",
-                          "(O)",
-                          m_shared_memory_array.get());
-  m_shared_memory_array_ptr
-    = reinterpret_cast<DataType*>(PyLong_AsLong(shared_memory_ptr));
+  auto make_shared_array = [&](El::Int size, DataType*& ptr) {
+    python::object array
+      = PyObject_CallMethod(multiprocessing_module,
+                            "RawArray",
+                            "(s, l)",
+                            datatype_typecode.c_str(),
+                            size * m_slot_size * m_num_slots);
+    python::object array_ptr
+      = PyObject_CallMethod(ctypes_module,
+                            "addressof",
+                            "(O)",
+                            array.get());
+    ptr = reinterpret_cast<DataType*>(PyLong_AsLong(array_ptr));
+    return array;
+  };
+  m_shared_memory_array = make_shared_array(sample_size,
+                                            m_shared_memory_array_ptr);
+  if (m_label_function != nullptr) {
+    m_shared_label_array = make_shared_array(m_num_labels,
+                                             m_shared_label_array_ptr);
+  }
+  if (m_response_function != nullptr) {
+    m_shared_response_array = make_shared_array(m_num_responses,
+                                                m_shared_response_array_ptr);
+  }
 
   // Create global variables in Python
   // Note: The static counter makes sure variable names are unique.
+  // Optional functions and arrays are set to None.
   static El::Int instance_id = 0;
   instance_id++;
+  auto set_global = [&](const std::string& prefix, PyObject* val) {
+    const std::string name = prefix + std::to_string(instance_id);
+    PyObject_SetAttrString(main_module,
+                           name.c_str(),
+                           val != nullptr ? val : Py_None);
+    python::check_error();
+    return name;
+  };
   const std::string sample_func_name
-    = ("_DATA_READER_PYTHON_CPP_sample_function_wrapper"
-       + std::to_string(instance_id));
-  PyObject_SetAttrString(main_module,
-                         sample_func_name.c_str(),
-                         m_sample_function);
-  python::check_error();
+    = set_global("_DATA_READER_PYTHON_CPP_sample_function_wrapper",
+                 m_sample_function);
+  const std::string label_func_name
+    = set_global("_DATA_READER_PYTHON_CPP_label_function",
+                 m_label_function);
+  const std::string response_func_name
+    = set_global("_DATA_READER_PYTHON_CPP_response_function",
+                 m_response_function);
   const std::string shared_array_name
-    = ("_DATA_READER_PYTHON_CPP_shared_memory_array"
-       + std::to_string(instance_id));
-  PyObject_SetAttrString(main_module,
-                         shared_array_name.c_str(),
-                         m_shared_memory_array);
-  python::check_error();
+    = set_global("_DATA_READER_PYTHON_CPP_shared_memory_array",
+                 m_shared_memory_array);
+  const std::string label_array_name
+    = set_global("_DATA_READER_PYTHON_CPP_shared_label_array",
+                 m_shared_label_array);
+  const std::string response_array_name
+    = set_global("_DATA_READER_PYTHON_CPP_shared_response_array",
+                 m_shared_response_array);
 
   // Create wrapper around sample function
   // Note: We attempt accessing the sample with the buffer protocol
@@ -238,14 +451,13 @@ void python_reader::setup(int num_io_threads,
   const std::string wrapper_func_name
     = ("_DATA_READER_PYTHON_CPP_sample_function"
        + std::to_string(instance_id));
+  const std::string copy_func_name
+    = ("_DATA_READER_PYTHON_CPP_copy_function"
+       + std::to_string(instance_id));
   std::string wrapper_func_def = R"(
-def @wrapper_func@(sample_index, array_offset):
-    """Get data sample and copy to shared memory array."""
-
-    # Get sample
-    sample = @sample_func@(sample_index)
+def @copy_func@(values, array, offset, size):
+    """Copy entries into shared memory array."""
 
-    # Copy entries from sample to shared memory array
     # Note: We attempt to copy via the buffer protocol since it is
     # much more efficient than naively looping through the arrays.
     try:
@@ -253,30 +465,61 @@ def @wrapper_func@(sample_index, array_offset):
         # memoryview copies only work when the endianness is
         # explicitly set to the system default. We need to do some
         # type casting to get around this excessive error checking.
-        input_buffer = memoryview(sample)
-        output_buffer = memoryview(@shared_array@)
-        output_buffer = output_buffer[array_offset:array_offset+@sample_size@]
+        input_buffer = memoryview(values)
+        output_buffer = memoryview(array)
+        output_buffer = output_buffer[offset:offset+size]
         output_buffer = output_buffer.cast('B').cast('@datatype_typecode@')
         output_buffer[:] = input_buffer
     except:
-        for i, val in enumerate(sample):
-            @shared_array@[i + array_offset] = val
+        for i, val in enumerate(values):
+            array[i + offset] = val
+
+def @wrapper_func@(sample_index, column):
+    """Get data sample and copy to shared memory arrays.
+
+    The column is the mini-batch slot offset plus the position of the
+    sample within the mini-batch.
+
+    """
+
+    # Copy sample
+    @copy_func@(@sample_func@(sample_index),
+                @shared_array@,
+                column * @sample_size@,
+                @sample_size@)
+
+    # Write one-hot label
+    if @label_func@ is not None:
+        offset = column * @num_labels@
+        for i in range(@num_labels@):
+            @label_array@[offset + i] = 0
+        @label_array@[offset + int(@label_func@(sample_index))] = 1
+
+    # Copy responses
+    if @response_func@ is not None:
+        @copy_func@(@response_func@(sample_index),
+                    @response_array@,
+                    column * @num_responses@,
+                    @num_responses@)
 )";
-  wrapper_func_def = std::regex_replace(wrapper_func_def,
-                                        std::regex("\\@wrapper_func\\@"),
-                                        wrapper_func_name);
-  wrapper_func_def = std::regex_replace(wrapper_func_def,
-                                        std::regex("\\@sample_func\\@"),
-                                        sample_func_name);
-  wrapper_func_def = std::regex_replace(wrapper_func_def,
-                                        std::regex("\\@shared_array\\@"),
-                                        shared_array_name);
-  wrapper_func_def = std::regex_replace(wrapper_func_def,
-                                        std::regex("\\@sample_size\\@"),
-                                        std::to_string(sample_size));
-  wrapper_func_def = std::regex_replace(wrapper_func_def,
-                                        std::regex("\\@datatype_typecode\\@"),
-                                        datatype_typecode);
+  const std::vector<std::pair<std::string, std::string>> replacements = {
+    {"wrapper_func", wrapper_func_name},
+    {"copy_func", copy_func_name},
+    {"sample_func", sample_func_name},
+    {"label_func", label_func_name},
+    {"response_func", response_func_name},
+    {"shared_array", shared_array_name},
+    {"label_array", label_array_name},
+    {"response_array", response_array_name},
+    {"sample_size", std::to_string(sample_size)},
+    {"num_labels", std::to_string(m_num_labels)},
+    {"num_responses", std::to_string(m_num_responses)},
+    {"datatype_typecode", datatype_typecode}};
+  for (const auto& r : replacements) {
+    wrapper_func_def = std::regex_replace(wrapper_func_def,
+                                          std::regex("\\@" + r.first + "\\@"),
+                                          r.second);
+  }
   PyRun_SimpleString(wrapper_func_def.c_str());
   python::check_error();
   m_sample_function_wrapper
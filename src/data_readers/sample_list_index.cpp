@@ -0,0 +1,372 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/data_readers/sample_list_index.hpp"
+#include "lbann/data_readers/sample_list_impl.hpp" // sample_list_header
+#include "lbann/utils/exception.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lbann {
+
+namespace {
+
+/** @brief Read a trivially copyable object from possibly unaligned memory. */
+template <typename T>
+T read_record(const char* ptr) {
+  T val;
+  std::memcpy(&val, ptr, sizeof(T));
+  return val;
+}
+
+/** @brief Map file into memory with read-only access.
+ *
+ *  The mapping is released when the last reference is destroyed.
+ */
+std::shared_ptr<const char> map_file(const std::string& filename,
+                                     size_t& size) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    LBANN_ERROR("failed to open ", filename, " (", std::strerror(errno), ")");
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    close(fd);
+    LBANN_ERROR("failed to get size of ", filename);
+  }
+  size = file_stat.st_size;
+  void* ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    LBANN_ERROR("failed to mmap ", filename, " (", std::strerror(errno), ")");
+  }
+  return std::shared_ptr<const char>(
+    static_cast<const char*>(ptr),
+    [size](const char* p) { munmap(const_cast<char*>(p), size); });
+}
+
+/** @brief Read a non-empty header line of a text sample list. */
+std::string read_header_line(std::istream& istrm, const std::string& info) {
+  std::string line;
+  if (!std::getline(istrm, line) || line.empty()) {
+    LBANN_ERROR("unable to read the header line of the sample list for ",
+                info);
+  }
+  return line;
+}
+
+/** @brief Accumulates the tables of an index before it is written. */
+class index_builder {
+public:
+  sample_list_index::string_ref add_string(const std::string& str) {
+    sample_list_index::string_ref ref{m_strings.size(), str.size()};
+    m_strings += str;
+    return ref;
+  }
+
+  void add_file(const std::string& filename,
+                const std::vector<std::string>& sample_names,
+                size_t num_samples_in_file) {
+    sample_list_index::file_record file;
+    file.name = add_string(filename);
+    file.first_sample = m_samples.size();
+    file.num_samples = sample_names.size();
+    file.num_samples_in_file = num_samples_in_file;
+    m_files.push_back(file);
+    for (const auto& name : sample_names) {
+      m_samples.push_back({add_string(name)});
+    }
+  }
+
+  size_t get_num_samples() const { return m_samples.size(); }
+
+  void write(const std::string& filename,
+             sample_list_index::header_t header) const {
+    header.num_files = m_files.size();
+    header.num_samples = m_samples.size();
+    header.file_table_offset = sizeof(header);
+    header.sample_table_offset =
+      header.file_table_offset
+      + m_files.size() * sizeof(sample_list_index::file_record);
+    header.string_table_offset =
+      header.sample_table_offset
+      + m_samples.size() * sizeof(sample_list_index::sample_record);
+    header.string_table_size = m_strings.size();
+
+    std::ofstream ofs(filename, std::ios::out | std::ios::binary);
+    if (!ofs.good()) {
+      LBANN_ERROR("unable to open ", filename, " for writing");
+    }
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char*>(m_files.data()),
+              m_files.size() * sizeof(sample_list_index::file_record));
+    ofs.write(reinterpret_cast<const char*>(m_samples.data()),
+              m_samples.size() * sizeof(sample_list_index::sample_record));
+    ofs.write(m_strings.data(), m_strings.size());
+    if (!ofs.good()) {
+      LBANN_ERROR("failed to write ", filename);
+    }
+  }
+
+private:
+  std::vector<sample_list_index::file_record> m_files;
+  std::vector<sample_list_index::sample_record> m_samples;
+  std::string m_strings;
+};
+
+/** @brief Parse the sample names of an inclusive list line.
+ *
+ *  Expands the "a ... b" range encoding that is written for integer
+ *  sample names.
+ */
+std::vector<std::string> read_sample_names(std::istringstream& sstr,
+                                           const std::string& filename) {
+  std::vector<std::string> names;
+  std::string name;
+  bool in_range = false;
+  while (sstr >> name) {
+    if (name == "...") {
+      if (in_range || names.empty()) {
+        LBANN_ERROR("misplaced range operator in the entry of ", filename);
+      }
+      in_range = true;
+      continue;
+    }
+    if (in_range) {
+      try {
+        const long long range_start = std::stoll(names.back());
+        const long long range_end = std::stoll(name);
+        for (long long i = range_start + 1; i < range_end; ++i) {
+          names.emplace_back(std::to_string(i));
+        }
+      }
+      catch (const std::logic_error&) {
+        LBANN_ERROR("range operator in the entry of ", filename,
+                    " requires integer sample names");
+      }
+      in_range = false;
+    }
+    names.emplace_back(name);
+  }
+  if (in_range) {
+    LBANN_ERROR("the entry of ", filename,
+                " terminated while in a range operator");
+  }
+  return names;
+}
+
+} // namespace
+
+bool sample_list_index::is_index_file(const std::string& filename) {
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  char buf[sizeof(magic)];
+  if (!ifs.read(buf, sizeof(buf))) {
+    return false;
+  }
+  return std::memcmp(buf, magic, sizeof(magic)) == 0;
+}
+
+sample_list_index::sample_list_index(const std::string& filename) {
+  m_data = map_file(filename, m_size);
+  if (m_size < sizeof(header_t)) {
+    LBANN_ERROR(filename, " is too small to be a sample list index");
+  }
+  m_header = read_record<header_t>(m_data.get());
+  if (std::memcmp(m_header.magic, magic, sizeof(magic)) != 0) {
+    LBANN_ERROR(filename, " is not a sample list index");
+  }
+  if (m_header.version != version) {
+    LBANN_ERROR("sample list index ", filename, " has version ",
+                m_header.version, ", but version ", version, " is expected");
+  }
+  const bool tables_fit =
+    m_header.file_table_offset
+      + m_header.num_files * sizeof(file_record) <= m_size
+    && m_header.sample_table_offset
+      + m_header.num_samples * sizeof(sample_record) <= m_size
+    && m_header.string_table_offset + m_header.string_table_size <= m_size;
+  if (!tables_fit) {
+    LBANN_ERROR("sample list index ", filename, " is truncated");
+  }
+}
+
+bool sample_list_index::is_multi_sample() const {
+  return (m_header.flags & flag_multi_sample) != 0;
+}
+
+bool sample_list_index::use_label_header() const {
+  return (m_header.flags & flag_no_label_header) == 0;
+}
+
+bool sample_list_index::has_unused_sample_fields() const {
+  return (m_header.flags & flag_has_unused_sample_fields) != 0;
+}
+
+size_t sample_list_index::get_num_files() const {
+  return m_header.num_files;
+}
+
+size_t sample_list_index::get_num_samples() const {
+  return m_header.num_samples;
+}
+
+size_t sample_list_index::get_num_excluded_samples() const {
+  return m_header.num_excluded_samples;
+}
+
+std::string_view sample_list_index::get_file_dir() const {
+  return get_string(m_header.file_dir);
+}
+
+std::string_view sample_list_index::get_label_filename() const {
+  return get_string(m_header.label_filename);
+}
+
+sample_list_index::file_record sample_list_index::get_file(size_t i) const {
+  if (i >= m_header.num_files) {
+    LBANN_ERROR("file ", i, " is out of range of the sample list index (",
+                m_header.num_files, " files)");
+  }
+  const auto file = read_record<file_record>(
+    m_data.get() + m_header.file_table_offset + i * sizeof(file_record));
+  if (file.first_sample + file.num_samples > m_header.num_samples) {
+    LBANN_ERROR("samples of file ", i, " are out of range of the "
+                "sample list index");
+  }
+  return file;
+}
+
+std::string_view sample_list_index::get_file_name(size_t i) const {
+  return get_string(get_file(i).name);
+}
+
+std::string_view sample_list_index::get_sample_name(size_t i) const {
+  if (i >= m_header.num_samples) {
+    LBANN_ERROR("sample ", i, " is out of range of the sample list index (",
+                m_header.num_samples, " samples)");
+  }
+  const auto sample = read_record<sample_record>(
+    m_data.get() + m_header.sample_table_offset + i * sizeof(sample_record));
+  return get_string(sample.name);
+}
+
+std::string_view sample_list_index::get_string(const string_ref& ref) const {
+  if (ref.offset + ref.length > m_header.string_table_size) {
+    LBANN_ERROR("string is out of range of the sample list index");
+  }
+  return std::string_view(m_data.get() + m_header.string_table_offset
+                            + ref.offset,
+                          ref.length);
+}
+
+void sample_list_index::convert(std::istream& text_list,
+                                const std::string& index_filename) {
+  sample_list_header list_header;
+  list_header.set_sample_list_type(
+    read_header_line(text_list, "the exclusiveness"));
+  list_header.set_sample_count(
+    read_header_line(text_list, "the number of samples and the number of files"));
+  list_header.set_data_file_dir(
+    read_header_line(text_list, "the data file directory"));
+  if (list_header.use_label_header()) {
+    list_header.set_label_filename(
+      read_header_line(text_list, "the path to label/response file"));
+  }
+  if (list_header.is_exclusive()) {
+    LBANN_ERROR("exclusive sample lists cannot be indexed; "
+                "the data files must be opened to enumerate their samples");
+  }
+
+  index_builder builder;
+  header_t header{};
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.flags = (list_header.is_multi_sample() ? flag_multi_sample : 0)
+    | (list_header.use_label_header() ? 0 : flag_no_label_header)
+    | (list_header.has_unused_sample_fields()
+         ? flag_has_unused_sample_fields : 0);
+  header.file_dir = builder.add_string(list_header.get_file_dir());
+  header.label_filename = builder.add_string(list_header.get_label_filename());
+
+  const std::string whitespaces(" \t\f\v\n\r");
+  size_t cnt_files = 0u;
+  size_t num_excluded = 0u;
+  std::string line;
+  while (cnt_files < list_header.get_num_files()
+         && std::getline(text_list, line)) {
+    const size_t end_of_str = line.find_last_not_of(whitespaces);
+    if (end_of_str == std::string::npos) { // empty line
+      continue;
+    }
+    ++cnt_files;
+    std::istringstream sstr(line.substr(0, end_of_str + 1));
+    std::string filename;
+    sstr >> filename;
+
+    if (!list_header.is_multi_sample()) {
+      builder.add_file(filename, {std::string{}}, 1u);
+      continue;
+    }
+
+    size_t included_samples = 0u;
+    size_t excluded_samples = 0u;
+    sstr >> included_samples;
+    if (list_header.has_unused_sample_fields()) {
+      sstr >> excluded_samples;
+    }
+    const auto names = read_sample_names(sstr, filename);
+    if (names.size() != included_samples) {
+      LBANN_ERROR("the entry of ", filename, " lists ", names.size(),
+                  " samples, but ", included_samples, " are expected");
+    }
+    builder.add_file(filename, names, included_samples + excluded_samples);
+    num_excluded += excluded_samples;
+  }
+
+  if (cnt_files != list_header.get_num_files()) {
+    LBANN_ERROR("sample list number of files requested ",
+                list_header.get_num_files(),
+                " does not equal number of files read ", cnt_files);
+  }
+  if (builder.get_num_samples() != list_header.get_sample_count()) {
+    LBANN_ERROR("sample list count ", list_header.get_sample_count(),
+                " does not equal the number of samples read ",
+                builder.get_num_samples());
+  }
+  header.num_excluded_samples = num_excluded;
+  builder.write(index_filename, header);
+}
+
+} // namespace lbann
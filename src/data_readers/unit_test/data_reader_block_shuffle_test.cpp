@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2021, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch2/catch.hpp>
+
+#include "lbann/data_readers/data_reader_synthetic.hpp"
+#include "lbann/utils/random_number_generators.hpp"
+
+#include <map>
+#include <numeric>
+#include <set>
+#include <vector>
+
+namespace {
+
+/** Exposes the (protected) shuffle of the generic data reader */
+class block_shuffle_reader : public lbann::data_reader_synthetic
+{
+public:
+  block_shuffle_reader(int num_samples)
+    : lbann::data_reader_synthetic(num_samples, 1, true)
+  {
+    std::vector<int> indices(num_samples);
+    std::iota(indices.begin(), indices.end(), 0);
+    set_shuffled_indices(indices);
+  }
+  using lbann::generic_data_reader::shuffle_indices;
+};
+
+} // namespace
+
+TEST_CASE("Block shuffle of data reader indices",
+          "[data_reader][shuffle]")
+{
+  constexpr int num_samples = 103;
+  constexpr size_t block_size = 4;
+  constexpr size_t window = 3;
+  const size_t num_blocks = (num_samples + block_size - 1) / block_size;
+
+  block_shuffle_reader dr(num_samples);
+  dr.set_shuffle_block_size(block_size);
+  dr.set_shuffle_window(window);
+  lbann::rng_gen gen(42);
+  dr.shuffle_indices(gen);
+  const auto& indices = dr.get_shuffled_indices();
+
+  SECTION("Result is a permutation")
+  {
+    std::vector<int> sorted_indices(indices);
+    std::sort(sorted_indices.begin(), sorted_indices.end());
+    std::vector<int> expected(num_samples);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(sorted_indices == expected);
+    CHECK(indices != expected);
+  }
+
+  SECTION("Each window holds whole blocks")
+  {
+    // Walk through the indices, closing a window once it has
+    // consumed all samples of 'window' blocks
+    std::map<size_t, size_t> samples_seen;
+    std::set<size_t> window_blocks;
+    size_t num_windows = 0;
+    for (const auto& index : indices) {
+      const size_t block = index / block_size;
+      window_blocks.insert(block);
+      REQUIRE(window_blocks.size() <= window);
+      ++samples_seen[block];
+      const bool window_done =
+        window_blocks.size() == window &&
+        std::all_of(window_blocks.begin(),
+                    window_blocks.end(),
+                    [&](size_t b) {
+                      const size_t size =
+                        std::min(block_size, num_samples - b * block_size);
+                      return samples_seen[b] == size;
+                    });
+      if (window_done) {
+        window_blocks.clear();
+        ++num_windows;
+      }
+    }
+    CHECK(num_windows == num_blocks / window);
+  }
+
+  SECTION("Shuffle is deterministic and independent of prior order")
+  {
+    block_shuffle_reader dr2(num_samples);
+    dr2.set_shuffle_block_size(block_size);
+    dr2.set_shuffle_window(window);
+    std::vector<int> reversed(num_samples);
+    std::iota(reversed.rbegin(), reversed.rend(), 0);
+    dr2.set_shuffled_indices(reversed);
+    lbann::rng_gen gen2(42);
+    dr2.shuffle_indices(gen2);
+    CHECK(dr2.get_shuffled_indices() == indices);
+  }
+
+  SECTION("Window of zero is the global shuffle")
+  {
+    block_shuffle_reader dr2(num_samples);
+    dr2.set_shuffle_window(0);
+    lbann::rng_gen gen2(42);
+    dr2.shuffle_indices(gen2);
+    std::vector<int> expected(num_samples);
+    std::iota(expected.begin(), expected.end(), 0);
+    lbann::rng_gen ref_gen(42);
+    std::shuffle(expected.begin(), expected.end(), ref_gen);
+    CHECK(dr2.get_shuffled_indices() == expected);
+  }
+}
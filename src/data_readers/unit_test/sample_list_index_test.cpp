@@ -0,0 +1,142 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include "lbann/data_readers/sample_list_index.hpp"
+
+#include "lbann/data_readers/sample_list_hdf5.hpp"
+#include "lbann/data_readers/sample_list_impl.hpp"
+#include "lbann/data_readers/sample_list_open_files_impl.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+std::string const hdf5_legacy_sample_list =
+  R"ptext(CONDUIT_HDF5_INCLUSION
+12 0 3
+/p/vast1/lbann/datasets/PROBIES/h5_data/
+h5out_30.h5 4 0 RUN_ID/000000138 RUN_ID/000000139 RUN_ID/000000140 RUN_ID/000000141
+h5out_31.h5 4 0 RUN_ID/000000000 RUN_ID/000000001 RUN_ID/000000002 RUN_ID/000000003
+h5out_32.h5 4 0 RUN_ID/000000004 RUN_ID/000000005 RUN_ID/000000006 RUN_ID/000000007
+)ptext";
+
+std::string const multi_sample_inclusion_v2_sample_list =
+  R"ptext(MULTI-SAMPLE_INCLUSION_V2
+9 2
+/p/vast1/lbann/datasets/
+a.h5 6 0 ... 3 7 9
+b.h5 3 12 ... 14
+)ptext";
+
+std::string const single_sample_list =
+  R"ptext(SINGLE-SAMPLE
+3
+/p/vast1/lbann/datasets/images/
+/p/vast1/lbann/datasets/images/labels.txt
+img_0.png
+img_1.png
+img_2.png
+)ptext";
+
+std::string const exclusive_sample_list =
+  R"ptext(MULTI-SAMPLE_EXCLUSION
+3 1 1
+/p/vast1/lbann/datasets/
+/p/vast1/lbann/datasets/labels.txt
+a.h5 3 1 RUN_ID/000000001
+)ptext";
+
+void convert(std::string const& text_list, std::string const& filename)
+{
+  std::istringstream iss(text_list);
+  lbann::sample_list_index::convert(iss, filename);
+}
+
+} // namespace
+
+TEST_CASE("Binary sample list index", "[seq][data_reader][sample_list]")
+{
+  std::string const filename = "sample_list_index_test.bin";
+
+  SECTION("Named samples round trip")
+  {
+    convert(hdf5_legacy_sample_list, filename);
+    CHECK(lbann::sample_list_index::is_index_file(filename));
+    lbann::sample_list_hdf5<std::string> sample_list;
+    sample_list.load_index(filename);
+    std::remove(filename.c_str());
+
+    std::string buf;
+    sample_list.to_string(buf);
+    CHECK(buf == hdf5_legacy_sample_list);
+    CHECK(sample_list.size() == 12);
+    CHECK(sample_list.get_num_files() == 3);
+    CHECK(sample_list[4].second == "RUN_ID/000000000");
+    CHECK(sample_list.get_samples_filename(sample_list[4].first) ==
+          "h5out_31.h5");
+  }
+
+  SECTION("Integer ranges round trip")
+  {
+    convert(multi_sample_inclusion_v2_sample_list, filename);
+    lbann::sample_list_hdf5<size_t> sample_list;
+    sample_list.load_index(filename);
+    std::remove(filename.c_str());
+
+    std::string buf;
+    sample_list.to_string(buf);
+    CHECK(buf == multi_sample_inclusion_v2_sample_list);
+    REQUIRE(sample_list.size() == 9);
+    CHECK(sample_list[3].second == 3);
+    CHECK(sample_list[4].second == 7);
+    CHECK(sample_list[8].second == 14);
+  }
+
+  SECTION("Strided load selects whole files")
+  {
+    convert(hdf5_legacy_sample_list, filename);
+    lbann::sample_list_hdf5<std::string> sample_list;
+    sample_list.load_index(filename, 2, 1);
+    std::remove(filename.c_str());
+
+    REQUIRE(sample_list.size() == 4);
+    CHECK(sample_list.get_num_files() == 1);
+    CHECK(sample_list.get_samples_filename(sample_list[0].first) ==
+          "h5out_31.h5");
+    CHECK(sample_list[3].second == "RUN_ID/000000003");
+  }
+
+  SECTION("Single-sample list")
+  {
+    convert(single_sample_list, filename);
+    lbann::sample_list<std::string> sample_list;
+    sample_list.load_index(filename);
+    std::remove(filename.c_str());
+
+    std::string buf;
+    sample_list.to_string(buf);
+    CHECK(buf == single_sample_list);
+    REQUIRE(sample_list.size() == 3);
+    CHECK(sample_list[2].second == "img_2.png");
+  }
+
+  SECTION("Text lists are not indices")
+  {
+    {
+      std::ofstream ofs(filename);
+      ofs << single_sample_list;
+    }
+    CHECK_FALSE(lbann::sample_list_index::is_index_file(filename));
+    std::remove(filename.c_str());
+  }
+
+  SECTION("Exclusive lists cannot be indexed")
+  {
+    CHECK_THROWS(convert(exclusive_sample_list, filename));
+    std::remove(filename.c_str());
+  }
+}
@@ -38,6 +38,8 @@
 #include "lbann/utils/file_utils.hpp"
 #include "lbann/utils/commify.hpp"
 #include "lbann/utils/serialize.hpp"
+#include <algorithm>
+#include <atomic>
 #include <unordered_set>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -47,11 +49,70 @@
 #include <unistd.h>
 #include <unistd.h>
 #include <sys/statvfs.h>
+#include <zlib.h>
 
 #include <cstdlib>
+#include <cstring>
 
 namespace lbann {
 
+namespace {
+
+/** @brief Prefix of a sample held in compressed form
+ *
+ *  The bytes of the packed sample past 'shuffle_offset' (i.e, its
+ *  "data" field) are transposed so that byte b of every element is
+ *  stored contiguously, then the whole buffer is deflated.
+ */
+struct compressed_sample_header {
+  uint64_t packed_size;
+  uint64_t compressed_size;
+  uint32_t shuffle_offset;
+  uint32_t element_bytes;
+};
+
+/// returns the size of the elements of every leaf of the node, or 1
+/// if the leaves differ
+size_t common_element_bytes(const conduit::Node &node) {
+  if (node.number_of_children() == 0) {
+    return node.dtype().is_empty() ? 0 : node.dtype().element_bytes();
+  }
+  size_t r = 0;
+  for (conduit::index_t j=0; j<node.number_of_children(); j++) {
+    const size_t b = common_element_bytes(node.child(j));
+    if (b == 0 || b == r) {
+      continue;
+    }
+    if (r != 0) {
+      return 1;
+    }
+    r = b;
+  }
+  return r;
+}
+
+void shuffle_bytes(const conduit::uint8 *in, conduit::uint8 *out, size_t len, size_t width) {
+  const size_t n = len / width;
+  for (size_t i=0; i<n; i++) {
+    for (size_t b=0; b<width; b++) {
+      out[b*n + i] = in[i*width + b];
+    }
+  }
+  memcpy(out + n*width, in + n*width, len - n*width);
+}
+
+void unshuffle_bytes(const conduit::uint8 *in, conduit::uint8 *out, size_t len, size_t width) {
+  const size_t n = len / width;
+  for (size_t i=0; i<n; i++) {
+    for (size_t b=0; b<width; b++) {
+      out[i*width + b] = in[b*n + i];
+    }
+  }
+  memcpy(out + n*width, in + n*width, len - n*width);
+}
+
+} // namespace
+
 data_store_conduit::data_store_conduit(
   generic_data_reader *reader) :
   m_reader(reader) {
@@ -96,14 +157,35 @@ data_store_conduit::data_store_conduit(
   }
 
   set_is_local_cache(arg_parser.get<bool>(LBANN_OPTION_DATA_STORE_CACHE));
+  set_is_node_local_store(arg_parser.get<bool>(LBANN_OPTION_DATA_STORE_NODE_LOCAL));
+  if (is_node_local_store() && (is_local_cache() || m_spill)) {
+    // local cache mode already shares a full copy per node, and
+    // spilled samples are not held in memory
+    set_is_node_local_store(false);
+  }
+  set_is_compressed(arg_parser.get<bool>(LBANN_OPTION_DATA_STORE_COMPRESS));
+  if (is_compressed() && (is_local_cache() || m_spill)) {
+    // the local cache is read in place from a shared segment, and
+    // spilled samples are not held in memory
+    set_is_compressed(false);
+  }
+  if (is_compressed()) {
+    // compressed sizes differ from sample to sample
+    set_node_sizes_vary();
+  }
   set_is_preloading(arg_parser.get<bool>(LBANN_OPTION_PRELOAD_DATA_STORE));
   set_is_explicitly_loading(! is_preloading());
 
   if (is_local_cache()) {
     PROFILE("data_store_conduit is running in local_cache mode");
+  } else if (is_node_local_store()) {
+    PROFILE("data_store_conduit is running in multi-message mode with node-local sharing");
   } else {
     PROFILE("data_store_conduit is running in multi-message mode");
   }
+  if (is_compressed()) {
+    PROFILE("data_store_conduit is holding samples compressed");
+  }
   if (is_explicitly_loading()) {
     PROFILE("data_store_conduit is explicitly loading");
   } else {
@@ -130,6 +212,7 @@ data_store_conduit::~data_store_conduit() {
       std::cout << "\nWARNING: munmap failed in data_store_conduit::~data_store_conduit()\n";
     }
   }
+  release_node_local_store();
 }
 
 void data_store_conduit::setup_checkpoint_test() {
@@ -187,6 +270,10 @@ void data_store_conduit::copy_members(const data_store_conduit& rhs) {
   m_owner_map_mb_size = rhs.m_owner_map_mb_size;
   m_compacted_sample_size = rhs.m_compacted_sample_size;
   m_is_local_cache = rhs.m_is_local_cache;
+  // The copy owns different samples, so it builds its own segments
+  release_node_local_store();
+  m_is_node_local_store = rhs.m_is_node_local_store;
+  m_compress = rhs.m_compress;
   m_node_sizes_vary = rhs.m_node_sizes_vary;
   m_have_sample_sizes = rhs.m_have_sample_sizes;
   m_comm = rhs.m_comm;
@@ -224,6 +311,10 @@ void data_store_conduit::copy_members(const data_store_conduit& rhs) {
   //these will probably zero-length, but I don't want to make assumptions
   //as to state when copy_member is called
   m_minibatch_data = rhs.m_minibatch_data;
+  // these refer to rhs' buffers, so are rebuilt at the next exchange
+  m_compressed_minibatch_data.clear();
+  m_decompressed_data.clear();
+  m_loading_decompressed_data.clear();
   m_send_buffer = rhs.m_send_buffer;
   m_send_buffer_2 = rhs.m_send_buffer_2;
   m_send_requests = rhs.m_send_requests;
@@ -301,7 +392,20 @@ void data_store_conduit::set_preloaded_conduit_node(int data_id, const conduit::
     return;
   }
 
-  {
+  if (m_compress) {
+    conduit::Node packed;
+    conduit::Node compressed;
+    {
+      conduit::Node n2 = node;  // node == m_data[data_id]
+      std::lock_guard<std::mutex> lock(m_mutex);
+      build_node_for_sending(n2, packed);
+    }
+    compress_node(packed, common_element_bytes(packed["data"]), compressed);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_data[data_id] = compressed;
+  }
+
+  else {
     conduit::Node n2 = node;  // node == m_data[data_id]
     std::lock_guard<std::mutex> lock(m_mutex);
     build_node_for_sending(n2, m_data[data_id]);
@@ -407,7 +511,13 @@ void data_store_conduit::set_conduit_node(int data_id, const conduit::Node &node
       DEBUG_DS("set_conduit_node : rank_in_trainer=", m_rank_in_trainer, " and partition_in_trainer=", m_partition_in_trainer, " offset in partition=", m_offset_in_partition, " with num_partitions=", m_num_partitions_in_trainer);
       auto key = std::make_pair(data_id, m_offset_in_partition);
       m_owner[key] = m_rank_in_trainer;
-      build_node_for_sending(node, m_data[data_id]);
+      if (m_compress) {
+        conduit::Node packed;
+        build_node_for_sending(node, packed);
+        compress_node(packed, common_element_bytes(packed["data"]), m_data[data_id]);
+      } else {
+        build_node_for_sending(node, m_data[data_id]);
+      }
       m_sample_sizes[data_id] = m_data[data_id].total_bytes_compact();
       error_check_compacted_node(m_data[data_id], data_id);
       //      m_mutex.unlock();
@@ -425,6 +535,10 @@ const conduit::Node & data_store_conduit::get_conduit_node(int data_id) const {
     return t3->second;
   }
 
+  if (m_compress) {
+    return get_decompressed_node(data_id);
+  }
+
   iterator_t t2 = m_minibatch_data.find(data_id);
   // if not preloaded, and get_label() or get_response() is called,
   // we need to check m_data
@@ -439,6 +553,102 @@ const conduit::Node & data_store_conduit::get_conduit_node(int data_id) const {
   return t2->second;
 }
 
+const conduit::Node & data_store_conduit::get_decompressed_node(int data_id) const {
+  const conduit::uint8 *buf = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_decompress_mutex);
+    auto t = m_decompressed_data.find(data_id);
+    if (t != m_decompressed_data.end()) {
+      return t->second.node;
+    }
+    auto t2 = m_compressed_minibatch_data.find(data_id);
+    if (t2 != m_compressed_minibatch_data.end()) {
+      buf = t2->second;
+    } else {
+      // if not preloaded, and get_label() or get_response() is called,
+      // we need to check m_data
+      auto t3 = m_data.find(data_id);
+      if (t3 != m_data.end()) {
+        buf = reinterpret_cast<const conduit::uint8*>(t3->second.data_ptr());
+      }
+    }
+  }
+  if (buf == nullptr) {
+    LBANN_ERROR("failed to find data_id: ", data_id, " in m_compressed_minibatch_data; m_compressed_minibatch_data.size: ", m_compressed_minibatch_data.size(), " and also failed to find it in m_data; m_data.size: ", m_data.size(), "; role: ", m_reader->get_role());
+  }
+
+  // decompress outside the lock, so the I/O threads work concurrently
+  double tm1 = get_time();
+  std::vector<conduit::uint8> work;
+  decompress_node(buf, work);
+
+  std::lock_guard<std::mutex> lock(m_decompress_mutex);
+  m_decompress_time += get_time() - tm1;
+  ++m_num_decompressed;
+  if (is_explicitly_loading()) {
+    // only valid until this thread decompresses another sample
+    decompressed_sample &d = m_loading_decompressed_data[std::this_thread::get_id()];
+    d.buffer = std::move(work);
+    d.node.reset();
+    unpack_node_for_receiving(d.buffer.data(), d.node);
+    return d.node;
+  }
+  auto t = m_decompressed_data.emplace(data_id, decompressed_sample());
+  if (t.second) {
+    decompressed_sample &d = t.first->second;
+    d.buffer = std::move(work);
+    unpack_node_for_receiving(d.buffer.data(), d.node);
+  }
+  return t.first->second.node;
+}
+
+void data_store_conduit::compress_node(const conduit::Node &packed, size_t element_bytes, conduit::Node &node_out) const {
+  const size_t packed_size = packed.total_bytes_compact();
+  const size_t data_size = packed["data"].total_bytes_compact();
+  const conduit::uint8 *in = reinterpret_cast<const conduit::uint8*>(packed.data_ptr());
+
+  std::vector<conduit::uint8> shuffled(packed_size);
+  const size_t offset = packed_size - data_size;
+  memcpy(shuffled.data(), in, offset);
+  shuffle_bytes(in + offset, shuffled.data() + offset, data_size, std::max(element_bytes, size_t{1}));
+
+  uLongf compressed_size = compressBound(packed_size);
+  std::vector<conduit::uint8> compressed(compressed_size);
+  int status = compress2(compressed.data(), &compressed_size,
+                         shuffled.data(), packed_size, Z_BEST_SPEED);
+  if (status != Z_OK) {
+    LBANN_ERROR("compress2 failed with status ", status, " for a sample of ", packed_size, " bytes");
+  }
+
+  compressed_sample_header h;
+  h.packed_size = packed_size;
+  h.compressed_size = compressed_size;
+  h.shuffle_offset = offset;
+  h.element_bytes = std::max(element_bytes, size_t{1});
+  node_out.reset();
+  node_out.set(conduit::DataType::uint8(sizeof(h) + compressed_size));
+  conduit::uint8 *out = node_out.as_uint8_ptr();
+  memcpy(out, &h, sizeof(h));
+  memcpy(out + sizeof(h), compressed.data(), compressed_size);
+}
+
+void data_store_conduit::decompress_node(const conduit::uint8 *buf, std::vector<conduit::uint8> &buf_out) const {
+  compressed_sample_header h;
+  memcpy(&h, buf, sizeof(h));
+  std::vector<conduit::uint8> shuffled(h.packed_size);
+  uLongf packed_size = h.packed_size;
+  int status = uncompress(shuffled.data(), &packed_size,
+                          buf + sizeof(h), h.compressed_size);
+  if (status != Z_OK || packed_size != h.packed_size) {
+    LBANN_ERROR("uncompress failed with status ", status, "; expected ", h.packed_size, " bytes, got ", packed_size);
+  }
+  buf_out.resize(h.packed_size);
+  memcpy(buf_out.data(), shuffled.data(), h.shuffle_offset);
+  unshuffle_bytes(shuffled.data() + h.shuffle_offset,
+                  buf_out.data() + h.shuffle_offset,
+                  h.packed_size - h.shuffle_offset, h.element_bytes);
+}
+
 // code in the following method is a modification of code from
 // conduit/src/libs/relay/conduit_relay_mpi.cpp
 void data_store_conduit::build_node_for_sending(const conduit::Node &node_in, conduit::Node &node_out) {
@@ -503,6 +713,10 @@ void data_store_conduit::exchange_data_by_sample(size_t current_pos, size_t mb_s
     m_exchange_sample_sizes_time += (get_time() - tm3);
   }
 
+  if (m_is_node_local_store && !m_node_local_store_is_built) {
+    build_node_local_store();
+  }
+
   int num_send_req = build_indices_i_will_send(current_pos, mb_size);
   if (m_spill) {
     // TODO
@@ -602,22 +816,35 @@ void data_store_conduit::exchange_data_by_sample(size_t current_pos, size_t mb_s
   //part 3: construct the Nodes needed by me for the current minibatch
 
   tm5 = get_time();
-  conduit::Node nd;
   m_minibatch_data.clear();
+  if (m_compress) {
+    // samples are decompressed by the I/O threads, in get_conduit_node
+    std::lock_guard<std::mutex> lock(m_decompress_mutex);
+    m_compressed_minibatch_data.clear();
+    m_decompressed_data.clear();
+  }
   for (size_t j=0; j < m_recv_buffer.size(); j++) {
     conduit::uint8 *n_buff_ptr = (conduit::uint8*)m_recv_buffer[j].data_ptr();
-    conduit::Node n_msg;
-    n_msg["schema_len"].set_external((conduit::int64*)n_buff_ptr);
-    n_buff_ptr +=8;
-    n_msg["schema"].set_external_char8_str((char*)(n_buff_ptr));
-    conduit::Schema rcv_schema;
-    conduit::Generator gen(n_msg["schema"].as_char8_str());
-    gen.walk(rcv_schema);
-    n_buff_ptr += n_msg["schema"].total_bytes_compact();
-    n_msg["data"].set_external(rcv_schema,n_buff_ptr);
-
     int data_id = m_recv_data_ids[j];
-    m_minibatch_data[data_id].set_external(n_msg["data"]);
+    if (m_compress) {
+      m_compressed_minibatch_data[data_id] = n_buff_ptr;
+      continue;
+    }
+    unpack_node_for_receiving(n_buff_ptr, m_minibatch_data[data_id]);
+  }
+  // samples owned by ranks on this node are read in place
+  for (const auto &t2 : m_node_local_recv_data_ids) {
+    const int data_id = t2.first;
+    const auto &samples = m_node_local_samples[t2.second];
+    auto t = samples.find(data_id);
+    if (t == samples.end()) {
+      LBANN_ERROR("failed to find data_id: ", data_id, " in the node-local segment of P_", t2.second, "; role: ", m_reader->get_role());
+    }
+    if (m_compress) {
+      m_compressed_minibatch_data[data_id] = t->second;
+      continue;
+    }
+    unpack_node_for_receiving(const_cast<conduit::uint8*>(t->second), m_minibatch_data[data_id]);
   }
   m_rebuild_time += (get_time() - tm5);
 
@@ -627,9 +854,24 @@ void data_store_conduit::exchange_data_by_sample(size_t current_pos, size_t mb_s
   }
 }
 
+void data_store_conduit::unpack_node_for_receiving(conduit::uint8 *buf, conduit::Node &node_out) const {
+  conduit::uint8 *n_buff_ptr = buf;
+  conduit::Node n_msg;
+  n_msg["schema_len"].set_external((conduit::int64*)n_buff_ptr);
+  n_buff_ptr +=8;
+  n_msg["schema"].set_external_char8_str((char*)(n_buff_ptr));
+  conduit::Schema rcv_schema;
+  conduit::Generator gen(n_msg["schema"].as_char8_str());
+  gen.walk(rcv_schema);
+  n_buff_ptr += n_msg["schema"].total_bytes_compact();
+  n_msg["data"].set_external(rcv_schema,n_buff_ptr);
+  node_out.set_external(n_msg["data"]);
+}
+
 int data_store_conduit::build_indices_i_will_recv(int current_pos, int mb_size) {
   m_indices_to_recv.clear();
   m_indices_to_recv.resize(m_np_in_trainer);
+  m_node_local_recv_data_ids.clear();
   int k = 0;
   for (int i=current_pos; i< current_pos + mb_size; ++i) {
     auto index = (*m_shuffled_indices)[i];
@@ -641,6 +883,10 @@ int data_store_conduit::build_indices_i_will_recv(int current_pos, int mb_size)
     if ((((i % m_owner_map_mb_size) % m_num_partitions_in_trainer) * num_ranks_in_partition + m_offset_in_partition) == m_rank_in_trainer) {
       auto key = std::make_pair(index, m_offset_in_partition);
       int owner = m_owner[key];
+      if (m_node_local_store_is_built && m_rank_is_node_local[owner]) {
+        m_node_local_recv_data_ids.emplace_back(index, owner);
+        continue;
+      }
       m_indices_to_recv[owner].insert(index);
       k++;
     }
@@ -668,7 +914,12 @@ int data_store_conduit::build_indices_i_will_send(int current_pos, int mb_size)
 #else
       int num_ranks_in_partition = 1;
 #endif // LBANN_HAS_DISTCONV
-      m_indices_to_send[(((i % m_owner_map_mb_size) % m_num_partitions_in_trainer) * num_ranks_in_partition + m_offset_in_partition)].insert(index);
+      const int dest = ((i % m_owner_map_mb_size) % m_num_partitions_in_trainer) * num_ranks_in_partition + m_offset_in_partition;
+      if (m_node_local_store_is_built && m_rank_is_node_local[dest]) {
+        // the destination reads the sample from my segment
+        continue;
+      }
+      m_indices_to_send[dest].insert(index);
 
       // Sanity check
       auto key = std::make_pair(index, m_offset_in_partition);
@@ -681,6 +932,153 @@ int data_store_conduit::build_indices_i_will_send(int current_pos, int mb_size)
   return k;
 }
 
+void data_store_conduit::build_node_local_store() {
+  PROFILE("starting data_store_conduit::build_node_local_store");
+  double tm1 = get_time();
+
+  m_rank_is_node_local.assign(m_np_in_trainer, false);
+  for (int p=0; p<m_np_in_trainer; p++) {
+    m_rank_is_node_local[p] = m_comm->is_rank_node_local(p, m_comm->get_trainer_comm());
+  }
+
+  // Segment layout: the number of samples, then a (data_id, offset)
+  // directory, then the packed samples in the layout that is sent
+  // by exchange_data_by_sample
+  std::vector<int> my_ids;
+  my_ids.reserve(m_data.size());
+  for (const auto &t : m_data) {
+    my_ids.push_back(t.first);
+  }
+  std::sort(my_ids.begin(), my_ids.end());
+  const size_t header_len = sizeof(uint64_t) * (1 + 2*my_ids.size());
+  size_t length = header_len;
+  for (auto data_id : my_ids) {
+    length += m_data[data_id].total_bytes_compact();
+  }
+
+  // Every rank must be able to create its segment, or none of them do
+  struct statvfs fs_stat;
+  int ok = (statvfs("/dev/shm", &fs_stat) == 0
+            && length < fs_stat.f_bsize*fs_stat.f_bavail) ? 1 : 0;
+  ok = m_comm->trainer_allreduce<int>(ok, El::mpi::MIN);
+  if (!ok) {
+    PROFILE("  insufficient space in /dev/shm on at least one rank; node-local sharing is disabled");
+    m_is_node_local_store = false;
+    return;
+  }
+
+  // Names must be unique across processes on a node and across data
+  // stores within a process
+  static std::atomic<int> segment_count{0};
+  std::vector<int> my_name = {static_cast<int>(getpid()), segment_count++};
+  std::vector<int> names(2*m_np_in_trainer);
+  m_comm->all_gather<int>(my_name.data(), 2, names.data(), 2, m_comm->get_trainer_comm());
+  auto segment_name = [&names](int p) {
+    return "/lbann_ds_" + std::to_string(names[2*p]) + "_" + std::to_string(names[2*p+1]);
+  };
+
+  m_node_local_segments.clear();
+  m_node_local_segments.resize(m_np_in_trainer);
+  node_local_segment &mine = m_node_local_segments[m_rank_in_trainer];
+  mine.name = segment_name(m_rank_in_trainer);
+  mine.length = length;
+  shm_unlink(mine.name.c_str());
+  int shm_fd = shm_open(mine.name.c_str(), O_CREAT | O_RDWR | O_EXCL, 0600);
+  if (shm_fd == -1) {
+    LBANN_ERROR("shm_open failed for ", mine.name, " (", strerror(errno), ")");
+  }
+  if (ftruncate(shm_fd, length) != 0) {
+    LBANN_ERROR("ftruncate failed for size: ", length);
+  }
+  void *m = mmap(0, length, PROT_WRITE | PROT_READ, MAP_SHARED, shm_fd, 0);
+  close(shm_fd);
+  if (m == MAP_FAILED) {
+    LBANN_ERROR("mmap failed for ", mine.name);
+  }
+  mine.data = reinterpret_cast<char*>(m);
+
+  // Copy the owned samples into the segment; m_data then refers to
+  // the segment, so the samples are held once per node
+  uint64_t *directory = reinterpret_cast<uint64_t*>(mine.data);
+  directory[0] = my_ids.size();
+  size_t offset = header_len;
+  for (size_t j=0; j<my_ids.size(); j++) {
+    conduit::Node &nd = m_data[my_ids[j]];
+    const size_t sz = nd.total_bytes_compact();
+    if (!nd.is_contiguous()) {
+      LBANN_ERROR("data_id: ", my_ids[j], " does not have a contiguous layout");
+    }
+    directory[1 + 2*j] = my_ids[j];
+    directory[2 + 2*j] = offset;
+    memcpy(mine.data + offset, nd.data_ptr(), sz);
+    conduit::Schema schema = nd.schema();
+    nd.set_external(schema, mine.data + offset);
+    offset += sz;
+  }
+  m_comm->trainer_barrier();
+
+  // Map the segments of the other ranks on this node
+  m_node_local_samples.assign(m_np_in_trainer, {});
+  for (int p=0; p<m_np_in_trainer; p++) {
+    if (!m_rank_is_node_local[p]) {
+      continue;
+    }
+    node_local_segment &seg = m_node_local_segments[p];
+    if (p != m_rank_in_trainer) {
+      seg.name = segment_name(p);
+      shm_fd = shm_open(seg.name.c_str(), O_RDONLY, 0600);
+      if (shm_fd == -1) {
+        LBANN_ERROR("shm_open failed for ", seg.name, " (", strerror(errno), ")");
+      }
+      struct stat b;
+      if (fstat(shm_fd, &b) == -1) {
+        LBANN_ERROR("fstat failed for ", seg.name);
+      }
+      seg.length = b.st_size;
+      m = mmap(0, seg.length, PROT_READ, MAP_SHARED, shm_fd, 0);
+      close(shm_fd);
+      if (m == MAP_FAILED) {
+        LBANN_ERROR("mmap failed for ", seg.name);
+      }
+      seg.data = reinterpret_cast<char*>(m);
+    }
+    const uint64_t *dir = reinterpret_cast<const uint64_t*>(seg.data);
+    for (uint64_t j=0; j<dir[0]; j++) {
+      m_node_local_samples[p][dir[1 + 2*j]] =
+        reinterpret_cast<const conduit::uint8*>(seg.data + dir[2 + 2*j]);
+    }
+  }
+
+  // Once every rank has mapped the segments their names can be
+  // removed; the memory is released when the last mapping goes away
+  m_comm->trainer_barrier();
+  shm_unlink(mine.name.c_str());
+
+  m_node_local_store_is_built = true;
+  size_t num_node_local = 0;
+  for (const auto &samples : m_node_local_samples) {
+    num_node_local += samples.size();
+  }
+  PROFILE("  node-local segment: ", utils::commify(length), " bytes; ",
+          "samples readable in place: ", num_node_local,
+          "; time: ", get_time() - tm1);
+}
+
+void data_store_conduit::release_node_local_store() {
+  for (auto &seg : m_node_local_segments) {
+    if (seg.data != nullptr) {
+      if (munmap(reinterpret_cast<void*>(seg.data), seg.length) != 0) {
+        std::cout << "\nWARNING: munmap failed in data_store_conduit::release_node_local_store()\n";
+      }
+    }
+  }
+  m_node_local_segments.clear();
+  m_node_local_samples.clear();
+  m_node_local_recv_data_ids.clear();
+  m_rank_is_node_local.clear();
+  m_node_local_store_is_built = false;
+}
+
 void data_store_conduit::build_preloaded_owner_map(const std::vector<int>& per_rank_list_sizes) {
   PROFILE("starting data_store_conduit::build_preloaded_owner_map");
   m_owner.clear();
@@ -699,7 +1097,7 @@ PROFILE("build_preloaded_owner_map; m_owner_maps_were_exchanged = true");
   m_owner_maps_were_exchanged = true;
 }
 
-const conduit::Node & data_store_conduit::get_random_node() const {
+conduit::Node data_store_conduit::get_random_node() const {
   size_t sz = m_data.size();
 
   // Deal with edge case
@@ -709,13 +1107,20 @@ const conduit::Node & data_store_conduit::get_random_node() const {
 
   int offset = random() % sz;
   auto it = std::next(m_data.begin(), offset);
+  if (m_compress) {
+    std::vector<conduit::uint8> work;
+    decompress_node(reinterpret_cast<const conduit::uint8*>(it->second.data_ptr()), work);
+    conduit::Node nd;
+    unpack_node_for_receiving(work.data(), nd);
+    conduit::Node random_node;
+    random_node["data"].set(nd);
+    return random_node;
+  }
   return it->second;
 }
 
-const conduit::Node & data_store_conduit::get_random_node(const std::string &field) const {
-  auto node = get_random_node();
-  //return node;
-  return node[field];
+conduit::Node data_store_conduit::get_random_node(const std::string &field) const {
+  return get_random_node()[field];
 }
 
 conduit::Node & data_store_conduit::get_empty_node(int data_id) {
@@ -968,6 +1373,13 @@ void data_store_conduit::set_loading_is_complete() {
   set_is_explicitly_loading(false);
   check_query_flags();
 
+  if (m_compress) {
+    // samples decompressed while explicitly loading
+    std::lock_guard<std::mutex> lock(m_decompress_mutex);
+    m_decompressed_data.clear();
+    m_loading_decompressed_data.clear();
+  }
+
   if (m_run_checkpoint_test) {
     test_checkpoint(m_spill_dir_base);
   }
@@ -1435,6 +1847,15 @@ void data_store_conduit::profile_timing() {
         "  start sends and rcvs:     ", m_start_snd_rcv_time, "\n",
         "  wait alls:                ", m_wait_all_time, "\n",
         "  unpacking rcvd nodes:     ", m_rebuild_time, "\n\n");
+    if (m_compress) {
+      std::lock_guard<std::mutex> lock(m_decompress_mutex);
+      PROFILE(
+        "Decompression (summed over I/O threads):\n",
+        "  samples decompressed:     ", m_num_decompressed, "\n",
+        "  decompress time:          ", m_decompress_time, "\n\n");
+      m_decompress_time = 0.;
+      m_num_decompressed = 0;
+    }
 
     if (arg_parser.get<bool>(LBANN_OPTION_DATA_STORE_MIN_MAX_TIMING)) {
       std::vector<double> send;
@@ -2065,6 +2486,17 @@ size_t data_store_conduit::get_mem_usage() {
     }
     r += nd.total_bytes_compact();
   }
+  if (m_compress) {
+    size_t uncompressed = 0;
+    for (const auto &t : m_data) {
+      compressed_sample_header h;
+      memcpy(&h, t.second.data_ptr(), sizeof(h));
+      uncompressed += h.packed_size;
+    }
+    PROFILE("data store memory: ", utils::commify(r), " bytes compressed; ",
+            utils::commify(uncompressed), " bytes uncompressed; ratio: ",
+            (r ? static_cast<double>(uncompressed)/r : 0.));
+  }
   return r;
 }
 
@@ -68,7 +68,9 @@ KFAC::KFAC(
   std::vector<std::string> disable_layers,
   double learning_rate_factor,
   double learning_rate_factor_gru,
-  size_t compute_interval)
+  size_t compute_interval,
+  bool async_inverse,
+  size_t max_inverse_staleness)
   : BaseType{std::move(name)},
     m_stopping_criteria{std::move(stop)},
     m_damping_act_params{std::move(damping_act_params)},
@@ -87,7 +89,9 @@ KFAC::KFAC(
     m_disable_layers{std::move(disable_layers)},
     m_learning_rate_factor{learning_rate_factor},
     m_learning_rate_factor_gru{learning_rate_factor_gru},
-    m_compute_interval{compute_interval}
+    m_compute_interval{compute_interval},
+    m_async_inverse{async_inverse},
+    m_max_inverse_staleness{max_inverse_staleness}
 {}
 
 KFAC::KFAC(KFAC const& other)
@@ -108,7 +112,9 @@ KFAC::KFAC(KFAC const& other)
     m_inverse_strategy{other.m_inverse_strategy},
     m_disable_layers{other.m_disable_layers},
     m_learning_rate_factor{other.m_learning_rate_factor},
-    m_compute_interval{other.m_compute_interval}
+    m_compute_interval{other.m_compute_interval},
+    m_async_inverse{other.m_async_inverse},
+    m_max_inverse_staleness{other.m_max_inverse_staleness}
 {}
 
 KFAC& KFAC::operator=(KFAC const& other) {
@@ -130,6 +136,8 @@ KFAC& KFAC::operator=(KFAC const& other) {
   m_disable_layers = other.m_disable_layers;
   m_learning_rate_factor = other.m_learning_rate_factor;
   m_compute_interval = other.m_compute_interval;
+  m_async_inverse = other.m_async_inverse;
+  m_max_inverse_staleness = other.m_max_inverse_staleness;
   return *this;
 }
 
@@ -262,6 +270,13 @@ void KFAC::train(
 
   sgd_context.stop_timer();
 
+  // Do not leave inverses in flight across training runs.
+  if(m_has_pending_inverse) {
+    for(auto& block : kfac_context.m_blocks)
+      block->finish_async_kronecker_inverse();
+    m_has_pending_inverse = false;
+    allgather_kronecker_inverses(kfac_context, comm);
+  }
 
   // Reset the model back to the training execution context prior to
   // end of training callbacks
@@ -771,6 +786,83 @@ void KFAC::send_recv_inverse_matrices(
 // KFAC implementation
 // =============================================
 
+void KFAC::allgather_kronecker_inverses(
+  ExeContextType& context,
+  lbann_comm& comm) {
+
+  int global_buffer_inverses_size = 0;
+
+  for(auto& block : context.m_blocks){
+    global_buffer_inverses_size += block->get_inverse_matrices_size(&comm);
+  }
+
+  El::Matrix<DataType, Device>& global_buffer_inverse =
+    context.get_workspace_matrix(
+      "allgather_inverse_recv_buffer",
+      global_buffer_inverses_size,
+      1);
+  kfac::allgather_inverse_matrices(
+      context.m_blocks,
+      global_buffer_inverse,
+      &comm);
+}
+
+bool KFAC::update_async_kronecker_inverses(
+  ExeContextType& context,
+  lbann_comm& comm,
+  const size_t num_steps,
+  const bool is_kronecker_update_required) {
+
+  bool is_inverse_updated = false;
+
+  // Install the pending inverses once they reach the maximum
+  // staleness, or before a newer snapshot is taken. The decision only
+  // depends on the step count, so every process takes it at the same
+  // time and the following allgather stays collective.
+  if(m_has_pending_inverse
+     && (num_steps - m_pending_inverse_step >= m_max_inverse_staleness
+         || is_kronecker_update_required)) {
+    prof_region_begin("kfac-inverse/wait", prof_color, prof_sync);
+    for(auto& block : context.m_blocks)
+      block->finish_async_kronecker_inverse();
+    prof_region_end("kfac-inverse/wait", prof_sync);
+    m_has_pending_inverse = false;
+    is_inverse_updated = true;
+  }
+
+  if(!is_kronecker_update_required)
+    return is_inverse_updated;
+
+  for(auto& block : context.m_blocks) {
+    if(!block->supports_async_kronecker_inverse())
+      is_inverse_updated = true;
+    if((size_t) comm.get_rank_in_trainer() != block->get_inverse_proc_rank())
+      continue;
+
+    const bool is_bn = dynamic_cast<kfac_block_bn<Device>*>(block.get()) != nullptr;
+    const bool is_gru = dynamic_cast<kfac_block_gru<Device>*>(block.get()) != nullptr;
+    const DataType damping_act =
+      is_bn ? context.m_damping_bn_act : context.m_damping_act;
+    const DataType damping_err =
+      is_bn ? context.m_damping_bn_err : context.m_damping_err;
+    if(block->supports_async_kronecker_inverse()) {
+      block->start_async_kronecker_inverse(
+          &comm, m_use_pi, damping_act, damping_err, m_print_time);
+    }
+    else {
+      block->update_kronecker_inverse(
+          &comm, m_use_pi, damping_act, damping_err,
+          is_gru ? m_learning_rate_factor_gru : m_learning_rate_factor,
+          m_print_matrix, m_print_matrix_summary,
+          m_print_time);
+    }
+  }
+  m_has_pending_inverse = true;
+  m_pending_inverse_step = num_steps;
+
+  return is_inverse_updated;
+}
+
 void KFAC::on_forward_prop_end(
   ExeContextType& context,
   model& model) {
@@ -993,50 +1085,43 @@ void KFAC::on_backward_prop_end(
 
   // Step 2: Model-parallel inverse computation
   prof_region_begin("kfac-inverse", prof_color, prof_sync);
-  for(auto& block : context.m_blocks) {
-    if(!is_kronecker_update_required || (size_t) comm.get_rank_in_trainer() != block->get_inverse_proc_rank())
-      continue;
-
-    prof_region_begin(("kfac-inverse/" + block->get_name()).c_str(), prof_color, prof_sync);
-    // TODO: Add kfac_block::is_bn?
-    const bool is_bn = dynamic_cast<kfac_block_bn<Device>*>(block.get()) != nullptr;
-    const bool is_gru = dynamic_cast<kfac_block_gru<Device>*>(block.get()) != nullptr;
-    block->update_kronecker_inverse(
-        &comm, m_use_pi,
-        is_bn ? context.m_damping_bn_act : context.m_damping_act,
-        is_bn ? context.m_damping_bn_err : context.m_damping_err,
-        is_gru ? m_learning_rate_factor_gru : m_learning_rate_factor,
-        m_print_matrix, m_print_matrix_summary,
-        m_print_time);
-    prof_region_end(("kfac-inverse/" + block->get_name()).c_str(), prof_sync);
+  if(m_async_inverse && m_has_kronecker_inverse) {
+    if(update_async_kronecker_inverses(
+         context, comm, num_steps, is_kronecker_update_required))
+      allgather_kronecker_inverses(context, comm);
   }
+  else {
+    for(auto& block : context.m_blocks) {
+      if(!is_kronecker_update_required || (size_t) comm.get_rank_in_trainer() != block->get_inverse_proc_rank())
+        continue;
 
-  //allgather inverse matrices
-  if(is_first_step and false){
-    kfac::allgather_inverse_matrices_sizes(context.m_blocks, m_inverse_matrices_size, &comm);
-    int block_number = 0;
-    for(auto& block : context.m_blocks){
-      block->resize_inverse_matrices_size(m_inverse_matrices_size, block_number);
-      block_number++;
+      prof_region_begin(("kfac-inverse/" + block->get_name()).c_str(), prof_color, prof_sync);
+      // TODO: Add kfac_block::is_bn?
+      const bool is_bn = dynamic_cast<kfac_block_bn<Device>*>(block.get()) != nullptr;
+      const bool is_gru = dynamic_cast<kfac_block_gru<Device>*>(block.get()) != nullptr;
+      block->update_kronecker_inverse(
+          &comm, m_use_pi,
+          is_bn ? context.m_damping_bn_act : context.m_damping_act,
+          is_bn ? context.m_damping_bn_err : context.m_damping_err,
+          is_gru ? m_learning_rate_factor_gru : m_learning_rate_factor,
+          m_print_matrix, m_print_matrix_summary,
+          m_print_time);
+      prof_region_end(("kfac-inverse/" + block->get_name()).c_str(), prof_sync);
     }
-  }
 
-  int global_buffer_inverses_size = 0;
+    //allgather inverse matrices
+    if(is_first_step and false){
+      kfac::allgather_inverse_matrices_sizes(context.m_blocks, m_inverse_matrices_size, &comm);
+      int block_number = 0;
+      for(auto& block : context.m_blocks){
+        block->resize_inverse_matrices_size(m_inverse_matrices_size, block_number);
+        block_number++;
+      }
+    }
 
-  for(auto& block : context.m_blocks){
-    global_buffer_inverses_size += block->get_inverse_matrices_size(&comm);
+    allgather_kronecker_inverses(context, comm);
   }
 
-  El::Matrix<DataType, Device>& global_buffer_inverse =
-    context.get_workspace_matrix(
-      "allgather_inverse_recv_buffer",
-      global_buffer_inverses_size,
-      1);
-  kfac::allgather_inverse_matrices(
-      context.m_blocks,
-      global_buffer_inverse,
-      &comm);
-
   m_has_kronecker_inverse = true;
   prof_region_end("kfac-inverse", prof_sync);
 
@@ -1194,6 +1279,16 @@ std::unique_ptr<lbann::KFAC> lbann::make<lbann::KFAC>(
   if(learning_rate_factor_gru == 0.0)
     learning_rate_factor_gru = learning_rate_factor;
 
+  bool async_inverse = kfac_params.async_inverse();
+  if(async_inverse && AlgoType::Device != El::Device::CPU) {
+    LBANN_WARNING("Asynchronous K-FAC inverses are only supported on CPU. "
+                  "Falling back to synchronous inverses.");
+    async_inverse = false;
+  }
+  size_t max_inverse_staleness = kfac_params.max_inverse_staleness();
+  if(max_inverse_staleness == 0)
+    max_inverse_staleness = AlgoType::max_inverse_staleness_default;
+
   return make_unique<AlgoType>(
     params.name(),
     std::move(stopping),
@@ -1213,6 +1308,8 @@ std::unique_ptr<lbann::KFAC> lbann::make<lbann::KFAC>(
     std::move(disable_layers),
     learning_rate_factor,
     learning_rate_factor_gru,
-    compute_interval);
+    compute_interval,
+    async_inverse,
+    max_inverse_staleness);
 
 }
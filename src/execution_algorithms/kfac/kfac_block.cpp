@@ -36,6 +36,50 @@ El::Matrix<DataType, Device>& kfac_block<Device>::get_workspace_matrix(
   return m_context->get_workspace_matrix(get_name()+" "+key, height, width);
 }
 
+template <El::Device Device>
+void kfac_block<Device>::start_async_kronecker_inverse(
+    lbann_comm* comm,
+    const bool use_pi,
+    const DataType damping_act, const DataType damping_err,
+    const bool print_time) {
+  if(Device != El::Device::CPU) {
+    LBANN_ERROR("asynchronous K-FAC inverses are only supported on CPU");
+  }
+  if(m_async_inverse.valid()) {
+    LBANN_ERROR("an asynchronous K-FAC inverse is already in flight for ",
+                get_name());
+  }
+
+  // Snapshot the average factors so that the training loop can keep
+  // updating them while the helper thread is working.
+  const auto averages = get_kronecker_average_matrices();
+  m_async_averages.resize(averages.size());
+  m_async_inverses.resize(averages.size());
+  for(size_t i = 0; i < averages.size(); ++i)
+    El::Copy(*averages[i], m_async_averages[i]);
+
+  const bool report_time = comm->am_trainer_master() && print_time;
+  m_async_inverse = std::async(
+      std::launch::async,
+      [this, use_pi, damping_act, damping_err, report_time] {
+        invert_kronecker_factors(
+            m_async_averages, m_async_inverses,
+            use_pi, damping_act, damping_err, report_time);
+      });
+}
+
+template <El::Device Device>
+void kfac_block<Device>::finish_async_kronecker_inverse() {
+  if(!m_async_inverse.valid())
+    return;
+  // Rethrows any exception raised on the helper thread.
+  m_async_inverse.get();
+  const auto inverses = get_kronecker_inverse_matrices();
+  for(size_t i = 0; i < inverses.size(); ++i)
+    El::Copy(m_async_inverses[i], *inverses[i]);
+  m_has_kronecker_inverse = true;
+}
+
 
 template <>
 El::SyncInfo<El::Device::CPU> kfac_block<El::Device::CPU>::get_sync_info() {
@@ -251,6 +251,42 @@ void kfac_block_fc_conv<Device>::update_kronecker_inverse(
   }
 }
 
+template <El::Device Device>
+void kfac_block_fc_conv<Device>::invert_kronecker_factors(
+    const std::vector<El::Matrix<DataType, Device>>& averages,
+    std::vector<El::Matrix<DataType, Device>>& inverses,
+    const bool use_pi,
+    const DataType damping_act, const DataType damping_err,
+    const bool print_time) {
+
+  const auto& sync_info = this->get_sync_info();
+  const auto& Aave = averages[0];
+  const auto& Gave = averages[1];
+  auto& Ainv = inverses[0];
+  auto& Ginv = inverses[1];
+
+  // Workspaces are local since the shared ones may be in use by the
+  // training loop.
+  DataType pi = 1.0;
+  if(use_pi) {
+    El::Matrix<DataType, Device> ws(
+        std::max(Aave.Height(), Gave.Height())*2+1, 1);
+    pi = compute_pi(Aave, Gave, ws, sync_info);
+  }
+  El::Matrix<DataType, Device> ALinv(Aave.Height(), Aave.Height());
+  El::Matrix<DataType, Device> GLinv(Gave.Height(), Gave.Height());
+  Ainv.Resize(Aave.Height(), Aave.Width());
+  Ginv.Resize(Gave.Height(), Gave.Width());
+  kfac::get_matrix_inverse(
+      Ainv, ALinv, Aave, print_time,
+      DataType(damping_act*pi), 0,
+      false, sync_info);
+  kfac::get_matrix_inverse(
+      Ginv, GLinv, Gave, print_time,
+      DataType(damping_err/pi), 0,
+      false, sync_info);
+}
+
 template <El::Device Device>
 void kfac_block_fc_conv<Device>::compute_preconditioned_gradients(
     lbann_comm* comm,
@@ -536,6 +536,52 @@ void kfac_block_gru<Device>::update_kronecker_inverse(
 
 }
 
+template <El::Device Device>
+std::vector<El::Matrix<DataType, Device>*>
+kfac_block_gru<Device>::get_kronecker_average_matrices() {
+  std::vector<El::Matrix<DataType, Device>*> ret =
+      {&m_kronecker_average_A_h, &m_kronecker_average_A_x};
+  for(auto& matrix_type : kfac_gru_util::LEARNABLE_MATRICES)
+    ret.push_back(&m_kronecker_average_G[matrix_type]);
+  return ret;
+}
+
+template <El::Device Device>
+std::vector<El::Matrix<DataType, Device>*>
+kfac_block_gru<Device>::get_kronecker_inverse_matrices() {
+  std::vector<El::Matrix<DataType, Device>*> ret =
+      {&m_kronecker_inverse_A_h, &m_kronecker_inverse_A_x};
+  for(auto& matrix_type : kfac_gru_util::LEARNABLE_MATRICES)
+    ret.push_back(&m_kronecker_inverse_G[matrix_type]);
+  return ret;
+}
+
+template <El::Device Device>
+void kfac_block_gru<Device>::invert_kronecker_factors(
+    const std::vector<El::Matrix<DataType, Device>>& averages,
+    std::vector<El::Matrix<DataType, Device>>& inverses,
+    const bool use_pi,
+    const DataType damping_act, const DataType damping_err,
+    const bool print_time) {
+  if(use_pi)
+    LBANN_ERROR("The GRU K-FAC implementation does not currently support use_pi.");
+  const auto& sync_info = this->get_sync_info();
+
+  // A_h and A_x are damped with damping_act, the G factors with
+  // damping_err. Workspaces are local since the shared ones may be
+  // in use by the training loop.
+  for(size_t i = 0; i < averages.size(); i++) {
+    const auto& ave = averages[i];
+    auto& inv = inverses[i];
+    El::Matrix<DataType, Device> Linv(ave.Height(), ave.Height());
+    inv.Resize(ave.Height(), ave.Width());
+    kfac::get_matrix_inverse(
+        inv, Linv, ave, print_time,
+        i < 2 ? damping_act : damping_err, 0,
+        false, sync_info);
+  }
+}
+
 template <El::Device Device>
 void kfac_block_gru<Device>::compute_preconditioned_gradients(
       lbann_comm* comm,
@@ -34,6 +34,7 @@
 
 #include <training_algorithm.pb.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 #include <unordered_map>
@@ -44,6 +45,7 @@ SGDTrainingAlgorithm::SGDTrainingAlgorithm(
   SGDTrainingAlgorithm const& other)
   : BaseType(other.get_name()),
     m_stopping_criteria{other.m_stopping_criteria->clone()},
+    m_num_micro_batches{other.m_num_micro_batches},
     m_validation_context{execution_mode::validation, 1UL},
     m_validation_epochs{1UL}
 {}
@@ -53,6 +55,7 @@ SGDTrainingAlgorithm::operator=(SGDTrainingAlgorithm const& other)
 {
   BaseType::operator=(other);
   m_stopping_criteria = other.m_stopping_criteria->clone();
+  m_num_micro_batches = other.m_num_micro_batches;
   m_validation_context = SGDExecutionContext{execution_mode::validation, 1UL};
   m_validation_epochs = 1UL;
   return *this;
@@ -173,46 +176,73 @@ bool SGDTrainingAlgorithm::train_mini_batch(SGDExecutionContext& c,
   do_batch_begin_cbs(model, execution_mode::training);
 
   bool finished = false;
+  bool last_micro_batch = false;
+  const size_t num_micro_batches = std::max(m_num_micro_batches, size_t{1});
 
-  dc.fetch_data(execution_mode::training);
+  // Gradients of each micro-batch accumulate in the optimizers. The
+  // objective function, metrics and batchnorm statistics are computed
+  // per micro-batch.
+  for (size_t micro_batch = 0; !last_micro_batch; ++micro_batch) {
+
+    dc.fetch_data(execution_mode::training);
 
 #if defined(LBANN_HAVE_OMP_TASKLOOP)
-  LBANN_OMP_PARALLEL
-  {
-#pragma omp single
+    LBANN_OMP_PARALLEL
     {
+#pragma omp single
+      {
 #endif
-      // Forward prop step
-      model.clear_gradients();
-      model.forward_prop(execution_mode::training);
-      // check if the data coordinator has finished the epoch and kickoff
-      // background I/O
-      finished = dc.epoch_complete(execution_mode::training);
-
-      // Result is not needed until the end of the mini-batch.
-      model.get_objective_function()->start_evaluation(
-        execution_mode::training,
-        c.get_current_mini_batch_size());
-
-      // Backward prop step
-      model.get_objective_function()->differentiate();
-      model.backward_prop();
-      model.get_objective_function()->compute_weight_regularization();
-
-      // Finish evaluation.
-      model.get_objective_function()->finish_evaluation(
-        execution_mode::training,
-        c.get_current_mini_batch_size());
-      model.evaluate_metrics(execution_mode::training,
-                             c.get_current_mini_batch_size());
-
-      // Update step
-      model.update_weights();
-      model.update_layers();
+        // Forward prop step
+        if (micro_batch == 0) {
+          model.clear_gradients();
+        }
+        model.forward_prop(execution_mode::training);
+        // check if the data coordinator has finished the epoch and kickoff
+        // background I/O. The next mini-batch, including any data store
+        // sample exchange, is fetched while backprop and the optimizer
+        // step run. Whatever is left is reported by the data coordinator
+        // as exposed I/O time in the next fetch_data.
+        finished = dc.epoch_complete(execution_mode::training);
+
+        // Only launch gradient allreduces in the last micro-batch of
+        // the step. A step does not cross an epoch boundary.
+        last_micro_batch = (finished || micro_batch + 1 == num_micro_batches);
+        model.defer_gradient_allreduces(!last_micro_batch);
+        if (last_micro_batch) {
+          // Gradients are averaged before callbacks read them at the
+          // end of backprop
+          model.set_gradient_scales(micro_batch + 1);
+        }
+
+        // Result is not needed until the end of the mini-batch.
+        model.get_objective_function()->start_evaluation(
+          execution_mode::training,
+          c.get_current_mini_batch_size());
+
+        // Backward prop step
+        model.get_objective_function()->differentiate();
+        model.backward_prop();
+        model.get_objective_function()->compute_weight_regularization();
+
+        // Finish evaluation.
+        model.get_objective_function()->finish_evaluation(
+          execution_mode::training,
+          c.get_current_mini_batch_size());
+        model.evaluate_metrics(execution_mode::training,
+                               c.get_current_mini_batch_size());
+
+        // Update step
+        // Note: Layers that update themselves, e.g. with sparse SGD,
+        // are updated every micro-batch.
+        if (last_micro_batch) {
+          model.update_weights(micro_batch + 1);
+        }
+        model.update_layers();
 #if defined(LBANN_HAVE_OMP_TASKLOOP)
+      }
     }
-  }
 #endif
+  }
 
   c.inc_step();
   do_batch_end_cbs(model, execution_mode::training);
@@ -436,6 +466,8 @@ lbann::make<lbann::SGDTrainingAlgorithm>(
   default:
     LBANN_ERROR("No stopping criteria specified.");
   }
-  return make_unique<SGDTrainingAlgorithm>(params.name(),
-                                             std::move(stopping));
+  return make_unique<SGDTrainingAlgorithm>(
+    params.name(),
+    std::move(stopping),
+    std::max<size_t>(sgd_params.num_micro_batches(), 1UL));
 }
@@ -33,11 +33,14 @@
 #include <lbann/execution_algorithms/batch_functional_inference_algorithm.hpp>
 #include <lbann/models/directed_acyclic_graph.hpp>
 #include <lbann/models/model.hpp>
+#include <lbann/trainers/trainer.hpp>
 #include <lbann/utils/lbann_library.hpp>
 
 #include <lbann.pb.h>
 #include <google/protobuf/text_format.h>
 
+#include <vector>
+
 namespace pb = ::google::protobuf;
 
 namespace {
@@ -61,6 +64,42 @@ model {
 }
 )ptext";
 
+// The same model, streaming random samples from a synthetic data
+// reader. The number of samples is not a multiple of the mini-batch
+// size, so the last mini-batch is partial.
+std::string const streaming_prototext = R"ptext(
+trainer {
+  mini_batch_size: 4
+}
+data_reader {
+  reader {
+    name: "synthetic"
+    role: "test"
+    shuffle: false
+    num_samples: 10
+    synth_dimensions: "1 1 4"
+    num_labels: 4
+    absolute_sample_count: 0
+    percent_of_data_to_use: 1.0
+  }
+}
+model {
+  layer {
+    name: "layer1"
+    children: "layer2"
+    input {
+      data_field: "samples"
+    }
+  }
+  layer {
+    name: "layer2"
+    parents: "layer1"
+    softmax {
+    }
+  }
+}
+)ptext";
+
 auto mock_datareader_metadata(int class_n)
 {
   lbann::DataReaderMetaData md;
@@ -72,10 +111,12 @@ auto mock_datareader_metadata(int class_n)
 }
 
 template <typename T>
-auto make_model(lbann::lbann_comm& comm, int class_n)
+auto make_model(lbann::lbann_comm& comm,
+                int class_n,
+                std::string const& prototext = model_prototext)
 {
   lbann_data::LbannPB my_proto;
-  if (!pb::TextFormat::ParseFromString(model_prototext, &my_proto))
+  if (!pb::TextFormat::ParseFromString(prototext, &my_proto))
     throw "Parsing protobuf failed.";
   // Construct a trainer so that the model can register the input layer
   lbann::construct_trainer(&comm, my_proto.mutable_trainer(), my_proto);
@@ -132,4 +173,69 @@ TEST_CASE("Test batch_function_inference_algorithm", "[inference]")
       REQUIRE(labels(i) == i);
     }
   }
+
+  SECTION("Verify raw inference outputs")
+  {
+    El::Fill(data, zero);
+    El::FillDiagonal(data, one);
+
+    auto outputs = inf_alg.infer_outputs(model.get(), data, 1, "layer2");
+
+    REQUIRE(outputs.Height() == mbs_class_n);
+    REQUIRE(outputs.Width() == mbs_class_n);
+    for (int j=0; j<outputs.Width(); j++) {
+      DataType sum = zero;
+      for (int i=0; i<outputs.Height(); i++) {
+        sum += outputs(i,j);
+        if (i != j) {
+          REQUIRE(outputs(i,j) < outputs(j,j));
+        }
+      }
+      REQUIRE(sum == Approx(one));
+    }
+  }
+}
+
+TEST_CASE("Test streamed batch_function_inference_algorithm", "[inference]")
+{
+  using DataType = float;
+  int mbs_class_n = 4;
+  El::Int num_samples = 10;
+
+  auto& comm = unit_test::utilities::current_world_comm();
+  std::unique_ptr<lbann::model> model =
+    make_model<DataType>(comm, mbs_class_n, streaming_prototext);
+  auto& dc = lbann::get_trainer().get_data_coordinator();
+  auto inf_alg = lbann::batch_functional_inference_algorithm();
+
+  SECTION("Sample indices line up with streamed outputs")
+  {
+    std::vector<int> index_counts(num_samples, 0);
+    auto handler = [&](El::Matrix<DataType, El::Device::CPU> const& outputs,
+                       El::Matrix<El::Int> const* sample_indices) {
+      REQUIRE(outputs.Height() == mbs_class_n);
+      REQUIRE(sample_indices != nullptr);
+      REQUIRE(sample_indices->Height() == outputs.Width());
+      for (El::Int j = 0; j < outputs.Width(); ++j) {
+        const auto index = sample_indices->Get(j, 0);
+        REQUIRE(index >= 0);
+        REQUIRE(index < num_samples);
+        ++index_counts[index];
+        DataType sum = 0.;
+        for (El::Int i = 0; i < outputs.Height(); ++i) {
+          sum += outputs(i, j);
+        }
+        REQUIRE(sum == Approx(1.0));
+      }
+    };
+
+    auto processed = inf_alg.infer(model.get(), dc,
+                                   lbann::execution_mode::testing, handler,
+                                   "layer2");
+
+    REQUIRE(processed == static_cast<size_t>(num_samples));
+    for (const auto& count : index_counts) {
+      REQUIRE(count == 1);
+    }
+  }
 }
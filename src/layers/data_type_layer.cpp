@@ -76,6 +76,7 @@ operator=(data_type_layer const& other) {
   m_outputs = copy_all(other.m_outputs);
   m_gradient_wrt_outputs = copy_all(other.m_gradient_wrt_outputs);
   m_gradient_wrt_inputs = copy_all(other.m_gradient_wrt_inputs);
+  m_output_aliases.clear();
   m_persistent_error_signals = other.m_persistent_error_signals;
   return *this;
 }
@@ -403,6 +404,79 @@ get_error_signals(const Layer& parent) const -> const InputAbsDistMatrixType& {
   return get_error_signals(parent_index);
 }
 
+template <typename InputTensorDataType, typename OutputTensorDataType>
+void data_type_layer<InputTensorDataType, OutputTensorDataType>::
+discard_outputs()
+{
+  for (auto& output : m_outputs) {
+    if (!output->Viewing()) {
+      output->Empty(true);
+    }
+  }
+}
+
+template <typename InputTensorDataType, typename OutputTensorDataType>
+void data_type_layer<InputTensorDataType, OutputTensorDataType>::
+recompute_outputs()
+{
+  const auto& c = static_cast<SGDExecutionContext&>(
+    m_model->get_execution_context());
+  const auto& mini_batch_size = c.get_current_mini_batch_size();
+  fp_setup_inputs(mini_batch_size);
+  fp_setup_outputs(mini_batch_size);
+  const auto fp_compute_start = get_time();
+  fp_compute();
+  m_fp_compute_time += get_time() - fp_compute_start;
+}
+
+template <typename InputTensorDataType, typename OutputTensorDataType>
+void data_type_layer<InputTensorDataType, OutputTensorDataType>::
+refresh_inputs()
+{
+  const auto& c = static_cast<SGDExecutionContext&>(
+    m_model->get_execution_context());
+  fp_setup_inputs(c.get_current_mini_batch_size());
+}
+
+template <typename InputTensorDataType, typename OutputTensorDataType>
+size_t data_type_layer<InputTensorDataType, OutputTensorDataType>::
+get_output_memory_usage(El::Int mini_batch_size) const
+{
+  size_t bytes = 0;
+  for (int i = 0; i < get_num_children(); ++i) {
+    const auto& output = *m_outputs[i];
+    bytes += (El::MaxLength(get_output_size(i), output.ColStride())
+              * El::MaxLength(mini_batch_size, output.RowStride())
+              * sizeof(OutputTensorDataType));
+  }
+  return bytes;
+}
+
+template <typename InputTensorDataType, typename OutputTensorDataType>
+size_t data_type_layer<InputTensorDataType, OutputTensorDataType>::
+get_error_signal_memory_usage(El::Int mini_batch_size) const
+{
+  size_t bytes = 0;
+  for (int i = 0; i < get_num_parents(); ++i) {
+    const auto& input = *m_inputs[i];
+    bytes += (El::MaxLength(get_input_size(i), input.ColStride())
+              * El::MaxLength(mini_batch_size, input.RowStride())
+              * sizeof(InputTensorDataType));
+  }
+  return bytes;
+}
+
+template <typename InputTensorDataType, typename OutputTensorDataType>
+void data_type_layer<InputTensorDataType, OutputTensorDataType>::
+set_output_alias(const Layer& child, BaseDistMat* target, El::Int row_offset)
+{
+  const size_t child_index = find_child_layer_index(child);
+  if (m_output_aliases.size() < static_cast<size_t>(get_num_children())) {
+    m_output_aliases.resize(get_num_children(), {nullptr, 0});
+  }
+  m_output_aliases[child_index] = {target, row_offset};
+}
+
 template <typename InputTensorDataType, typename OutputTensorDataType>
 void data_type_layer<InputTensorDataType, OutputTensorDataType>::
 set_keep_error_signals(bool flag)
@@ -796,7 +870,16 @@ fp_setup_inputs(El::Int mini_batch_size) {
     if(!this->is_subgraph_parallelism_enabled()){
       input.AlignWith(alignment_dist);
     }
-    view_or_copy_tensor(parent_output, input);
+    const auto* strided_output =
+      dynamic_cast<const InputAbsDistMatrixType*>(&parent_output);
+    if (!supports_strided_tensors()
+        && strided_output != nullptr
+        && !strided_output->LockedMatrix().Contiguous()) {
+      do_tensor_copy(parent_output, input);
+    }
+    else {
+      view_or_copy_tensor(parent_output, input);
+    }
 
     // Check input matrix dimensions
     const auto& height = get_input_size(i);
@@ -837,6 +920,29 @@ fp_setup_outputs(El::Int mini_batch_size) {
     if (align_outputs) {
       output.AlignWith(alignment_dist);
     }
+
+    // Write directly into alias target if it is compatible
+    // Note: The target is never resized here since sibling layers
+    // may be viewing it, possibly from other threads.
+    if (static_cast<size_t>(i) < m_output_aliases.size()
+        && m_output_aliases[i].first != nullptr) {
+      auto* target = dynamic_cast<OutputAbsDistMatrixType*>(
+        m_output_aliases[i].first);
+      const auto& row_offset = m_output_aliases[i].second;
+      const El::Int height = get_output_size(i);
+      if (target != nullptr
+          && supports_strided_tensors()
+          && !target->Viewing()
+          && target->Height() >= row_offset + height
+          && target->Width() >= mini_batch_size
+          && target->DistData() == output.DistData()) {
+        El::View(output, *target,
+                 El::IR(row_offset, row_offset + height),
+                 El::IR(0, mini_batch_size));
+        continue;
+      }
+    }
+
     output.Resize(get_output_size(i), mini_batch_size);
   }
 
@@ -902,18 +1008,15 @@ move_or_copy_prev_error_signal_(
       m_name, child.get_name());
   }
 
-  // If the distribution is OK, then we can just swap data
-  // around. Otherwise, deep copy into correct distribution.
+  // If the distribution and data type are OK, then we can just swap
+  // data around. Otherwise, deep copy into correct distribution and
+  // data type, e.g. at the boundary between layers that compute in
+  // different precisions.
   El::DistData expected_distdata = m_outputs[layer_idx]->DistData();
-  if (signal.DistData() == expected_distdata) {
-    if (auto sig_ptr = dynamic_cast<OutputAbsDistMatrixType*>(signal_in.get())) {
-      signal_in.release();
-      m_gradient_wrt_outputs[layer_idx].reset(sig_ptr);
-    }
-    else {
-      LBANN_ERROR("Logic error: DistData objects compare equal "
-                  "but matrices have different dynamic types.");
-    }
+  auto sig_ptr = dynamic_cast<OutputAbsDistMatrixType*>(signal_in.get());
+  if (sig_ptr != nullptr && signal.DistData() == expected_distdata) {
+    signal_in.release();
+    m_gradient_wrt_outputs[layer_idx].reset(sig_ptr);
   }
   else // Deep copy
   {
@@ -145,6 +145,25 @@ base_convolution_layer<TensorDataType,Device>
 }
 #endif // LBANN_HAS_DNN_LIB
 
+template <typename TensorDataType, El::Device Device>
+size_t
+base_convolution_layer<TensorDataType,Device>::get_workspace_memory_usage(
+  El::Int mini_batch_size) const {
+  if (this->using_gpus()) { return 0; }
+  const auto& kernel_dims = this->get_kernel_dims();
+  const size_t kernel_size = std::accumulate(kernel_dims.begin(),
+                                             kernel_dims.end(),
+                                             size_t{1},
+                                             std::multiplies<size_t>());
+  const size_t input_spatial_size = (this->get_input_size()
+                                     / this->get_input_dims()[0]);
+  const size_t output_spatial_size = (this->get_output_size()
+                                      / this->get_output_dims()[0]);
+  return ((kernel_size / kernel_dims[0])
+          * std::max(input_spatial_size, output_spatial_size)
+          * sizeof(TensorDataType));
+}
+
 template <typename TensorDataType, El::Device Device>
 description
 base_convolution_layer<TensorDataType,Device>::get_description() const {
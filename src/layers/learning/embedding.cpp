@@ -29,12 +29,6 @@
 
 namespace lbann {
 
-template <typename TensorDataType, data_layout Layout, El::Device Device>
-void embedding_layer<TensorDataType,Layout,Device>::setup_matrices(const El::Grid& grid) {
-  data_type_layer<TensorDataType>::setup_matrices(grid);
-  this->m_embeddings_grad.reset(new El::DistMatrix<TensorDataType, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>(grid));
-}
-
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 void embedding_layer<TensorDataType,Layout,Device>::fp_compute() {
   using MatType = El::Matrix<TensorDataType, El::Device::CPU>;
@@ -68,7 +62,6 @@ void embedding_layer<TensorDataType,Layout,Device>::fp_compute() {
 template <typename TensorDataType, data_layout Layout, El::Device Device>
 void embedding_layer<TensorDataType, Layout, Device>::bp_compute() {
   using MatType = El::Matrix<TensorDataType, El::Device::CPU>;
-  const TensorDataType one = El::TypeTraits<TensorDataType>::One();
 
   // Embedding layer is not differentiable w.r.t. inputs
   El::Zero(this->get_error_signals());
@@ -77,16 +70,22 @@ void embedding_layer<TensorDataType, Layout, Device>::bp_compute() {
   if (this->get_weights(0).get_optimizer() == nullptr) { return; }
   auto& opt = *this->get_weights(0).get_optimizer();
 
+  // Accumulate directly into the optimizer's gradient buffer
+  // Note: Layers that share the embeddings all add to the same
+  // buffer, so no per-layer gradient matrix is needed.
+  TensorDataType buf_scale, in_scale;
+  auto& embeddings_grad = opt.get_gradient_buffer(buf_scale, in_scale, true);
+  El::Scale(buf_scale, embeddings_grad);
+
   // Local data
   const auto& local_input = dynamic_cast<const MatType&>(this->get_local_prev_activations());
-  auto& local_embedding_grad = dynamic_cast<MatType&>(this->m_embeddings_grad->Matrix());
+  auto& local_embedding_grad = dynamic_cast<MatType&>(embeddings_grad.Matrix());
   const auto& local_output_grad = dynamic_cast<const MatType&>(this->get_local_prev_error_signals());
   const size_t input_size = this->get_input_size();
   const size_t local_mini_batch_size = local_input.Width();
 
   // Update gradient w.r.t. embeddings
   // Note: Don't update gradient for padding index
-  El::Zero(local_embedding_grad);
   MatType embedding_grad_v, output_grad_v;
   for (size_t j=0; j<local_mini_batch_size; ++j) {
     for (size_t i=0; i<input_size; ++i) {
@@ -98,11 +97,10 @@ void embedding_layer<TensorDataType, Layout, Device>::bp_compute() {
                        El::IR(j));
         El::View(embedding_grad_v, local_embedding_grad,
                  El::ALL, El::IR(ind));
-        El::Axpy(one, output_grad_v, embedding_grad_v);
+        El::Axpy(in_scale, output_grad_v, embedding_grad_v);
       }
     }
   }
-  opt.add_to_gradient(*this->m_embeddings_grad, El::TypeTraits<TensorDataType>::One(), true);
 
 }
 
@@ -83,6 +83,7 @@ __global__ void bp_kernel(El::Int num_embeddings,
                           El::Int input_size,
                           El::Int mini_batch_size,
                           El::Int padding_idx,
+                          TensorDataType scale,
                           const TensorDataType* __restrict__ indices,
                           El::Int indices_ldim,
                           const TensorDataType* __restrict__ output_grad,
@@ -102,7 +103,7 @@ __global__ void bp_kernel(El::Int num_embeddings,
         if (0<=ind && ind<num_embeddings && ind!=padding_idx) {
           const auto& dy = output_grad[i+j*embedding_dim+k*output_grad_ldim];
           auto& dw = embeddings_grad[i+ind*embeddings_grad_ldim];
-          gpu_lib::atomic_add(&dw, dy);
+          gpu_lib::atomic_add(&dw, scale * dy);
         }
       }
     }
@@ -111,12 +112,6 @@ __global__ void bp_kernel(El::Int num_embeddings,
 
 } // namespace
 
-template <typename TensorDataType, data_layout T_layout, El::Device Dev>
-void embedding_layer<TensorDataType, T_layout, Dev>::setup_matrices(const El::Grid& grid) {
-  data_type_layer<TensorDataType>::setup_matrices(grid);
-  this->m_embeddings_grad.reset(new El::DistMatrix<TensorDataType, El::STAR, El::STAR, El::ELEMENT, El::Device::GPU>(grid));
-}
-
 template <typename TensorDataType, data_layout T_layout, El::Device Dev>
 void embedding_layer<TensorDataType, T_layout, Dev>::fp_compute() {
   using MatType = El::Matrix<TensorDataType, El::Device::GPU>;
@@ -167,15 +162,21 @@ void embedding_layer<TensorDataType, T_layout, Dev>::bp_compute() {
   if (this->get_weights(0).get_optimizer() == nullptr) { return; }
   auto& opt = *this->get_weights(0).get_optimizer();
 
+  // Accumulate directly into the optimizer's gradient buffer
+  // Note: Layers that share the embeddings all add to the same
+  // buffer, so no per-layer gradient matrix is needed.
+  TensorDataType buf_scale, in_scale;
+  auto& embeddings_grad = opt.get_gradient_buffer(buf_scale, in_scale, true);
+  El::Scale(buf_scale, embeddings_grad);
+
   // Local data
   const auto& local_input = dynamic_cast<const MatType&>(this->get_local_prev_activations());
-  auto& local_embedding_grad = dynamic_cast<MatType&>(this->m_embeddings_grad->Matrix());
+  auto& local_embedding_grad = dynamic_cast<MatType&>(embeddings_grad.Matrix());
   const auto& local_output_grad = dynamic_cast<const MatType&>(this->get_local_prev_error_signals());
   const auto& input_size = this->get_input_size();
   const auto& local_mini_batch_size = local_input.Width();
 
   // Launch GPU kernel
-  El::Zero(local_embedding_grad);
   if (!local_input.IsEmpty()) {
     auto multisync =
       El::MakeMultiSync(gpu::get_sync_info(local_embedding_grad),
@@ -195,6 +196,7 @@ void embedding_layer<TensorDataType, T_layout, Dev>::bp_compute() {
       input_size,
       local_mini_batch_size,
       this->m_padding_idx,
+      in_scale,
       local_input.LockedBuffer(),
       local_input.LDim(),
       local_output_grad.LockedBuffer(),
@@ -202,9 +204,6 @@ void embedding_layer<TensorDataType, T_layout, Dev>::bp_compute() {
       local_embedding_grad.Buffer(),
       local_embedding_grad.LDim());
   }
-  opt.add_to_gradient(*this->m_embeddings_grad,
-                      El::TypeTraits<TensorDataType>::One(),
-                      true);
 }
 
 // Explicit instantiation
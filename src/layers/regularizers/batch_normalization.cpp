@@ -34,6 +34,54 @@ namespace lbann {
 template <typename TensorDataType, data_layout T_layout, El::Device Dev>
 void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute() {
   const TensorDataType zero = El::TypeTraits<TensorDataType>::Zero();
+  const bool is_training = this->m_model->get_execution_context().get_execution_mode() == execution_mode::training;
+
+  // Compute local sums and sums of squares
+  if (is_training) {
+    const auto& local_input = this->get_local_prev_activations();
+    auto& local_mean = this->m_mean_v->Matrix();
+    auto& local_var = this->m_var_v->Matrix();
+    const auto& local_width = local_input.Width();
+    const auto& num_channels = this->get_output_dims()[0];
+    const auto& channel_size = this->get_output_size() / num_channels;
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int channel = 0; channel < num_channels; ++channel) {
+      TensorDataType sum = zero;
+      TensorDataType sqsum = zero;
+      const auto& row_start = channel * channel_size;
+      const auto& row_end = (channel+1) * channel_size;
+      for (El::Int col = 0; col < local_width; ++col) {
+        for (El::Int row = row_start; row < row_end; ++row) {
+          const auto& x = local_input(row, col);
+          sum += x;
+          sqsum += x * x;
+        }
+      }
+      local_mean(channel, 0) = sum;
+      local_var(channel, 0) = sqsum;
+    }
+    this->m_statistics_pending = true;
+
+    // With a split forward prop, the model sums the statistics and
+    // calls finish_forward_prop
+    if (this->m_split_forward_prop && this->m_statistics_group_size != 1) {
+      return;
+    }
+
+    // Global or grouped batchnorm; allreduce on fused buffer.
+    if (this->m_statistics_group_size != 1) {
+      this->get_comm()->allreduce(*this->m_mean_and_var,
+                                  this->get_statistics_comm(),
+                                  El::mpi::SUM);
+    }
+  }
+
+  finish_forward_prop();
+
+}
+
+template <typename TensorDataType, data_layout T_layout, El::Device Dev>
+void batch_normalization_layer<TensorDataType, T_layout, Dev>::finish_forward_prop() {
   const TensorDataType one = El::TypeTraits<TensorDataType>::One();
   const bool is_training = this->m_model->get_execution_context().get_execution_mode() == execution_mode::training;
 
@@ -51,6 +99,13 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute() {
 
   // Compute statistics
   if (is_training) {
+    if (!this->m_statistics_pending) { return; }
+    if (this->m_statistics_allreduce_started) {
+      this->get_comm()->wait(this->m_statistics_allreduce_req);
+      this->m_statistics_allreduce_started = false;
+    }
+    this->m_statistics_pending = false;
+
     using ValuesGetter = weights_details::SafeWeightsAccessor<TensorDataType>;
     // Local matrices
     auto& local_mean = this->m_mean_v->Matrix();
@@ -59,37 +114,15 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute() {
       ValuesGetter::mutable_values(this->get_weights(2)).Matrix();
     auto& local_running_var =
       ValuesGetter::mutable_values(this->get_weights(3)).Matrix();
-    // Compute sums and sums of squares
-    LBANN_OMP_PARALLEL_FOR
-    for (El::Int channel = 0; channel < num_channels; ++channel) {
-      TensorDataType sum = zero;
-      TensorDataType sqsum = zero;
-      const auto& row_start = channel * channel_size;
-      const auto& row_end = (channel+1) * channel_size;
-      for (El::Int col = 0; col < local_width; ++col) {
-        for (El::Int row = row_start; row < row_end; ++row) {
-          const auto& x = local_input(row, col);
-          sum += x;
-          sqsum += x * x;
-        }
-      }
-      local_mean(channel, 0) = sum;
-      local_var(channel, 0) = sqsum;
-    }
     El::Int num_per_sum;
     if (this->m_statistics_group_size == 0) {
-      // Global statistics aggregation; allreduce on fused buffer.
-      this->get_comm()->allreduce(*this->m_mean_and_var, this->m_mean_and_var->RedundantComm(),
-                        El::mpi::SUM);
+      // Global statistics aggregation.
       num_per_sum = channel_size * width;
     } else if (this->m_statistics_group_size == 1) {
-      // Local aggregation, no allreduce needed.
+      // Local aggregation.
       num_per_sum = channel_size * local_width;
     } else {
-      // Grouped batchnorm. Allreduce on fused buffer.
-      this->get_comm()->allreduce(*this->m_mean_and_var,
-                        this->get_comm()->get_packed_group_comm(this->m_statistics_group_size),
-                        El::mpi::SUM);
+      // Grouped batchnorm.
       if (this->m_num_per_sum_cache.count(width) == 0) {
         num_per_sum = channel_size * local_width;
         num_per_sum = this->get_comm()->allreduce(
@@ -120,6 +153,7 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute() {
         running_var = this->m_decay * running_var + (one - this->m_decay) * var;
       }
     }
+    this->sync_running_statistics();
 
   }
 
@@ -543,6 +543,7 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute() {
         local_mean.Buffer(), local_var.Buffer(),
         local_running_mean.Buffer(), local_running_var.Buffer());
     }
+    this->sync_running_statistics();
 
   }
 
@@ -582,6 +583,11 @@ void batch_normalization_layer<TensorDataType, T_layout, Dev>::fp_compute() {
 
 }
 
+template <typename TensorDataType, data_layout T_layout, El::Device Dev>
+void batch_normalization_layer<TensorDataType, T_layout, Dev>::finish_forward_prop() {
+  // Forward prop is not split on GPU
+}
+
 template <typename TensorDataType, data_layout T_layout, El::Device Dev>
 void batch_normalization_layer<TensorDataType, T_layout, Dev>::bp_compute() {
 #ifdef LBANN_HAS_DISTCONV
@@ -39,7 +39,8 @@ batch_normalization_layer<TensorDataType,Layout,Device>
                         ::cereal::base_class<DataTypeLayer>(this)),
      CEREAL_NVP(m_decay),
      CEREAL_NVP(m_epsilon),
-     CEREAL_NVP(m_statistics_group_size));
+     CEREAL_NVP(m_statistics_group_size),
+     CEREAL_NVP(m_running_statistics_sync_interval));
 }
 
 } // namespace lbann
@@ -37,7 +37,8 @@ dropout<TensorDataType,Layout,Device>
   using DataTypeLayer = data_type_layer<TensorDataType>;
   ar(::cereal::make_nvp("DataTypeLayer",
                         ::cereal::base_class<DataTypeLayer>(this)),
-     CEREAL_NVP(m_keep_prob));
+     CEREAL_NVP(m_keep_prob),
+     CEREAL_NVP(m_mask));
 }
 
 } // namespace lbann
@@ -40,7 +40,8 @@ selu_dropout<TensorDataType,Layout,Device>
      CEREAL_NVP(m_alpha_prime),
      CEREAL_NVP(m_a),
      CEREAL_NVP(m_b),
-     CEREAL_NVP(m_keep_prob));
+     CEREAL_NVP(m_keep_prob),
+     CEREAL_NVP(m_mask));
 }
 
 } // namespace lbann
@@ -36,7 +36,8 @@ std::unique_ptr<Layer> build_dropout_layer_from_pbuf(
 {
   const auto& params = layer_msg.dropout();
   return lbann::make_unique<dropout_layer<TensorDataType, layout, device>>(
-    params.keep_prob());
+    params.keep_prob(),
+    params.recompute_mask());
 }
 
 #define PROTO_DEVICE(T, Device)                                         \
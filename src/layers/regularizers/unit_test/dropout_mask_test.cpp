@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <catch2/catch.hpp>
+
+#include "MPITestHelpers.hpp"
+
+#include <lbann/base.hpp>
+#include <lbann/layers/regularizers/dropout_mask.hpp>
+#include <lbann/utils/random.hpp>
+#include <lbann/utils/serialize.hpp>
+
+TEST_CASE("Dropout mask", "[mpi][layer][dropout]")
+{
+  using StarMatType = El::DistMatrix<float, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>;
+  using DistMatType = El::DistMatrix<float, El::MC, El::MR, El::ELEMENT, El::Device::CPU>;
+
+  auto& comm = ::unit_test::utilities::current_world_comm();
+  const auto& grid = comm.get_trainer_grid();
+  lbann::init_random(20211110, 0, &comm);
+
+  const El::Int height = 67;
+  const El::Int width = 45;
+  const double keep_prob = 0.8;
+
+  // Record the mask of each local entry
+  auto record = [](const El::AbstractDistMatrix<float>& mat,
+                   lbann::dropout_mask& mask,
+                   bool generate) {
+    StarMatType local(mat.Height(), mat.Width(), mat.Grid());
+    El::Zero(local);
+    El::Matrix<float, El::Device::CPU> keep(mat.LocalHeight(), mat.LocalWidth());
+    auto f = [&keep](El::Int row, El::Int col, bool k) {
+      keep(row, col) = k ? 1.f : 0.f;
+    };
+    if (generate) {
+      mask.generate(mat, f);
+    }
+    else {
+      mask.apply(mat, f);
+    }
+    for (El::Int col = 0; col < mat.LocalWidth(); ++col) {
+      for (El::Int row = 0; row < mat.LocalHeight(); ++row) {
+        local.Set(mat.GlobalRow(row), mat.GlobalCol(col), keep(row, col));
+      }
+    }
+    El::AllReduce(local, mat.DistComm());
+    return local;
+  };
+
+  DistMatType dist_mat(height, width, grid);
+  StarMatType star_mat(height, width, grid);
+
+  SECTION("Stored and recomputed masks match the generated mask")
+  {
+    for (bool recompute : {false, true}) {
+      lbann::dropout_mask mask;
+      mask.set_recompute(recompute);
+      mask.draw("layer", keep_prob);
+      auto generated = record(dist_mat, mask, true);
+      auto applied = record(dist_mat, mask, false);
+      for (El::Int col = 0; col < width; ++col) {
+        for (El::Int row = 0; row < height; ++row) {
+          REQUIRE(generated.GetLocal(row, col) == applied.GetLocal(row, col));
+        }
+      }
+      if (recompute) {
+        CHECK(mask.get_stored_bytes() == 0);
+      }
+    }
+  }
+
+  SECTION("Mask does not depend on the distribution")
+  {
+    lbann::dropout_mask dist_mask, star_mask;
+    dist_mask.draw("layer", keep_prob);
+    star_mask.draw("layer", keep_prob);
+    auto from_dist = record(dist_mat, dist_mask, true);
+    auto from_star = record(star_mat, star_mask, true);
+    double kept = 0;
+    for (El::Int col = 0; col < width; ++col) {
+      for (El::Int row = 0; row < height; ++row) {
+        REQUIRE(from_dist.GetLocal(row, col) == from_star.GetLocal(row, col));
+        kept += from_star.GetLocal(row, col);
+      }
+    }
+    CHECK(kept / (height * width) == Approx(keep_prob).margin(0.05));
+  }
+
+  SECTION("Successive masks differ")
+  {
+    lbann::dropout_mask mask;
+    mask.draw("layer", keep_prob);
+    auto first = record(star_mat, mask, true);
+    mask.draw("layer", keep_prob);
+    auto second = record(star_mat, mask, true);
+    El::Int num_diff = 0;
+    for (El::Int col = 0; col < width; ++col) {
+      for (El::Int row = 0; row < height; ++row) {
+        num_diff += (first.GetLocal(row, col) != second.GetLocal(row, col));
+      }
+    }
+    CHECK(num_diff > 0);
+  }
+
+#ifdef LBANN_HAS_CEREAL_BINARY_ARCHIVES
+  SECTION("Restored mask continues the sequence of masks")
+  {
+    lbann::dropout_mask mask, restored;
+    mask.draw("layer", keep_prob);
+    std::stringstream ss;
+    {
+      cereal::BinaryOutputArchive oarchive(ss);
+      REQUIRE_NOTHROW(oarchive(mask));
+    }
+    {
+      cereal::BinaryInputArchive iarchive(ss);
+      REQUIRE_NOTHROW(iarchive(restored));
+    }
+    mask.draw("layer", keep_prob);
+    restored.draw("layer", keep_prob);
+    auto expected = record(star_mat, mask, true);
+    auto actual = record(star_mat, restored, true);
+    for (El::Int col = 0; col < width; ++col) {
+      for (El::Int row = 0; row < height; ++row) {
+        REQUIRE(expected.GetLocal(row, col) == actual.GetLocal(row, col));
+      }
+    }
+  }
+#endif // LBANN_HAS_CEREAL_BINARY_ARCHIVES
+}
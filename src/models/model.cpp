@@ -50,7 +50,12 @@
 #include <optimizers.pb.h>
 
 #include <mpi.h>
+#include <omp.h>
 
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <future>
 #include <string>
 #include <unistd.h>
 #include <iomanip>
@@ -89,7 +94,12 @@ model::model(const model& other) :
   m_execution_context(other.m_execution_context),
   m_comm(other.m_comm),
   m_name(other.m_name),
-  m_model_is_setup(false) {
+  m_model_is_setup(false),
+  m_layer_parallel_threads(other.m_layer_parallel_threads),
+  m_recompute_layer_names(other.m_recompute_layer_names),
+  m_recompute_layer_types(other.m_recompute_layer_types),
+  m_recompute_interval(other.m_recompute_interval),
+  m_statistics_reduction(other.m_statistics_reduction) {
 
   // Deep copies
   m_default_optimizer_msg = (other.m_default_optimizer_msg
@@ -148,6 +158,11 @@ model& model::operator=(const model& other) {
   m_comm = other.m_comm;
   m_name = other.m_name;
   m_model_is_setup = false;
+  m_layer_parallel_threads = other.m_layer_parallel_threads;
+  m_recompute_layer_names = other.m_recompute_layer_names;
+  m_recompute_layer_types = other.m_recompute_layer_types;
+  m_recompute_interval = other.m_recompute_interval;
+  m_statistics_reduction = other.m_statistics_reduction;
 
   // Deep copies
   m_execution_context  = other.m_execution_context;
@@ -642,6 +657,9 @@ void model::setup(size_t max_mini_batch_size, DataReaderMetaData& dr_metadata, b
 
   // Setup weights
   setup_weights();
+  setup_layer_parallel_execution();
+  setup_activation_recomputation(max_mini_batch_size);
+  setup_statistics_reduction();
 
   // Setup objective function
   m_objective_function->setup(*this);
@@ -668,6 +686,61 @@ void model::setup(size_t max_mini_batch_size, DataReaderMetaData& dr_metadata, b
   m_model_is_setup = true;
 }
 
+size_t model::setup_inference(size_t max_mini_batch_size,
+                              DataReaderMetaData& dr_metadata) {
+
+  // Release optimizers so that weights setup does not allocate
+  // gradients or optimizer state. Record how many weights-sized
+  // buffers each optimizer would have allocated in setup.
+  std::unordered_map<const weights*, size_t> num_state_buffers;
+  for (auto* w : get_weights()) {
+    const auto* opt = w->get_optimizer();
+    num_state_buffers[w] = (opt == nullptr ? 0 : opt->get_num_state_buffers());
+    w->set_optimizer(nullptr);
+    w->freeze();
+  }
+  size_t default_num_state_buffers = 0;
+  if (const auto opt = create_optimizer<DataType>()) {
+    default_num_state_buffers = opt->get_num_state_buffers();
+  }
+  m_default_optimizer_msg.reset();
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    get_layer(i).freeze();
+  }
+
+  setup(max_mini_batch_size, dr_metadata);
+
+  // Freeze weights created during layer setup
+  for (auto* w : get_weights()) { w->freeze(); }
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    get_layer(i).freeze();
+  }
+
+  // Estimate optimizer memory that was never allocated
+  // Note: Weights created during layer setup would have received the
+  // default optimizer.
+  size_t num_params = 0;
+  size_t saved_bytes = 0;
+  for (const auto* w : get_weights()) {
+    num_params += w->get_size();
+    const auto iter = num_state_buffers.find(w);
+    const auto num_buffers = (iter != num_state_buffers.end()
+                              ? iter->second
+                              : default_num_state_buffers);
+    saved_bytes += num_buffers * w->get_values_memory_usage();
+  }
+  const auto total_saved = m_comm->trainer_allreduce(double(saved_bytes));
+  if (m_comm->am_trainer_master()) {
+    std::cout << "model \"" << get_name() << "\" set up for inference "
+              << "(" << num_params << " parameters): "
+              << "no gradients or optimizer state allocated, "
+              << "saving an estimated " << total_saved / (1024*1024)
+              << " MiB" << std::endl;
+  }
+
+  return saved_bytes;
+}
+
 void model::setup_layer_topology() {
 
   // Check that layer list is valid
@@ -1583,6 +1656,427 @@ void model::setup_weights() {
 
 }
 
+void model::setup_layer_parallel_execution() {
+  m_layer_waves.clear();
+  m_layer_wave_omp_threads.clear();
+  m_layer_thread_pool.reset();
+  if (m_layer_parallel_threads <= 1) { return; }
+
+  // Layers may only run concurrently if they do not communicate
+  // within the trainer and do not share device streams
+  std::string reason;
+  if (m_comm->get_procs_per_trainer() != 1) {
+    reason = "the trainer has more than one process";
+  }
+  else if (is_subgraph_parallelism_enabled()) {
+    reason = "subgraph parallelism is enabled";
+  }
+  for (El::Int i = 0; i < get_num_layers() && reason.empty(); ++i) {
+    const auto& l = get_layer(i);
+    if (l.get_device_allocation() != El::Device::CPU) {
+      reason = l.get_type() + " layer \"" + l.get_name() + "\" is not on CPU";
+    }
+  }
+  if (!reason.empty()) {
+    LBANN_WARNING("model \"", get_name(), "\" will run layers one at a time ",
+                  "since ", reason);
+    return;
+  }
+
+  // Put each layer in the first wave after its parents. Layers that
+  // share weights are put in different waves since they accumulate
+  // into the same gradient. Layers that draw random numbers are put
+  // in different waves, in layer order, so they draw in the same
+  // order as when layers are run one at a time.
+  std::unordered_map<const Layer*, size_t> layer_wave;
+  std::unordered_map<const weights*, size_t> weights_wave;
+  size_t next_random_wave = 0;
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    const auto& l = get_layer(i);
+    size_t wave = 0;
+    for (const auto* parent : l.get_parent_layers()) {
+      auto it = layer_wave.find(parent);
+      if (it == layer_wave.end()) {
+        LBANN_ERROR("layer \"", l.get_name(), "\" precedes its parent ",
+                    "layer \"", parent->get_name(), "\" ",
+                    "in the execution order of model \"", get_name(), "\"");
+      }
+      wave = std::max(wave, it->second + 1);
+    }
+    for (size_t j = 0; j < l.num_weights(); ++j) {
+      auto it = weights_wave.find(&l.get_weights(j));
+      if (it != weights_wave.end()) {
+        wave = std::max(wave, it->second + 1);
+      }
+    }
+    if (l.uses_random_number_generators()) {
+      wave = std::max(wave, next_random_wave);
+      next_random_wave = wave + 1;
+    }
+    layer_wave[&l] = wave;
+    for (size_t j = 0; j < l.num_weights(); ++j) {
+      weights_wave[&l.get_weights(j)] = wave;
+    }
+    if (wave >= m_layer_waves.size()) { m_layer_waves.resize(wave+1); }
+    m_layer_waves[wave].push_back(i);
+  }
+
+  // Split the OpenMP threads among the layers that run concurrently
+  const int omp_threads = omp_get_max_threads();
+  size_t max_width = 1;
+  for (const auto& wave : m_layer_waves) {
+    size_t width = 0;
+    for (const auto& i : wave) {
+      if (!runs_on_calling_thread(get_layer(i))) {
+        ++width;
+      }
+    }
+    width = std::min(std::max(width, size_t{1}), m_layer_parallel_threads);
+    max_width = std::max(max_width, width);
+    m_layer_wave_omp_threads.push_back(std::max(omp_threads / int(width), 1));
+  }
+
+  // Nothing to run concurrently
+  if (max_width <= 1) {
+    m_layer_waves.clear();
+    m_layer_wave_omp_threads.clear();
+    return;
+  }
+
+  // The calling thread runs one layer of each wave
+  m_layer_thread_pool = make_unique<thread_pool>(
+    std::min(max_width, m_layer_parallel_threads) - 1);
+
+}
+
+void model::setup_activation_recomputation(size_t max_mini_batch_size) {
+  m_recompute_discard_after.clear();
+  m_discarded_layers.clear();
+  if (m_recompute_layer_names.empty()
+      && m_recompute_layer_types.empty()
+      && m_recompute_interval == 0) {
+    return;
+  }
+  if (is_subgraph_parallelism_enabled()) {
+    LBANN_WARNING("model \"", get_name(), "\" will not recompute ",
+                  "activations since subgraph parallelism is enabled");
+    return;
+  }
+
+  // Layer types are matched case-insensitively, with spaces and
+  // underscores treated alike (e.g. "leaky_relu")
+  auto normalize_type = [](std::string type) {
+    for (auto& c : type) {
+      c = (c == ' ' ? '_' : std::tolower(static_cast<unsigned char>(c)));
+    }
+    return type;
+  };
+  std::set<std::string> types;
+  for (const auto& type : m_recompute_layer_types) {
+    types.insert(normalize_type(type));
+  }
+
+  // Discard outputs after the last child has run forward prop
+  const El::Int num_layers = get_num_layers();
+  std::unordered_map<const Layer*, size_t> discard_index;
+  for (El::Int i = 0; i < num_layers; ++i) {
+    discard_index[&get_layer(i)] = i;
+  }
+  for (size_t wave = 0; wave < m_layer_waves.size(); ++wave) {
+    for (const auto& i : m_layer_waves[wave]) {
+      discard_index[&get_layer(i)] = wave;
+    }
+  }
+  m_recompute_discard_after.resize(m_layer_waves.empty()
+                                   ? num_layers
+                                   : m_layer_waves.size());
+
+  // Choose layers to recompute
+  auto unmatched_names = m_recompute_layer_names;
+  // Note: The interval counts eligible layers, so that every k-th
+  // eligible layer is kept as a checkpoint.
+  size_t num_eligible = 0;
+  size_t num_recomputed = 0;
+  size_t saved_bytes = 0;
+  for (El::Int i = 0; i < num_layers; ++i) {
+    auto& l = get_layer(i);
+    const bool named = (unmatched_names.erase(l.get_name()) > 0);
+    bool eligible = (l.can_recompute_outputs()
+                     && l.get_num_parents() > 0
+                     && l.get_num_children() > 0);
+#ifdef LBANN_HAS_DISTCONV
+    eligible = eligible && !l.distconv_enabled();
+#endif // LBANN_HAS_DISTCONV
+    if (!eligible) {
+      if (named) {
+        LBANN_ERROR("layer \"", l.get_name(), "\" (", l.get_type(), ") ",
+                    "in model \"", get_name(), "\" ",
+                    "cannot recompute its outputs");
+      }
+      continue;
+    }
+    const auto eligible_index = num_eligible++;
+    const bool chosen = (named
+                         || types.count(normalize_type(l.get_type())) > 0
+                         || (m_recompute_interval > 0
+                             && eligible_index % m_recompute_interval != 0));
+    if (!chosen) { continue; }
+    size_t last_child = discard_index.at(&l);
+    for (const auto* child : l.get_child_layers()) {
+      last_child = std::max(last_child, discard_index.at(child));
+    }
+    m_recompute_discard_after[last_child].push_back(&l);
+    ++num_recomputed;
+    saved_bytes += l.get_output_memory_usage(max_mini_batch_size);
+  }
+  if (!unmatched_names.empty()) {
+    LBANN_ERROR("could not find layer \"", *unmatched_names.begin(), "\" ",
+                "to recompute in model \"", get_name(), "\"");
+  }
+
+  // Report memory saved versus recompute cost
+  const auto total_saved = m_comm->trainer_allreduce(double(saved_bytes));
+  if (m_comm->am_trainer_master()) {
+    std::cout << "model \"" << get_name() << "\" recomputes the outputs of "
+              << num_recomputed << " of " << num_layers << " layers "
+              << "in backprop: saves up to "
+              << total_saved / (1024*1024) << " MiB of activations "
+              << "per trainer at mini-batch size " << max_mini_batch_size
+              << " at the cost of repeating their forward prop" << std::endl;
+  }
+  if (num_recomputed == 0) {
+    m_recompute_discard_after.clear();
+  }
+
+}
+
+void model::discard_recomputed_outputs(size_t index) {
+  if (index >= m_recompute_discard_after.size()) { return; }
+  for (auto* l : m_recompute_discard_after[index]) {
+
+    // Skip layers whose outputs are views into other tensors or are
+    // viewed by the outputs of their children, since those views
+    // would outlive the discarded outputs
+    bool has_views = false;
+    for (const auto* child : l->get_child_layers()) {
+      has_views = has_views || l->get_activations(*child).Viewing();
+      for (const auto* grandchild : child->get_child_layers()) {
+        has_views = (has_views
+                     || child->get_activations(*grandchild).Viewing());
+      }
+    }
+    if (has_views) { continue; }
+
+    l->discard_outputs();
+    m_discarded_layers.insert(l);
+  }
+}
+
+void model::recompute_parent_outputs(Layer& l) {
+  if (m_discarded_layers.empty()) { return; }
+  for (const auto* parent_ptr : l.get_parent_layers()) {
+    if (m_discarded_layers.erase(parent_ptr) == 0) { continue; }
+    auto& parent = const_cast<Layer&>(*parent_ptr);
+    recompute_parent_outputs(parent);
+    parent.recompute_outputs();
+    for (const auto* child : parent.get_child_layers()) {
+      const_cast<Layer&>(*child).refresh_inputs();
+    }
+  }
+}
+
+void model::setup_statistics_reduction() {
+  m_split_finish_before.clear();
+  m_split_pending_layers.clear();
+  m_split_unreduced_layers.clear();
+  const El::Int num_layers = get_num_layers();
+  for (El::Int i = 0; i < num_layers; ++i) {
+    get_layer(i).set_split_forward_prop(false);
+  }
+  if (m_statistics_reduction == statistics_reduction_mode::blocking) {
+    return;
+  }
+  if (!m_layer_waves.empty() || is_subgraph_parallelism_enabled()) {
+    LBANN_WARNING("model \"", get_name(), "\" uses blocking statistics ",
+                  "reductions since its layers are not run one at a time");
+    return;
+  }
+
+  // Split layers finish forward prop before their first child runs
+  std::unordered_map<const Layer*, El::Int> layer_index;
+  for (El::Int i = 0; i < num_layers; ++i) {
+    layer_index[&get_layer(i)] = i;
+  }
+  m_split_finish_before.resize(num_layers);
+  size_t num_split = 0;
+  for (El::Int i = 0; i < num_layers; ++i) {
+    auto& l = get_layer(i);
+    if (!l.can_split_forward_prop() || l.get_num_children() == 0) {
+      continue;
+    }
+    El::Int first_child = num_layers;
+    for (const auto* child : l.get_child_layers()) {
+      first_child = std::min(first_child, layer_index.at(child));
+    }
+    l.set_split_forward_prop(true);
+    m_split_finish_before[first_child].push_back(&l);
+    ++num_split;
+
+    // Recomputed parents must keep their outputs until forward prop
+    // finishes
+    if (static_cast<size_t>(i) < m_recompute_discard_after.size()) {
+      auto& discards = m_recompute_discard_after[i];
+      auto& later = m_recompute_discard_after[first_child];
+      later.insert(later.end(), discards.begin(), discards.end());
+      discards.clear();
+    }
+  }
+  if (num_split == 0) {
+    m_split_finish_before.clear();
+    return;
+  }
+  if (m_comm->am_trainer_master()) {
+    std::cout << "model \"" << get_name() << "\" "
+              << (m_statistics_reduction == statistics_reduction_mode::batch
+                  ? "batches" : "overlaps")
+              << " the statistics reductions of " << num_split
+              << " layers in forward prop" << std::endl;
+  }
+
+}
+
+void model::finish_split_forward_props(size_t index,
+                                       execution_mode mode,
+                                       bool run_callbacks) {
+  for (auto* l : m_split_finish_before[index]) {
+    if (m_split_pending_layers.erase(l) == 0) { continue; }
+    if (std::find(m_split_unreduced_layers.begin(),
+                  m_split_unreduced_layers.end(),
+                  l) != m_split_unreduced_layers.end()) {
+      reduce_split_layers();
+    }
+    l->finish_forward_prop();
+    if (run_callbacks) { do_layer_forward_prop_end_cbs(mode, l); }
+  }
+}
+
+void model::reduce_split_layers() {
+  using MatType = El::AbstractDistMatrix<DataType>;
+  using LocalMatType = El::Matrix<DataType, El::Device::CPU>;
+
+  // Group reductions by communicator
+  std::vector<std::pair<const El::mpi::Comm*, std::vector<MatType*>>> groups;
+  for (auto* l : m_split_unreduced_layers) {
+    auto* buffer = dynamic_cast<MatType*>(l->get_pending_reduction());
+    if (buffer == nullptr
+        || buffer->GetLocalDevice() != El::Device::CPU) {
+      l->start_pending_reduction();
+      continue;
+    }
+    const auto* comm = l->get_pending_reduction_comm();
+    auto group = std::find_if(
+      groups.begin(), groups.end(),
+      [comm](const std::pair<const El::mpi::Comm*, std::vector<MatType*>>& g) {
+        return g.first->GetMPIComm() == comm->GetMPIComm();
+      });
+    if (group == groups.end()) {
+      groups.emplace_back(comm, std::vector<MatType*>{buffer});
+    }
+    else {
+      group->second.push_back(buffer);
+    }
+  }
+  m_split_unreduced_layers.clear();
+
+  // Pack local entries, allreduce, and unpack
+  for (auto& group : groups) {
+    El::Int size = 0;
+    for (const auto* buffer : group.second) {
+      size += buffer->LocalHeight() * buffer->LocalWidth();
+    }
+    LocalMatType packed(size, 1);
+    El::Int offset = 0;
+    for (const auto* buffer : group.second) {
+      const auto& local = dynamic_cast<const LocalMatType&>(buffer->LockedMatrix());
+      for (El::Int col = 0; col < local.Width(); ++col) {
+        for (El::Int row = 0; row < local.Height(); ++row) {
+          packed(offset++, 0) = local(row, col);
+        }
+      }
+    }
+    m_comm->allreduce(packed, *group.first, El::mpi::SUM);
+    offset = 0;
+    for (auto* buffer : group.second) {
+      auto& local = dynamic_cast<LocalMatType&>(buffer->Matrix());
+      for (El::Int col = 0; col < local.Width(); ++col) {
+        for (El::Int row = 0; row < local.Height(); ++row) {
+          local(row, col) = packed(offset++, 0);
+        }
+      }
+    }
+  }
+
+}
+
+bool model::runs_on_calling_thread(const Layer& l) {
+  return (dynamic_cast<const input_layer<DataType>*>(&l) != nullptr
+          || l.uses_random_number_generators());
+}
+
+void model::run_layer_wave(size_t wave,
+                           std::function<void(Layer&)> const& f) {
+  const auto& layer_indices = m_layer_waves[wave];
+
+  // Input layers share the data coordinator and random layers share
+  // the random number generators, so they are run one at a time on
+  // this thread with all of its OpenMP threads
+  std::vector<Layer*> concurrent_layers;
+  for (const auto& i : layer_indices) {
+    auto& l = get_layer(i);
+    if (layer_indices.size() == 1 || runs_on_calling_thread(l)) {
+      f(l);
+    }
+    else {
+      concurrent_layers.push_back(&l);
+    }
+  }
+  if (concurrent_layers.empty()) { return; }
+
+  // Launch layers on worker threads and run the first one here
+  const int omp_threads = m_layer_wave_omp_threads[wave];
+  auto run_layer = [&f, omp_threads](Layer* l) {
+    omp_set_num_threads(omp_threads);
+    f(*l);
+  };
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < concurrent_layers.size(); ++i) {
+    auto* l = concurrent_layers[i];
+    futures.emplace_back(
+      m_layer_thread_pool->submit_job([&run_layer, l]() { run_layer(l); }));
+  }
+  const int main_omp_threads = omp_get_max_threads();
+  std::exception_ptr error;
+  try {
+    run_layer(concurrent_layers.front());
+  }
+  catch (...) {
+    error = std::current_exception();
+  }
+  omp_set_num_threads(main_omp_threads);
+
+  // Wait for all layers before reporting errors, since the workers
+  // reference this stack frame
+  for (auto& fut : futures) {
+    try {
+      fut.get();
+    }
+    catch (...) {
+      if (!error) { error = std::current_exception(); }
+    }
+  }
+  if (error) { std::rethrow_exception(error); }
+}
+
 void model::add_evaluation_layers(std::unordered_set<Layer*>& layer_set,
                                   std::unordered_set<std::string>& layer_names) {
   std::stringstream err;
@@ -2016,10 +2510,56 @@ void model::clear_gradients() {
     auto&& opt = w->get_optimizer();
     if (opt != nullptr) { opt->clear_gradient(); }
   }
+  set_gradient_scales(1);
+}
+
+void model::set_gradient_scales(size_t num_micro_batches) {
+  // Each micro-batch contributes the gradient of its mean loss
+  const EvalType loss_scale = (m_objective_function != nullptr
+                               ? m_objective_function->get_loss_scale()
+                               : EvalType(1));
+  const EvalType gradient_scale
+    = EvalType(1) / (loss_scale * std::max(num_micro_batches, size_t{1}));
+  for (auto&& w : m_weights) {
+    auto&& opt = w->get_optimizer();
+    if (opt != nullptr) { opt->set_gradient_scale(gradient_scale); }
+  }
 }
 
-void model::forward_prop(execution_mode mode) {
-  do_model_forward_prop_begin_cbs(mode);
+void model::defer_gradient_allreduces(bool defer) {
+  for (auto&& w : m_weights) {
+    auto&& opt = w->get_optimizer();
+    if (opt != nullptr) { opt->set_defer_gradient_allreduce(defer); }
+  }
+}
+
+void model::forward_prop(execution_mode mode, bool run_callbacks) {
+  if (run_callbacks) { do_model_forward_prop_begin_cbs(mode); }
+
+  // Outputs of recomputed layers are only discarded if backprop
+  // follows
+  m_discarded_layers.clear();
+  const bool discard_outputs = (mode == execution_mode::training);
+
+  // Layer-parallel execution
+  if (!m_layer_waves.empty()) {
+    for (size_t wave = 0; wave < m_layer_waves.size(); ++wave) {
+      run_layer_wave(wave, [this, mode, run_callbacks](Layer& l) {
+        if (run_callbacks) {
+          std::lock_guard<std::mutex> lock(m_layer_callback_mutex);
+          do_layer_forward_prop_begin_cbs(mode, &l);
+        }
+        l.forward_prop();
+        if (run_callbacks) {
+          std::lock_guard<std::mutex> lock(m_layer_callback_mutex);
+          do_layer_forward_prop_end_cbs(mode, &l);
+        }
+      });
+      if (discard_outputs) { discard_recomputed_outputs(wave); }
+    }
+    if (run_callbacks) { do_model_forward_prop_end_cbs(mode); }
+    return;
+  }
 
   for (El::Int i = 0; i < get_num_layers(); ++i) {
     auto& l = get_layer(i);
@@ -2028,9 +2568,9 @@ void model::forward_prop(execution_mode mode) {
     {
       if(l.get_run_layer_in_subgraph() || l.get_name()=="layer1")
       {
-        do_layer_forward_prop_begin_cbs(mode, &l);
+        if (run_callbacks) { do_layer_forward_prop_begin_cbs(mode, &l); }
         l.forward_prop();
-        do_layer_forward_prop_end_cbs(mode, &l);
+        if (run_callbacks) { do_layer_forward_prop_end_cbs(mode, &l); }
 
       }
       else
@@ -2042,13 +2582,30 @@ void model::forward_prop(execution_mode mode) {
     }
     else
     {
-      do_layer_forward_prop_begin_cbs(mode, &l);
+      if (!m_split_finish_before.empty()) {
+        finish_split_forward_props(i, mode, run_callbacks);
+      }
+      if (run_callbacks) { do_layer_forward_prop_begin_cbs(mode, &l); }
       l.forward_prop();
-      do_layer_forward_prop_end_cbs(mode, &l);
+
+      // Layers waiting on a reduction run their end callbacks once
+      // forward prop finishes
+      if (!m_split_finish_before.empty()
+          && l.get_pending_reduction() != nullptr) {
+        m_split_pending_layers.insert(&l);
+        if (m_statistics_reduction == statistics_reduction_mode::overlap) {
+          l.start_pending_reduction();
+        }
+        else {
+          m_split_unreduced_layers.push_back(&l);
+        }
+      }
+      else if (run_callbacks) { do_layer_forward_prop_end_cbs(mode, &l); }
+      if (discard_outputs) { discard_recomputed_outputs(i); }
 
     }
   }
-  do_model_forward_prop_end_cbs(mode);
+  if (run_callbacks) { do_model_forward_prop_end_cbs(mode); }
 
 }
 
@@ -2056,6 +2613,39 @@ void model::backward_prop() {
 
   do_model_backward_prop_begin_cbs();
 
+  // Layer-parallel execution
+  if (!m_layer_waves.empty()) {
+    for (size_t wave = m_layer_waves.size(); wave-- > 0;) {
+      for (const auto& i : m_layer_waves[wave]) {
+        recompute_parent_outputs(get_layer(i));
+      }
+      run_layer_wave(wave, [this](Layer& l) {
+        {
+          std::lock_guard<std::mutex> lock(m_layer_callback_mutex);
+          do_layer_backward_prop_begin_cbs(&l);
+        }
+        l.back_prop();
+        {
+          std::lock_guard<std::mutex> lock(m_layer_callback_mutex);
+          do_layer_backward_prop_end_cbs(&l);
+        }
+      });
+
+      // Terminate early if all gradients have been computed
+      bool all_gradients_computed = true;
+      for (auto&& w : m_weights) {
+        auto&& opt = w->get_optimizer();
+        if (opt != nullptr && opt->get_num_gradient_sources() != 0) {
+          all_gradients_computed = false;
+          break;
+        }
+      }
+      if (all_gradients_computed) { break; }
+    }
+    do_model_backward_prop_end_cbs();
+    return;
+  }
+
   for (El::Int i = get_num_layers()-1; i >= 0; --i) {
 
     // Perform backward prop step on current layer
@@ -2079,6 +2669,7 @@ void model::backward_prop() {
     }
     else
     {
+      recompute_parent_outputs(l);
       do_layer_backward_prop_begin_cbs(&l);
       l.back_prop();
       do_layer_backward_prop_end_cbs(&l);
@@ -2109,9 +2700,39 @@ void model::backward_prop() {
 
 }
 
-void model::update_weights() {
+void model::update_weights(size_t num_micro_batches) {
   do_model_optimize_begin_cbs();
 
+  // Undo loss scaling and average micro-batches in the optimizers
+  // Note: This uses the loss scale of the backprops, so it is set
+  // before the loss scale is updated.
+  set_gradient_scales(num_micro_batches);
+
+  // With dynamic loss scaling, skip the step if any gradient has
+  // overflowed
+  bool skip_step = false;
+  if (m_objective_function != nullptr
+      && m_objective_function->is_loss_scaling_dynamic()) {
+    // Note: Every optimizer is checked since the check may launch
+    // collective gradient allreduces, and ranks may disagree on
+    // whether their local gradients are finite.
+    int gradient_is_finite = 1;
+    for (const auto& w : m_weights) {
+      auto&& opt = w->get_optimizer();
+      if (opt != nullptr && !opt->gradient_is_finite()) {
+        gradient_is_finite = 0;
+      }
+    }
+    gradient_is_finite = m_comm->trainer_allreduce(gradient_is_finite,
+                                                   El::mpi::MIN);
+    skip_step = (gradient_is_finite == 0);
+    m_objective_function->update_loss_scale(!skip_step);
+  }
+  if (skip_step) {
+    do_model_optimize_end_cbs();
+    return;
+  }
+
   // Apply optimization step to weights
   // Note: Heuristically, forward prop consumes weights in the same
   // order as m_weights and backprop computes weights gradients in
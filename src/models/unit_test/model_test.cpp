@@ -30,17 +30,27 @@
 #include "MPITestHelpers.hpp"
 
 #include <lbann/base.hpp>
+#include <lbann/execution_algorithms/sgd_execution_context.hpp>
 #include <lbann/models/directed_acyclic_graph.hpp>
 #include <lbann/models/model.hpp>
 #include <lbann/layers/io/input_layer.hpp>
+#include <lbann/objective_functions/objective_function.hpp>
+#include <lbann/optimizers/optimizer.hpp>
+#include <lbann/weights/data_type_weights.hpp>
 #include <lbann/utils/memory.hpp>
 #include <lbann/utils/serialize.hpp>
 #include <lbann/utils/lbann_library.hpp>
 #include <lbann/proto/factories.hpp>
+#include <lbann/trainers/trainer.hpp>
+#include <lbann/utils/random_number_generators.hpp>
 
 #include <lbann.pb.h>
 #include <google/protobuf/text_format.h>
 
+#include <functional>
+#include <limits>
+#include <vector>
+
 namespace pb = ::google::protobuf;
 
 namespace {
@@ -58,7 +68,7 @@ auto mock_datareader_metadata()
 }
 
 template <typename T>
-auto make_model(lbann::lbann_comm& comm)
+auto make_model(lbann::lbann_comm& comm, bool setup = true)
 {
   lbann_data::LbannPB my_proto;
   if (!pb::TextFormat::ParseFromString(model_prototext, &my_proto))
@@ -71,10 +81,485 @@ auto make_model(lbann::lbann_comm& comm)
                                                 my_proto.optimizer(),
                                                 my_proto.trainer(),
                                                 my_proto.model()) ;
-  my_model->setup(1UL, metadata);
+  if (setup) {
+    my_model->setup(1UL, metadata);
+  }
   return my_model;
 }
 
+// Random layers feeding independent branches, so that layer waves
+// mix random layers with layers that run concurrently
+std::string const random_branches_prototext = R"ptext(
+model {
+  objective_function {
+    layer_term {
+      scale_factor: 1.0
+      layer: "loss"
+    }
+  }
+  layer {
+    name: "noise1"
+    children: "fc1a fc1b"
+    gaussian {
+      mean: 0.0
+      stdev: 1.0
+      neuron_dims: "8"
+    }
+  }
+  layer {
+    name: "noise2"
+    children: "fc2a fc2b"
+    uniform {
+      min: -1.0
+      max: 1.0
+      neuron_dims: "8"
+    }
+  }
+  layer {
+    name: "fc1a"
+    parents: "noise1"
+    children: "sum"
+    fully_connected {
+      num_neurons: 4
+      has_bias: true
+    }
+  }
+  layer {
+    name: "fc1b"
+    parents: "noise1"
+    children: "sum"
+    fully_connected {
+      num_neurons: 4
+      has_bias: true
+    }
+  }
+  layer {
+    name: "fc2a"
+    parents: "noise2"
+    children: "sum"
+    fully_connected {
+      num_neurons: 4
+      has_bias: true
+    }
+  }
+  layer {
+    name: "fc2b"
+    parents: "noise2"
+    children: "sum"
+    fully_connected {
+      num_neurons: 4
+      has_bias: true
+    }
+  }
+  layer {
+    name: "sum"
+    parents: "fc1a fc1b fc2a fc2b"
+    children: "loss"
+    sum {
+    }
+  }
+  layer {
+    name: "loss"
+    parents: "sum"
+    l2_norm2 {
+    }
+  }
+}
+optimizer {
+  sgd {
+    learn_rate: 0.01
+  }
+}
+trainer {
+  mini_batch_size: 1
+}
+)ptext";
+
+// ReLU layers feeding batch normalization with global statistics
+// and a concatenation that can alias its parents' outputs
+std::string const recompute_prototext = R"ptext(
+model {
+  objective_function {
+    layer_term {
+      scale_factor: 1.0
+      layer: "loss"
+    }
+  }
+  layer {
+    name: "noise"
+    children: "fc1"
+    gaussian {
+      mean: 0.0
+      stdev: 1.0
+      neuron_dims: "8"
+    }
+  }
+  layer {
+    name: "fc1"
+    parents: "noise"
+    children: "relu1"
+    fully_connected {
+      num_neurons: 8
+      has_bias: true
+    }
+  }
+  layer {
+    name: "relu1"
+    parents: "fc1"
+    children: "bn"
+    relu {
+    }
+  }
+  layer {
+    name: "bn"
+    parents: "relu1"
+    children: "relu2"
+    batch_normalization {
+      decay: 0.9
+      epsilon: 1e-5
+      statistics_group_size: -1
+    }
+  }
+  layer {
+    name: "relu2"
+    parents: "bn"
+    children: "fc2 fc3"
+    relu {
+    }
+  }
+  layer {
+    name: "fc2"
+    parents: "relu2"
+    children: "relu3"
+    fully_connected {
+      num_neurons: 4
+      has_bias: true
+    }
+  }
+  layer {
+    name: "fc3"
+    parents: "relu2"
+    children: "relu4"
+    fully_connected {
+      num_neurons: 4
+      has_bias: true
+    }
+  }
+  layer {
+    name: "relu3"
+    parents: "fc2"
+    children: "concat"
+    relu {
+    }
+  }
+  layer {
+    name: "relu4"
+    parents: "fc3"
+    children: "concat"
+    relu {
+    }
+  }
+  layer {
+    name: "concat"
+    parents: "relu3 relu4"
+    children: "fc4"
+    concatenation {
+      axis: 0
+    }
+  }
+  layer {
+    name: "fc4"
+    parents: "concat"
+    children: "loss"
+    fully_connected {
+      num_neurons: 2
+      has_bias: true
+    }
+  }
+  layer {
+    name: "loss"
+    parents: "fc4"
+    l2_norm2 {
+    }
+  }
+}
+optimizer {
+  sgd {
+    learn_rate: 0.01
+  }
+}
+trainer {
+  mini_batch_size: 8
+}
+)ptext";
+
+// Batch normalization layers with grouped and global statistics,
+// whose reductions can be overlapped or batched
+std::string const grouped_statistics_prototext = R"ptext(
+model {
+  objective_function {
+    layer_term {
+      scale_factor: 1.0
+      layer: "loss"
+    }
+  }
+  layer {
+    name: "noise"
+    children: "fc1"
+    gaussian {
+      mean: 0.0
+      stdev: 1.0
+      neuron_dims: "8"
+    }
+  }
+  layer {
+    name: "fc1"
+    parents: "noise"
+    children: "bn1"
+    fully_connected {
+      num_neurons: 8
+      has_bias: true
+    }
+  }
+  layer {
+    name: "bn1"
+    parents: "fc1"
+    children: "relu1"
+    batch_normalization {
+      decay: 0.9
+      epsilon: 1e-5
+      statistics_group_size: 2
+      running_statistics_sync_interval: 1
+    }
+  }
+  layer {
+    name: "relu1"
+    parents: "bn1"
+    children: "fc2"
+    relu {
+    }
+  }
+  layer {
+    name: "fc2"
+    parents: "relu1"
+    children: "bn2"
+    fully_connected {
+      num_neurons: 8
+      has_bias: true
+    }
+  }
+  layer {
+    name: "bn2"
+    parents: "fc2"
+    children: "relu2"
+    batch_normalization {
+      decay: 0.9
+      epsilon: 1e-5
+      statistics_group_size: -1
+    }
+  }
+  layer {
+    name: "relu2"
+    parents: "bn2"
+    children: "fc3"
+    relu {
+    }
+  }
+  layer {
+    name: "fc3"
+    parents: "relu2"
+    children: "loss"
+    fully_connected {
+      num_neurons: 2
+      has_bias: true
+    }
+  }
+  layer {
+    name: "loss"
+    parents: "fc3"
+    l2_norm2 {
+    }
+  }
+}
+optimizer {
+  sgd {
+    learn_rate: 0.01
+  }
+}
+trainer {
+  mini_batch_size: 16
+}
+)ptext";
+
+// Small model whose Adam state is sharded between processes. The
+// bias is smaller than the process count on larger trainers, so some
+// processes own an empty shard.
+std::string const sharded_state_prototext = R"ptext(
+model {
+  objective_function {
+    layer_term {
+      scale_factor: 1.0
+      layer: "loss"
+    }
+  }
+  layer {
+    name: "noise"
+    children: "fc"
+    gaussian {
+      mean: 0.0
+      stdev: 1.0
+      neuron_dims: "8"
+    }
+  }
+  layer {
+    name: "fc"
+    parents: "noise"
+    children: "loss"
+    fully_connected {
+      num_neurons: 3
+      has_bias: true
+    }
+  }
+  layer {
+    name: "loss"
+    parents: "fc"
+    l2_norm2 {
+    }
+  }
+}
+optimizer {
+  adam {
+    learn_rate: 0.01
+    beta1: 0.9
+    beta2: 0.99
+    eps: 1e-8
+  }
+  shard_state: true
+}
+trainer {
+  mini_batch_size: 4
+}
+)ptext";
+
+/** Construct and set up a model, along with its trainer.
+ *
+ *  @param configure Modifies the model message before the model is
+ *                   constructed.
+ */
+auto make_configured_model(
+  lbann::lbann_comm& comm,
+  std::string const& prototext,
+  std::function<void(lbann_data::Model&)> const& configure)
+{
+  lbann_data::LbannPB my_proto;
+  if (!pb::TextFormat::ParseFromString(prototext, &my_proto))
+    throw "Parsing protobuf failed.";
+  configure(*my_proto.mutable_model());
+  auto& trainer = lbann::construct_trainer(&comm,
+                                           my_proto.mutable_trainer(),
+                                           my_proto);
+  lbann::init_random(20221021,
+                     trainer.get_io_thread_pool().get_num_threads());
+  auto metadata = mock_datareader_metadata();
+  auto my_model = lbann::proto::construct_model(&comm,
+                                                -1,
+                                                my_proto.optimizer(),
+                                                my_proto.trainer(),
+                                                my_proto.model());
+  my_model->setup(my_proto.trainer().mini_batch_size(), metadata);
+  return my_model;
+}
+
+/** Run forward and backward prop on one mini-batch, and optionally
+ *  update the weights. */
+void run_train_step(lbann::model& m,
+                    size_t mini_batch_size,
+                    bool update_weights)
+{
+  const auto mode = lbann::execution_mode::training;
+  auto c = lbann::SGDExecutionContext(mode, mini_batch_size);
+  m.reset_mode(c, mode);
+  m.clear_gradients();
+  m.forward_prop(mode);
+  auto& obj = *m.get_objective_function();
+  obj.start_evaluation(mode, mini_batch_size);
+  obj.differentiate();
+  m.backward_prop();
+  obj.finish_evaluation(mode, mini_batch_size);
+  if (update_weights) {
+    m.update_weights();
+  }
+}
+
+/** Run one training step of a model and return copies of the layer
+ *  outputs and the weight gradients.
+ *
+ *  @param configure Modifies the model message before the model is
+ *                   constructed.
+ */
+template <typename T>
+auto train_step(lbann::lbann_comm& comm,
+                std::string const& prototext,
+                std::function<void(lbann_data::Model&)> const& configure)
+{
+  using WeightsType = lbann::data_type_weights<T>;
+  auto my_model = make_configured_model(comm, prototext, configure);
+  run_train_step(*my_model,
+                 lbann::get_trainer().get_max_mini_batch_size(),
+                 false);
+
+  std::vector<std::unique_ptr<El::AbstractDistMatrix<T>>> results;
+  for (auto const* l : my_model->get_layers()) {
+    auto const* dtl = dynamic_cast<lbann::data_type_layer<T> const*>(l);
+    if (dtl != nullptr && dtl->get_num_children() > 0) {
+      results.emplace_back(dtl->get_activations().Copy());
+    }
+  }
+  for (auto* w : my_model->get_weights()) {
+    auto* dtw = dynamic_cast<WeightsType*>(w);
+    if (dtw != nullptr && dtw->get_optimizer() != nullptr) {
+      results.emplace_back(dtw->get_optimizer()->get_gradient().Copy());
+    }
+  }
+  return results;
+}
+
+/** Copies of the values of weights with optimizers. */
+template <typename T>
+auto copy_trained_weights(lbann::model& m)
+{
+  using WeightsType = lbann::data_type_weights<T>;
+  std::vector<std::unique_ptr<El::AbstractDistMatrix<T>>> results;
+  for (auto* w : m.get_weights()) {
+    auto* dtw = dynamic_cast<WeightsType*>(w);
+    if (dtw != nullptr && dtw->get_optimizer() != nullptr) {
+      results.emplace_back(dtw->get_values().Copy());
+    }
+  }
+  return results;
+}
+
+/** Check that two training steps produced matching results. */
+template <typename T>
+void check_matching_steps(
+  std::vector<std::unique_ptr<El::AbstractDistMatrix<T>>> const& expected,
+  std::vector<std::unique_ptr<El::AbstractDistMatrix<T>>> const& actual)
+{
+  REQUIRE(expected.size() == actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    const auto& local_expected = expected[i]->LockedMatrix();
+    const auto& local_actual = actual[i]->LockedMatrix();
+    REQUIRE(local_expected.Height() == local_actual.Height());
+    REQUIRE(local_expected.Width() == local_actual.Width());
+    for (El::Int col = 0; col < local_expected.Width(); ++col) {
+      for (El::Int row = 0; row < local_expected.Height(); ++row) {
+        CHECK(local_actual.Get(row, col)
+              == Approx(local_expected.Get(row, col)));
+      }
+    }
+  }
+}
+
 }// namespace <anon>
 
 using unit_test::utilities::IsValidPtr;
@@ -166,3 +651,200 @@ TEST_CASE("Serializing models", "[mpi][model][serialize]")
   }
 #endif // LBANN_HAS_CEREAL_XML_ARCHIVES
 }
+
+TEST_CASE("Inference-only model setup", "[mpi][model]")
+{
+  using DataType = float;
+
+  auto& comm = unit_test::utilities::current_world_comm();
+  auto model = make_model<DataType>(comm, /*setup=*/false);
+
+  auto metadata = mock_datareader_metadata();
+  size_t saved_bytes = 0;
+  REQUIRE_NOTHROW(saved_bytes = model->setup_inference(1UL, metadata));
+
+  // Each weights would have had at least a gradient buffer
+  size_t values_bytes = 0;
+  for (auto const* w : model->get_weights()) {
+    CHECK(w->is_frozen());
+    CHECK_FALSE(w->has_optimizer());
+    values_bytes += w->get_values_memory_usage();
+  }
+  CHECK(values_bytes > 0);
+  CHECK(saved_bytes >= values_bytes);
+  for (auto const* l : model->get_layers()) {
+    CHECK(l->is_frozen());
+  }
+}
+
+TEST_CASE("Dynamic loss scaling skips overflowed steps", "[mpi][model]")
+{
+  using DataType = float;
+  using WeightsType = lbann::data_type_weights<DataType>;
+  using AbsDistMatType = El::AbstractDistMatrix<DataType>;
+
+  auto& comm = unit_test::utilities::current_world_comm();
+  auto model = make_model<DataType>(comm);
+  auto& obj = *model->get_objective_function();
+
+  // Note: The default loss scale of one must still be checked for
+  // overflow with dynamic loss scaling.
+  obj.set_loss_scaling(1., true, 2., 0.5, 100);
+
+  // Find trainable weights
+  WeightsType* w = nullptr;
+  for (auto* w_ : model->get_weights()) {
+    w = dynamic_cast<WeightsType*>(w_);
+    if (w != nullptr && w->get_optimizer() != nullptr) { break; }
+  }
+  REQUIRE(w != nullptr);
+  REQUIRE(w->get_optimizer() != nullptr);
+  std::unique_ptr<AbsDistMatType> values_before(w->get_values().Copy());
+
+  SECTION("Step is skipped on an inf gradient")
+  {
+    model->clear_gradients();
+    std::unique_ptr<AbsDistMatType> contrib(w->get_values().Copy());
+    El::Fill(*contrib, std::numeric_limits<DataType>::infinity());
+    w->get_optimizer()->add_to_gradient(*contrib);
+    REQUIRE_NOTHROW(model->update_weights());
+    CHECK(obj.get_num_skipped_steps() == 1);
+    CHECK(obj.get_loss_scale() == 0.5);
+
+    // Weights are unchanged
+    const auto& local_before = values_before->LockedMatrix();
+    const auto& local_after = w->get_values().LockedMatrix();
+    bool unchanged = true;
+    for (El::Int col = 0; col < local_after.Width(); ++col) {
+      for (El::Int row = 0; row < local_after.Height(); ++row) {
+        unchanged = unchanged && (local_after.Get(row, col)
+                                  == local_before.Get(row, col));
+      }
+    }
+    CHECK(unchanged);
+  }
+
+  SECTION("Finite step is applied")
+  {
+    model->clear_gradients();
+    std::unique_ptr<AbsDistMatType> contrib(w->get_values().Copy());
+    El::Fill(*contrib, DataType(1));
+    w->get_optimizer()->add_to_gradient(*contrib);
+    REQUIRE_NOTHROW(model->update_weights());
+    CHECK(obj.get_num_skipped_steps() == 0);
+    CHECK(obj.get_loss_scale() == 1.);
+  }
+}
+
+TEST_CASE("Layer waves match serial execution", "[mpi][model]")
+{
+  using DataType = float;
+
+  // Note: Layers only run concurrently with one process per trainer.
+  // Otherwise both runs are serial.
+  auto& comm = unit_test::utilities::current_world_comm();
+  auto serial = train_step<DataType>(
+    comm, random_branches_prototext,
+    [](lbann_data::Model& m) { m.set_layer_parallel_threads(0); });
+  auto waves = train_step<DataType>(
+    comm, random_branches_prototext,
+    [](lbann_data::Model& m) { m.set_layer_parallel_threads(4); });
+  check_matching_steps(serial, waves);
+}
+
+TEST_CASE("Recomputed activations match stored activations", "[mpi][model]")
+{
+  using DataType = float;
+
+  // Note: relu1 feeds batch normalization, which splits its forward
+  // prop with overlapped statistics reductions. relu3 and relu4 may
+  // write into the concatenation buffer and are then kept.
+  auto& comm = unit_test::utilities::current_world_comm();
+  for (std::string const mode : {"blocking", "overlap"}) {
+    for (size_t interval : {0, 2}) {
+      INFO("Statistics reduction " << mode
+           << ", recompute interval " << interval);
+      auto stored = train_step<DataType>(
+        comm, recompute_prototext,
+        [&](lbann_data::Model& m) { m.set_statistics_reduction(mode); });
+      auto recomputed = train_step<DataType>(
+        comm, recompute_prototext,
+        [&](lbann_data::Model& m) {
+          m.set_statistics_reduction(mode);
+          if (interval == 0) {
+            m.set_recompute_layer_types("relu");
+          }
+          else {
+            m.set_recompute_interval(interval);
+          }
+        });
+      check_matching_steps(stored, recomputed);
+    }
+  }
+}
+
+TEST_CASE("Statistics reduction modes match", "[mpi][model]")
+{
+  using DataType = float;
+
+  // Note: Statistics are only reduced between processes with more
+  // than one process per trainer. Otherwise all modes are local.
+  auto& comm = unit_test::utilities::current_world_comm();
+  auto blocking = train_step<DataType>(
+    comm, grouped_statistics_prototext,
+    [](lbann_data::Model& m) { m.set_statistics_reduction("blocking"); });
+  for (std::string const mode : {"overlap", "batch"}) {
+    INFO("Statistics reduction " << mode);
+    auto results = train_step<DataType>(
+      comm, grouped_statistics_prototext,
+      [&](lbann_data::Model& m) { m.set_statistics_reduction(mode); });
+    check_matching_steps(blocking, results);
+  }
+}
+
+TEST_CASE("Sharded optimizer state survives a checkpoint",
+          "[mpi][model][serialize]")
+{
+  using DataType = float;
+
+  auto& comm = unit_test::utilities::current_world_comm();
+  auto const& g = comm.get_trainer_grid();
+  lbann::utils::grid_manager mgr(g);
+  auto const no_change = [](lbann_data::Model&) {};
+  const size_t mini_batch_size = 4;
+
+  auto model_src_ptr =
+    make_configured_model(comm, sharded_state_prototext, no_change);
+  run_train_step(*model_src_ptr, mini_batch_size, true);
+
+#ifdef LBANN_HAS_CEREAL_BINARY_ARCHIVES
+  // Shared checkpoints only hold the root's copy of the state
+  {
+    std::stringstream rooted_ss;
+    lbann::RootedBinaryOutputArchive oarchive(rooted_ss, g);
+    REQUIRE_THROWS(oarchive(model_src_ptr));
+  }
+
+  std::stringstream ss;
+  std::unique_ptr<lbann::model> model_tgt_ptr;
+  {
+    cereal::BinaryOutputArchive oarchive(ss);
+    REQUIRE_NOTHROW(oarchive(model_src_ptr));
+  }
+  {
+    cereal::BinaryInputArchive iarchive(ss);
+    REQUIRE_NOTHROW(iarchive(model_tgt_ptr));
+    REQUIRE(IsValidPtr(model_tgt_ptr));
+  }
+  auto metadata = mock_datareader_metadata();
+  REQUIRE_NOTHROW(model_tgt_ptr->setup(mini_batch_size, metadata));
+
+  // Take the same step with the original and restarted models
+  lbann::init_random(20221021);
+  run_train_step(*model_src_ptr, mini_batch_size, true);
+  lbann::init_random(20221021);
+  run_train_step(*model_tgt_ptr, mini_batch_size, true);
+  check_matching_steps(copy_trained_weights<DataType>(*model_src_ptr),
+                       copy_trained_weights<DataType>(*model_tgt_ptr));
+#endif // LBANN_HAS_CEREAL_BINARY_ARCHIVES
+}
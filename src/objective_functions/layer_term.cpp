@@ -92,7 +92,7 @@ EvalType layer_term::finish_evaluation() {
 
 void layer_term::differentiate() {
   auto& eval = dynamic_cast<abstract_evaluation_layer<DataType>&>(get_evaluation_layer());
-  eval.set_scale(m_scale_factor);
+  eval.set_scale(m_scale_factor * m_loss_scale);
   // get_evaluation_layer().set_scale(m_scale_factor);
 }
 
@@ -35,7 +35,14 @@ namespace lbann {
 objective_function::objective_function(const objective_function& other)
   : m_statistics(other.m_statistics),
     m_evaluation_time(other.m_evaluation_time),
-    m_differentiation_time(other.m_differentiation_time) {
+    m_differentiation_time(other.m_differentiation_time),
+    m_loss_scale(other.m_loss_scale),
+    m_dynamic_loss_scaling(other.m_dynamic_loss_scaling),
+    m_loss_scale_growth_factor(other.m_loss_scale_growth_factor),
+    m_loss_scale_backoff_factor(other.m_loss_scale_backoff_factor),
+    m_loss_scale_growth_interval(other.m_loss_scale_growth_interval),
+    m_num_finite_steps(other.m_num_finite_steps),
+    m_num_skipped_steps(other.m_num_skipped_steps) {
   for (const auto& ptr : other.m_terms) {
     m_terms.emplace_back(ptr ? ptr->copy() : nullptr);
   }
@@ -49,6 +56,13 @@ objective_function& objective_function::operator=(const objective_function& othe
   m_statistics = other.m_statistics;
   m_evaluation_time = other.m_evaluation_time;
   m_differentiation_time = other.m_differentiation_time;
+  m_loss_scale = other.m_loss_scale;
+  m_dynamic_loss_scaling = other.m_dynamic_loss_scaling;
+  m_loss_scale_growth_factor = other.m_loss_scale_growth_factor;
+  m_loss_scale_backoff_factor = other.m_loss_scale_backoff_factor;
+  m_loss_scale_growth_interval = other.m_loss_scale_growth_interval;
+  m_num_finite_steps = other.m_num_finite_steps;
+  m_num_skipped_steps = other.m_num_skipped_steps;
   return *this;
 }
 
@@ -114,6 +128,7 @@ void objective_function::differentiate() {
   prof_region_begin("obj-differentiate", prof_colors[0], false);
   for (auto&& term : m_terms) {
     prof_region_begin(("obj-differentiate-" + term->name()).c_str(), prof_colors[1], false);
+    term->set_loss_scale(m_loss_scale);
     term->differentiate();
     prof_region_end(("obj-differentiate-" + term->name()).c_str(), false);
   }
@@ -126,6 +141,7 @@ void objective_function::compute_weight_regularization() {
   prof_region_begin("obj-weight-regularization", prof_colors[0], false);
   for (auto&& term : m_terms) {
     prof_region_begin(("obj-weight-regularization-" + term->name()).c_str(), prof_colors[1], false);
+    term->set_loss_scale(m_loss_scale);
     term->compute_weight_regularization();
     prof_region_end(("obj-weight-regularization-" + term->name()).c_str(), false);
   }
@@ -133,6 +149,47 @@ void objective_function::compute_weight_regularization() {
   m_differentiation_time += get_time() - start_time;
 }
 
+void objective_function::set_loss_scaling(EvalType initial_scale,
+                                          bool dynamic,
+                                          EvalType growth_factor,
+                                          EvalType backoff_factor,
+                                          El::Int growth_interval) {
+  if (initial_scale <= EvalType(0)) {
+    LBANN_ERROR("loss scale must be positive (got ", initial_scale, ")");
+  }
+  if (dynamic
+      && (growth_factor < EvalType(1)
+          || backoff_factor <= EvalType(0)
+          || backoff_factor > EvalType(1)
+          || growth_interval < 1)) {
+    LBANN_ERROR("invalid dynamic loss scaling parameters ",
+                "(growth factor ", growth_factor, ", "
+                "backoff factor ", backoff_factor, ", "
+                "growth interval ", growth_interval, ")");
+  }
+  m_loss_scale = initial_scale;
+  m_dynamic_loss_scaling = dynamic;
+  m_loss_scale_growth_factor = growth_factor;
+  m_loss_scale_backoff_factor = backoff_factor;
+  m_loss_scale_growth_interval = growth_interval;
+  m_num_finite_steps = 0;
+}
+
+void objective_function::update_loss_scale(bool gradient_is_finite) {
+  if (!m_dynamic_loss_scaling) { return; }
+  if (gradient_is_finite) {
+    if (++m_num_finite_steps >= m_loss_scale_growth_interval) {
+      m_loss_scale *= m_loss_scale_growth_factor;
+      m_num_finite_steps = 0;
+    }
+  }
+  else {
+    m_loss_scale *= m_loss_scale_backoff_factor;
+    m_num_finite_steps = 0;
+    ++m_num_skipped_steps;
+  }
+}
+
 EvalType objective_function::get_mean_value(execution_mode mode) const {
   if (m_statistics.count(mode) == 0
       || m_statistics.at(mode).get_num_samples() == 0) {
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <catch2/catch.hpp>
+
+#include <lbann/base.hpp>
+#include <lbann/objective_functions/objective_function.hpp>
+
+TEST_CASE("Dynamic loss scaling", "[objective_function][loss_scaling]")
+{
+  lbann::objective_function obj;
+  obj.set_loss_scaling(8., true, 2., 0.5, 3);
+  REQUIRE(obj.is_loss_scaling_dynamic());
+  REQUIRE(obj.get_loss_scale() == 8.);
+
+  SECTION("Growth after the growth interval")
+  {
+    obj.update_loss_scale(true);
+    obj.update_loss_scale(true);
+    CHECK(obj.get_loss_scale() == 8.);
+    obj.update_loss_scale(true);
+    CHECK(obj.get_loss_scale() == 16.);
+    obj.update_loss_scale(true);
+    obj.update_loss_scale(true);
+    obj.update_loss_scale(true);
+    CHECK(obj.get_loss_scale() == 32.);
+    CHECK(obj.get_num_skipped_steps() == 0);
+  }
+
+  SECTION("Backoff on overflow")
+  {
+    obj.update_loss_scale(true);
+    obj.update_loss_scale(false);
+    CHECK(obj.get_loss_scale() == 4.);
+    CHECK(obj.get_num_skipped_steps() == 1);
+    obj.update_loss_scale(false);
+    CHECK(obj.get_loss_scale() == 2.);
+    CHECK(obj.get_num_skipped_steps() == 2);
+
+    // Overflow restarts the growth interval
+    obj.update_loss_scale(true);
+    obj.update_loss_scale(true);
+    CHECK(obj.get_loss_scale() == 2.);
+    obj.update_loss_scale(true);
+    CHECK(obj.get_loss_scale() == 4.);
+    CHECK(obj.get_num_skipped_steps() == 2);
+  }
+
+  SECTION("Static loss scaling is not updated")
+  {
+    obj.set_loss_scaling(8., false, 2., 0.5, 3);
+    obj.update_loss_scale(false);
+    for (int i = 0; i < 4; ++i) {
+      obj.update_loss_scale(true);
+    }
+    CHECK(obj.get_loss_scale() == 8.);
+    CHECK(obj.get_num_skipped_steps() == 0);
+  }
+}
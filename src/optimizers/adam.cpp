@@ -106,7 +106,7 @@ auto adam<TensorDataType>::get_moment2() -> AbsDistMatrixType& {
 template <typename TensorDataType>
 void adam<TensorDataType>::setup(WeightsType* w) {
   OptimizerType::setup(w);
-  const auto& gradient = this->get_gradient();
+  const auto& gradient = this->get_state_layout();
   m_moment1.reset(AbsDistMatrixType::Instantiate(gradient.DistData()));
   m_moment2.reset(AbsDistMatrixType::Instantiate(gradient.DistData()));
 #ifdef LBANN_HAS_GPU
@@ -123,6 +123,13 @@ void adam<TensorDataType>::setup(WeightsType* w) {
   El::Zeros(*m_moment2, gradient.Height(), gradient.Width());
 }
 
+template <typename TensorDataType>
+size_t adam<TensorDataType>::get_state_memory_usage() const {
+  return (OptimizerType::get_state_memory_usage()
+          + this->get_memory_usage(m_moment1.get())
+          + this->get_memory_usage(m_moment2.get()));
+}
+
 template <typename TensorDataType>
 void adam<TensorDataType>::step_compute(AbsDistMatrixType& values,
                                         const AbsDistMatrixType& gradient) {
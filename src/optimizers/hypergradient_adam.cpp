@@ -90,7 +90,7 @@ description hypergradient_adam<TensorDataType>::get_description() const {
 template <typename TensorDataType>
 void hypergradient_adam<TensorDataType>::setup(WeightsType* w) {
   OptimizerType::setup(w);
-  const auto& gradient = this->get_gradient();
+  const auto& gradient = this->get_state_layout();
   m_moment1.reset(AbsDistMatrixType::Instantiate(gradient.DistData()));
   m_moment2.reset(AbsDistMatrixType::Instantiate(gradient.DistData()));
   m_old_gradient.reset(AbsDistMatrixType::Instantiate(gradient.DistData()));
@@ -99,6 +99,14 @@ void hypergradient_adam<TensorDataType>::setup(WeightsType* w) {
   El::Zeros(*m_old_gradient, gradient.Height(), gradient.Width());
 }
 
+template <typename TensorDataType>
+size_t hypergradient_adam<TensorDataType>::get_state_memory_usage() const {
+  return (OptimizerType::get_state_memory_usage()
+          + this->get_memory_usage(m_moment1.get())
+          + this->get_memory_usage(m_moment2.get())
+          + this->get_memory_usage(m_old_gradient.get()));
+}
+
 template <typename TensorDataType>
 void hypergradient_adam<TensorDataType>::step_compute(AbsDistMatrixType& values,
                                                       const AbsDistMatrixType& gradient) {
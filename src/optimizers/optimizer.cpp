@@ -53,7 +53,9 @@ optimizer::optimizer(const optimizer& other)
   : m_comm(other.m_comm),
     m_gradient_sources(other.m_gradient_sources),
     m_gradient_status(other.m_gradient_status),
-    m_step_time(other.m_step_time) {
+    m_step_time(other.m_step_time),
+    m_gradient_scale(other.m_gradient_scale),
+    m_shard_state(other.m_shard_state) {
   if (m_gradient_status == optimizer_gradient_status::allreduce_started) {
     LBANN_ERROR("attempted to copy optimizer while a "
                 "gradient allreduce is in progress");
@@ -65,6 +67,8 @@ optimizer& optimizer::operator=(const optimizer& other) {
   m_gradient_sources = other.m_gradient_sources;
   m_gradient_status = other.m_gradient_status;
   m_step_time = other.m_step_time;
+  m_gradient_scale = other.m_gradient_scale;
+  m_shard_state = other.m_shard_state;
   if (m_gradient_status == optimizer_gradient_status::allreduce_started) {
     LBANN_ERROR("attempted to copy optimizer while a "
                 "gradient allreduce is in progress");
@@ -75,6 +79,10 @@ optimizer& optimizer::operator=(const optimizer& other) {
 template <class Archive>
 void optimizer::serialize(Archive & ar) {
   // Do not save the optimizer's step time
+  // Note: Sharded state is only valid on the same number of
+  // processes, so whether state is sharded must be restored before
+  // setup allocates the state.
+  ar(CEREAL_NVP(m_shard_state));
 }
 
 description optimizer::get_description() const {
@@ -86,6 +94,25 @@ El::Int optimizer::get_num_gradient_sources() const {
   return m_gradient_sources.size();
 }
 
+bool optimizer::gradient_is_finite() {
+  // With sharded state, the gradient is only reduced in the
+  // optimization step. Non-finite local contributions produce a
+  // non-finite sum, so they are checked directly.
+  if (!m_shard_state) {
+    start_gradient_allreduce();
+    finish_gradient_allreduce();
+  }
+  for (const auto& grad_mgr : gradients_) {
+    const auto status = grad_mgr.second->get_status();
+    if ((status == optimizer_gradient_status::ready
+         || status == optimizer_gradient_status::allreduce_needed)
+        && !grad_mgr.second->is_finite()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void optimizer::add_gradient_source(const void* source) {
   if (source != nullptr) {
     m_gradient_sources.insert(source);
@@ -95,7 +122,9 @@ void optimizer::add_gradient_source(const void* source) {
 void optimizer::remove_gradient_source(const void* source) {
   m_gradient_sources.erase(nullptr);
   m_gradient_sources.erase(source);
-  if (get_gradient_sources().empty()) {
+  if (get_gradient_sources().empty()
+      && !m_shard_state
+      && !m_defer_gradient_allreduce) {
     start_gradient_allreduce();
   }
 }
@@ -65,11 +65,17 @@ description rmsprop<TensorDataType>::get_description() const {
 template <typename TensorDataType>
 void rmsprop<TensorDataType>::setup(WeightsType* w) {
   OptimizerType::setup(w);
-  const auto& gradient = this->get_gradient();
+  const auto& gradient = this->get_state_layout();
   m_cache.reset(AbsDistMatrixType::Instantiate(gradient.DistData()));
   El::Zeros(*m_cache, gradient.Height(), gradient.Width());
 }
 
+template <typename TensorDataType>
+size_t rmsprop<TensorDataType>::get_state_memory_usage() const {
+  return (OptimizerType::get_state_memory_usage()
+          + this->get_memory_usage(m_cache.get()));
+}
+
 template <typename TensorDataType>
 void rmsprop<TensorDataType>::step_compute(AbsDistMatrixType& values,
                                            const AbsDistMatrixType& gradient) {
@@ -82,7 +82,7 @@ auto sgd<TensorDataType>::get_velocity() -> AbsDistMatrixType& {
 template <typename TensorDataType>
 void sgd<TensorDataType>::setup(WeightsType* w) {
   OptimizerType::setup(w);
-  const auto& gradient = this->get_gradient();
+  const auto& gradient = this->get_state_layout();
   m_velocity.reset(AbsDistMatrixType::Instantiate(gradient.DistData()));
 #ifdef LBANN_HAS_GPU
   if (m_velocity->GetLocalDevice() == El::Device::GPU) {
@@ -95,6 +95,12 @@ void sgd<TensorDataType>::setup(WeightsType* w) {
   El::Zeros(*m_velocity, gradient.Height(), gradient.Width());
 }
 
+template <typename TensorDataType>
+size_t sgd<TensorDataType>::get_state_memory_usage() const {
+  return (OptimizerType::get_state_memory_usage()
+          + this->get_memory_usage(m_velocity.get()));
+}
+
 template <typename TensorDataType>
 void sgd<TensorDataType>::step_compute(AbsDistMatrixType& values, const AbsDistMatrixType& gradient) {
   if (m_momentum == TensorDataType(0.)) {
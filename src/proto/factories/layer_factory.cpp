@@ -511,10 +511,16 @@ std::unique_ptr<Layer> construct_layer_legacy(
       if (epsilon == 0.0) {
         epsilon = 1e-5;
       }
+      if (params.running_statistics_sync_interval() < 0) {
+        LBANN_ERROR("batch normalization layer has an invalid ",
+                    "running statistics sync interval (",
+                    params.running_statistics_sync_interval(), ")");
+      }
       return lbann::make_unique<batch_normalization_layer<TensorDataType, data_layout::DATA_PARALLEL, Device>>(
         decay,
         epsilon,
-        statistics_group_size);
+        statistics_group_size,
+        params.running_statistics_sync_interval());
     } else {
       LBANN_ERROR("batch normalization layer is only supported with "
                   "a data-parallel layout");
@@ -525,11 +531,14 @@ std::unique_ptr<Layer> construct_layer_legacy(
     const auto& keep_prob = params.keep_prob();
     const auto& alpha = params.alpha();
     const auto& scale = params.scale();
+    std::unique_ptr<selu_dropout<TensorDataType, Layout, Device>> layer;
     if (alpha != 0.0 && scale != 0.0) {
-      return lbann::make_unique<selu_dropout<TensorDataType, Layout, Device>>(keep_prob, alpha, scale);
+      layer = lbann::make_unique<selu_dropout<TensorDataType, Layout, Device>>(keep_prob, alpha, scale);
     } else {
-      return lbann::make_unique<selu_dropout<TensorDataType, Layout, Device>>(keep_prob);
+      layer = lbann::make_unique<selu_dropout<TensorDataType, Layout, Device>>(keep_prob);
     }
+    layer->set_recompute_mask(params.recompute_mask());
+    return layer;
   }
   if (proto_layer.has_entrywise_batch_normalization()) {
     const auto& params = proto_layer.entrywise_batch_normalization();
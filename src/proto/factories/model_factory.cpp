@@ -297,6 +297,23 @@ std::unique_ptr<model> construct_model(
   m->set_subgrid_communication_type(proto_model.subgraph_communication());
   m->set_subgrid_topology(proto_model.enable_subgraph_topology());
   m->set_subgraph_num_parent_resources(proto_model.subgraph_parent_grid_resources());
+  m->set_layer_parallel_threads(proto_model.layer_parallel_threads());
+  m->set_activation_recomputation(
+    parse_set<std::string>(proto_model.recompute_layers()),
+    parse_set<std::string>(proto_model.recompute_layer_types()),
+    proto_model.recompute_interval());
+  const auto& statistics_reduction = proto_model.statistics_reduction();
+  if (statistics_reduction.empty() || statistics_reduction == "blocking") {
+    m->set_statistics_reduction(statistics_reduction_mode::blocking);
+  } else if (statistics_reduction == "overlap") {
+    m->set_statistics_reduction(statistics_reduction_mode::overlap);
+  } else if (statistics_reduction == "batch") {
+    m->set_statistics_reduction(statistics_reduction_mode::batch);
+  } else {
+    LBANN_ERROR("invalid statistics reduction mode ",
+                "\"", statistics_reduction, "\" ",
+                "(expected \"blocking\", \"overlap\" or \"batch\")");
+  }
 
   return m;
 
@@ -54,6 +54,21 @@ construct_objective_function(const lbann_data::ObjectiveFunction& proto_obj) {
     obj->add_term(make_unique<layer_term>(params.scale_factor()));
   }
 
+  // Loss scaling
+  if (proto_obj.has_loss_scaling()) {
+    const auto& params = proto_obj.loss_scaling();
+    const auto initial_scale = params.initial_scale();
+    const auto growth_factor = params.growth_factor();
+    const auto backoff_factor = params.backoff_factor();
+    const auto growth_interval = params.growth_interval();
+    obj->set_loss_scaling(
+      initial_scale != 0. ? initial_scale : 1.,
+      params.dynamic(),
+      growth_factor != 0. ? growth_factor : 2.,
+      backoff_factor != 0. ? backoff_factor : 0.5,
+      growth_interval != 0 ? growth_interval : 2000);
+  }
+
   // Return objective function
   return obj;
 
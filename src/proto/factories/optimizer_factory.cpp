@@ -92,7 +92,11 @@ std::unique_ptr<optimizer> construct_optimizer(
   auto const& factory = get_optimizer_factory<TensorDataType>();
   auto const& msg =
     helpers::get_oneof_message(proto_opt, "optimizer_type");
-  return factory.create_object(msg.GetDescriptor()->name(), msg);
+  auto opt = factory.create_object(msg.GetDescriptor()->name(), msg);
+  if (opt != nullptr) {
+    opt->set_shard_state(proto_opt.shard_state());
+  }
+  return opt;
 }
 
 #define PROTO(T)                                                \
@@ -372,7 +372,14 @@ void init_data_readers(
                                  params.sample_function(),
                                  params.num_samples_function(),
                                  params.sample_dims_function(),
-                                 shuffle);
+                                 shuffle,
+                                 params.label_function(),
+                                 params.num_labels(),
+                                 params.response_function(),
+                                 params.num_responses(),
+                                 (params.has_num_prefetch_batches()
+                                  ? params.num_prefetch_batches().value()
+                                  : 2));
 #else
       LBANN_ERROR("attempted to construct Python data reader, "
                   "but LBANN is not built with Python/C API");
@@ -439,6 +446,9 @@ void init_data_readers(
       reader->set_gan_label_value(readme.gan_label_value());
     }
 
+    reader->set_shuffle_window(readme.shuffle_window());
+    reader->set_shuffle_block_size(readme.shuffle_block_size());
+
     if (readme.role() == "train") {
       reader->set_role("train");
     } else if (readme.role() == "test") {
@@ -558,7 +568,14 @@ void init_data_readers(
                                              params.sample_function(),
                                              params.num_samples_function(),
                                              params.sample_dims_function(),
-                                             shuffle);
+                                             shuffle,
+                                             params.label_function(),
+                                             params.num_labels(),
+                                             params.response_function(),
+                                             params.num_responses(),
+                                             (params.has_num_prefetch_batches()
+                                              ? params.num_prefetch_batches().value()
+                                              : 2));
             (*(python_reader *)split_reader) = (*(python_reader *)reader);
 #else
             LBANN_ERROR("attempted to construct Python data reader, "
@@ -0,0 +1,330 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "lbann/utils/mapped_npy.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <numeric>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lbann {
+
+namespace {
+
+/** @brief Read little-endian integer from possibly unaligned memory. */
+template <typename T>
+T read_le(const char* ptr) {
+  T val;
+  std::memcpy(&val, ptr, sizeof(T));
+  return val;
+}
+
+/** @brief Map file into memory with read-only access.
+ *
+ *  The mapping is released when the last reference is destroyed.
+ */
+std::shared_ptr<const char> map_file(const std::string& filename,
+                                     size_t& size) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    LBANN_ERROR("failed to open ", filename, " (", std::strerror(errno), ")");
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    close(fd);
+    LBANN_ERROR("failed to get size of ", filename);
+  }
+  size = file_stat.st_size;
+  void* ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    LBANN_ERROR("failed to mmap ", filename, " (", std::strerror(errno), ")");
+  }
+  return std::shared_ptr<const char>(
+    static_cast<const char*>(ptr),
+    [size](const char* p) { munmap(const_cast<char*>(p), size); });
+}
+
+/** @brief Member of a zip archive. */
+struct zip_member {
+  /** @brief Start of member contents. */
+  const char* data = nullptr;
+  /** @brief Size of member contents in the archive. */
+  uint64_t size = 0;
+  /** @brief Compression method (0 is stored without compression). */
+  uint16_t compression = 0;
+};
+
+/** @brief Find a member of a zip archive.
+ *
+ *  Supports the zip64 extensions that NumPy uses for large arrays.
+ *  Returns a member with null data if the name is not found.
+ */
+zip_member find_zip_member(const char* begin,
+                           size_t size,
+                           const std::string& name,
+                           const std::string& filename) {
+
+  // Find end of central directory record
+  // Note: It is followed by a comment of at most 64 KiB.
+  constexpr size_t eocd_size = 22;
+  if (size < eocd_size) {
+    LBANN_ERROR(filename, " is not a valid zip archive");
+  }
+  const char* eocd = nullptr;
+  const size_t search_end = (size > eocd_size + 65535
+                             ? size - eocd_size - 65535
+                             : 0);
+  for (size_t pos = size - eocd_size + 1; pos-- > search_end;) {
+    if (read_le<uint32_t>(begin + pos) == 0x06054b50) {
+      eocd = begin + pos;
+      break;
+    }
+  }
+  if (eocd == nullptr) {
+    LBANN_ERROR(filename, " is not a valid zip archive");
+  }
+  uint64_t num_entries = read_le<uint16_t>(eocd + 10);
+  uint64_t cd_offset = read_le<uint32_t>(eocd + 16);
+  if (num_entries == 0xFFFF || cd_offset == 0xFFFFFFFF) {
+    // Get central directory from zip64 end of central directory record
+    const char* locator = eocd - 20;
+    if (locator < begin || read_le<uint32_t>(locator) != 0x07064b50) {
+      LBANN_ERROR(filename, " has an invalid zip64 locator");
+    }
+    const char* eocd64 = begin + read_le<uint64_t>(locator + 8);
+    if (eocd64 + 56 > begin + size
+        || read_le<uint32_t>(eocd64) != 0x06064b50) {
+      LBANN_ERROR(filename, " has an invalid zip64 directory record");
+    }
+    num_entries = read_le<uint64_t>(eocd64 + 32);
+    cd_offset = read_le<uint64_t>(eocd64 + 48);
+  }
+
+  // Search central directory for member
+  const char* entry = begin + cd_offset;
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    if (entry + 46 > begin + size
+        || read_le<uint32_t>(entry) != 0x02014b50) {
+      LBANN_ERROR(filename, " has an invalid zip central directory");
+    }
+    const auto name_size = read_le<uint16_t>(entry + 28);
+    const auto extra_size = read_le<uint16_t>(entry + 30);
+    const auto comment_size = read_le<uint16_t>(entry + 32);
+    if (std::string(entry + 46, name_size) == name) {
+      zip_member member;
+      member.compression = read_le<uint16_t>(entry + 10);
+      member.size = read_le<uint32_t>(entry + 20);
+      uint64_t uncompressed_size = read_le<uint32_t>(entry + 24);
+      uint64_t local_offset = read_le<uint32_t>(entry + 42);
+
+      // Replace overflowed fields with zip64 extra fields
+      const char* extra = entry + 46 + name_size;
+      const char* extra_end = extra + extra_size;
+      while (extra + 4 <= extra_end) {
+        const auto id = read_le<uint16_t>(extra);
+        const auto field_size = read_le<uint16_t>(extra + 2);
+        if (id == 0x0001) {
+          const char* field = extra + 4;
+          if (uncompressed_size == 0xFFFFFFFF) {
+            uncompressed_size = read_le<uint64_t>(field);
+            field += 8;
+          }
+          if (member.size == 0xFFFFFFFF) {
+            member.size = read_le<uint64_t>(field);
+            field += 8;
+          }
+          if (local_offset == 0xFFFFFFFF) {
+            local_offset = read_le<uint64_t>(field);
+          }
+        }
+        extra += 4 + field_size;
+      }
+
+      // Member contents follow the local file header
+      const char* local = begin + local_offset;
+      if (local + 30 > begin + size
+          || read_le<uint32_t>(local) != 0x04034b50) {
+        LBANN_ERROR(filename, " has an invalid zip file header for ", name);
+      }
+      member.data = (local + 30
+                     + read_le<uint16_t>(local + 26)
+                     + read_le<uint16_t>(local + 28));
+      if (member.data + member.size > begin + size) {
+        LBANN_ERROR(filename, " is truncated (", name, ")");
+      }
+      return member;
+    }
+    entry += 46 + name_size + extra_size + comment_size;
+  }
+  return zip_member();
+
+}
+
+} // namespace
+
+mapped_npy_array::mapped_npy_array(const std::string& filename) {
+  size_t size = 0;
+  m_buffer = map_file(filename, size);
+  m_data = parse_header(m_buffer.get(), size, filename);
+}
+
+mapped_npy_array::mapped_npy_array(const std::string& filename,
+                                   const std::string& key) {
+  size_t size = 0;
+  m_buffer = map_file(filename, size);
+  const auto member = find_zip_member(m_buffer.get(), size,
+                                      key + ".npy", filename);
+  if (member.data == nullptr) {
+    LBANN_ERROR("could not find ", key, " in ", filename);
+  }
+  if (member.compression != 0) {
+    LBANN_ERROR("could not map ", key, " in ", filename, " ",
+                "since it is compressed");
+  }
+  m_data = parse_header(member.data, member.size, filename + ":" + key);
+}
+
+mapped_npy_array::mapped_npy_array(std::vector<size_t> shape,
+                                   char type_code,
+                                   size_t word_size,
+                                   std::shared_ptr<const char> data)
+  : m_buffer(std::move(data)),
+    m_data(m_buffer.get()),
+    m_shape(std::move(shape)),
+    m_type_code(type_code),
+    m_word_size(word_size) {}
+
+bool mapped_npy_array::has_npz_member(const std::string& filename,
+                                      const std::string& key) {
+  size_t size = 0;
+  const auto buffer = map_file(filename, size);
+  const auto member = find_zip_member(buffer.get(), size,
+                                      key + ".npy", filename);
+  return member.data != nullptr;
+}
+
+bool mapped_npy_array::is_npz_member_mappable(const std::string& filename,
+                                              const std::string& key) {
+  size_t size = 0;
+  const auto buffer = map_file(filename, size);
+  const auto member = find_zip_member(buffer.get(), size,
+                                      key + ".npy", filename);
+  return member.data != nullptr && member.compression == 0;
+}
+
+size_t mapped_npy_array::num_entries() const noexcept {
+  return std::accumulate(m_shape.begin(), m_shape.end(),
+                         size_t{1}, std::multiplies<size_t>());
+}
+
+const char* mapped_npy_array::parse_header(const char* begin,
+                                           size_t size,
+                                           const std::string& name) {
+
+  // Magic string and version
+  if (size < 10 || std::memcmp(begin, "\x93NUMPY", 6) != 0) {
+    LBANN_ERROR(name, " is not a NumPy array file");
+  }
+  const auto major_version = static_cast<unsigned char>(begin[6]);
+  size_t header_size, header_offset;
+  if (major_version == 1) {
+    header_size = read_le<uint16_t>(begin + 8);
+    header_offset = 10;
+  }
+  else {
+    header_size = read_le<uint32_t>(begin + 8);
+    header_offset = 12;
+  }
+  if (header_offset + header_size > size) {
+    LBANN_ERROR(name, " has a truncated header");
+  }
+  const std::string header(begin + header_offset, header_size);
+
+  // Find value in header dictionary
+  auto find_value = [&](const std::string& key) {
+    const auto pos = header.find("'" + key + "'");
+    if (pos == std::string::npos) {
+      LBANN_ERROR(name, " is missing \"", key, "\" in its header");
+    }
+    return header.find_first_not_of(" :", pos + key.size() + 2);
+  };
+
+  // Data type, e.g. '<f4'
+  const auto descr_begin = find_value("descr") + 1;
+  const auto descr_end = header.find_first_of("'\"", descr_begin);
+  const std::string descr = header.substr(descr_begin,
+                                          descr_end - descr_begin);
+  if (descr.size() < 3 || descr[0] == '>') {
+    LBANN_ERROR(name, " has unsupported data type ", descr);
+  }
+  m_type_code = descr[1];
+  m_word_size = std::stoul(descr.substr(2));
+
+  // Memory layout
+  m_fortran_order = (header.compare(find_value("fortran_order"), 4, "True")
+                     == 0);
+
+  // Array dimensions, e.g. (100, 3, 32, 32)
+  m_shape.clear();
+  const auto shape_begin = find_value("shape") + 1;
+  const auto shape_end = header.find(')', shape_begin);
+  std::string dim;
+  for (size_t pos = shape_begin; pos <= shape_end; ++pos) {
+    const char c = header[pos];
+    if (std::isdigit(c)) {
+      dim.push_back(c);
+    }
+    else if (!dim.empty()) {
+      m_shape.push_back(std::stoull(dim));
+      dim.clear();
+    }
+  }
+
+  // Make sure array entries are in bounds
+  const char* data = begin + header_offset + header_size;
+  if (header_offset + header_size + num_entries() * m_word_size > size) {
+    LBANN_ERROR(name, " is truncated");
+  }
+  return data;
+
+}
+
+void mapped_npy_array::throw_unsupported_type(char type_code,
+                                              size_t word_size) {
+  LBANN_ERROR("unsupported NumPy data type ", type_code, word_size);
+}
+
+} // namespace lbann
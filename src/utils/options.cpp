@@ -60,6 +60,11 @@ void construct_std_options()
     {"--no_im_comm"},
     "[STD] removed ImComm callback, if present; this is intended for"
     "running alexnet with a single model, but may be useful elsewhere");
+  arg_parser.add_flag(
+    LBANN_OPTION_NO_TENSOR_ALIASING,
+    {"--no_tensor_aliasing"},
+    "[STD] Always copy data in concatenate and slice layers instead of "
+    "having tensors share sub-views of one buffer");
   arg_parser.add_flag(LBANN_OPTION_PRELOAD_DATA_STORE,
                       {"--preload_data_store"},
                       "[STD] Preloads the data store in-memory structure "
@@ -234,6 +239,11 @@ void construct_datastore_options()
   arg_parser.add_flag(LBANN_OPTION_DATA_STORE_CACHE,
                       {"--data_store_cache"},
                       "[DATASTORE] TODO");
+  arg_parser.add_flag(LBANN_OPTION_DATA_STORE_COMPRESS,
+                      {"--data_store_compress"},
+                      "[DATASTORE] Hold the samples owned by each rank "
+                      "compressed in memory; they are decompressed when "
+                      "fetched");
   arg_parser.add_flag(LBANN_OPTION_DATA_STORE_DEBUG,
                       {"--data_store_debug"},
                       "[DATASTORE] TODO");
@@ -243,6 +253,10 @@ void construct_datastore_options()
   arg_parser.add_flag(LBANN_OPTION_DATA_STORE_MIN_MAX_TIMING,
                       {"--data_store_min_max_timing"},
                       "[DATASTORE] TODO");
+  arg_parser.add_flag(LBANN_OPTION_DATA_STORE_NODE_LOCAL,
+                      {"--data_store_node_local"},
+                      "[DATASTORE] Share the samples owned by each rank "
+                      "with the ranks on its node through shared memory");
   arg_parser.add_flag(LBANN_OPTION_DATA_STORE_NO_THREAD,
                       {"--data_store_no_thread"},
                       "[DATASTORE] TODO");
@@ -29,11 +29,71 @@
 #include "lbann/utils/random.hpp"
 #include "lbann/io/file_io.hpp"
 #include "lbann/utils/hash.hpp"
+#include <cmath>
+#include <memory>
 #include <thread>
 
 
 namespace lbann {
 
+namespace {
+
+/** @brief Uniform random value in [0, 1) with 53 random bits */
+inline double counter_rng_uniform(uint32_t hi, uint32_t lo) {
+  const uint64_t r = (uint64_t(hi) << 32) | lo;
+  return (r >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/** @brief Fill a matrix with a counter-based generator
+ *
+ *  Each process generates its local entries from their global
+ *  indices, so the result does not depend on the distribution, the
+ *  number of processes, or the number of threads. @c f maps the
+ *  random bits of an entry to its value.
+ */
+template <typename RandDataType, typename TensorDataType, typename F>
+void counter_rng_fill(El::AbstractDistMatrix<TensorDataType>& mat,
+                      El::Int m, El::Int n, F f) {
+  // Every process advances the stream, even without local entries
+  const auto key = next_counter_rng_key();
+  mat.Resize(m, n);
+
+  // Generate directly into the local matrix if possible
+  std::unique_ptr<El::AbstractDistMatrix<RandDataType>> vals_copy;
+  El::AbstractDistMatrix<RandDataType>* vals = nullptr;
+  if constexpr (std::is_same<TensorDataType,RandDataType>::value) {
+    if (mat.GetLocalDevice() == El::Device::CPU) {
+      vals = &mat;
+    }
+  }
+  if (vals == nullptr) {
+    auto dist_data = mat.DistData();
+    dist_data.device = El::Device::CPU;
+    vals_copy.reset(El::AbstractDistMatrix<RandDataType>::Instantiate(dist_data));
+    vals_copy->AlignWith(mat);
+    vals_copy->Resize(m, n);
+    vals = vals_copy.get();
+  }
+
+  auto& local_vals = static_cast<CPUMatDT<RandDataType>&>(vals->Matrix());
+  const El::Int local_height = local_vals.Height();
+  const El::Int local_width = local_vals.Width();
+  LBANN_OMP_PARALLEL_FOR_ARGS(collapse(2))
+  for (El::Int col = 0; col < local_width; ++col) {
+    for (El::Int row = 0; row < local_height; ++row) {
+      const uint64_t index = (uint64_t(vals->GlobalCol(col)) * m
+                              + vals->GlobalRow(row));
+      local_vals(row, col) = f(key(index));
+    }
+  }
+
+  if (vals_copy) {
+    El::Copy(*vals_copy, mat);
+  }
+}
+
+} // namespace
+
 bool save_rng_to_checkpoint(persist& p, lbann_comm* comm, bool is_distributed) {
   std::string dirname = std::string(p.m_checkpoint_dir) + "/rng_state";
   std::string rank_in_trainer;
@@ -63,6 +123,12 @@ bool save_rng_to_checkpoint(persist& p, lbann_comm* comm, bool is_distributed) {
     if(!rng_EL) { LBANN_ERROR("Failed to open ", rng_name); }
     rng_EL << El::Generator();
     rng_EL.close();
+
+    rng_name = dirname + "/rng_counter_stream";
+    std::ofstream rng_counter(rng_name);
+    if(!rng_counter) { LBANN_ERROR("Failed to open ", rng_name); }
+    rng_counter << get_counter_rng_stream();
+    rng_counter.close();
   }
 
   for(int i = 0; i < get_num_io_generators(); i++) {
@@ -154,6 +220,14 @@ bool load_rng_from_checkpoint(persist& p, const lbann_comm* comm) {
   if(!rng_EL) { LBANN_ERROR("Failed to open ", rng_name); }
   rng_EL >> El::Generator();
 
+  rng_name = dirname + "/rng_counter_stream";
+  std::ifstream rng_counter(rng_name);
+  if(rng_counter) { // absent from older checkpoints
+    uint64_t counter_stream;
+    rng_counter >> counter_stream;
+    set_counter_rng_stream(counter_stream);
+  }
+
   std::string rank_in_trainer;
   if (comm == nullptr) {
     rank_in_trainer = std::to_string(El::mpi::Rank(El::mpi::COMM_WORLD));
@@ -270,35 +344,28 @@ void gaussian_fill_procdet(El::AbstractDistMatrix<TensorDataType>& mat, El::Int
   using RandDataType = TensorDataType;
 #endif // LBANN_HAS_GPU_FP16
 
-  using CircMatType = El::DistMatrix<
-    RandDataType, El::CIRC, El::CIRC, El::ELEMENT, El::Device::CPU>;
-  CircMatType vals(m, n, mat.Grid(), 0);
-  if (vals.Participating()) {
-    auto* __restrict__ buffer = vals.Buffer(); // Should be contiguous
-    const size_t size = vals.LocalHeight() * vals.LocalWidth();
-    std::normal_distribution<RandDataType> dist(mean, stddev);
-    auto& gen = get_generator();
-    for (size_t i=0; i<size; ++i) {
-      buffer[i] = dist(gen);
-    }
-  }
-  El::Copy(vals, mat);
+  // Box-Muller transform
+  const double mean_ = static_cast<RandDataType>(mean);
+  const double stddev_ = static_cast<RandDataType>(stddev);
+  constexpr double two_pi = 6.283185307179586476925286766559;
+  counter_rng_fill<RandDataType>(
+    mat, m, n,
+    [mean_, stddev_](const philox4x32::result_type& r) {
+      const double u1 = 1.0 - counter_rng_uniform(r[0], r[1]); // (0,1]
+      const double u2 = counter_rng_uniform(r[2], r[3]);
+      const double z = (std::sqrt(-2.0 * std::log(u1))
+                        * std::cos(two_pi * u2));
+      return static_cast<RandDataType>(mean_ + stddev_ * z);
+    });
 }
 
 template <typename TensorDataType>
 void bernoulli_fill_procdet(El::AbstractDistMatrix<TensorDataType>& mat, El::Int m, El::Int n, double p) {
-  CircMatDT<TensorDataType, El::Device::CPU> vals(m, n, mat.Grid(), 0);
-  if (vals.Participating()) {
-    auto& local_vals = vals.Matrix();
-    auto& gen = get_generator();
-    std::bernoulli_distribution dist(p);
-    for (El::Int col = 0; col < local_vals.Width(); ++col) {
-      for (El::Int row = 0; row < local_vals.Height(); ++row) {
-        local_vals(row, col) = El::To<TensorDataType>(dist(gen));
-      }
-    }
-  }
-  El::Copy(vals, mat);
+  counter_rng_fill<TensorDataType>(
+    mat, m, n,
+    [p](const philox4x32::result_type& r) {
+      return El::To<TensorDataType>(counter_rng_uniform(r[0], r[1]) < p);
+    });
 }
 
 template <typename TensorDataType>
@@ -321,19 +388,15 @@ void uniform_fill_procdet(El::AbstractDistMatrix<TensorDataType>& mat, El::Int m
   using RandDataType = TensorDataType;
 #endif // LBANN_HAS_GPU_FP16
 
-  CircMatDT<RandDataType, El::Device::CPU> vals(m, n, mat.Grid(), 0);
-  if (vals.Participating()) {
-    auto& local_vals = vals.Matrix();
-    auto& gen = get_generator();
-    std::uniform_real_distribution<RandDataType> dist(center - radius,
-                                                      center + radius);
-    for (El::Int col = 0; col < local_vals.Width(); ++col) {
-      for (El::Int row = 0; row < local_vals.Height(); ++row) {
-        local_vals(row, col) = dist(gen);
-      }
-    }
-  }
-  El::Copy(vals, mat);
+  const double lower = (static_cast<RandDataType>(center)
+                        - static_cast<RandDataType>(radius));
+  const double width = 2 * static_cast<RandDataType>(radius);
+  counter_rng_fill<RandDataType>(
+    mat, m, n,
+    [lower, width](const philox4x32::result_type& r) {
+      return static_cast<RandDataType>(
+        lower + width * counter_rng_uniform(r[0], r[1]));
+    });
 }
 
 template <typename TensorDataType>
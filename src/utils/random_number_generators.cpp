@@ -26,6 +26,7 @@
 
 #include <omp.h>
 #include "lbann/utils/random_number_generators.hpp"
+#include "lbann/comm_impl.hpp"
 #include "lbann/utils/hash.hpp"
 #include "lbann/utils/exception.hpp"
 #include <lbann/utils/memory.hpp>
@@ -67,6 +68,11 @@ thread_local bool data_seq_generator_inited = false;
 int data_seq_generator_seed_base = 0;
 bool data_seq_generator_seed_inited = false;
 
+// Counter-based generator state; identical on every rank
+uint64_t counter_rng_seed = 0;
+std::atomic<uint64_t> counter_rng_stream{0};
+bool counter_rng_inited = false;
+
 // Local index for the I/O generators
 thread_local size_t local_io_generators_index = 0;
 std::vector<lbann::io_rng_t> io_generators;
@@ -99,6 +105,24 @@ rng_gen& get_data_seq_generator() {
   return ::data_seq_generator;
 }
 
+counter_rng_key next_counter_rng_key() {
+  if (!::counter_rng_inited) { LBANN_ERROR("counter-based RNG seed not set"); }
+  return {::counter_rng_seed, ::counter_rng_stream++};
+}
+
+uint64_t get_counter_rng_seed() {
+  if (!::counter_rng_inited) { LBANN_ERROR("counter-based RNG seed not set"); }
+  return ::counter_rng_seed;
+}
+
+uint64_t get_counter_rng_stream() {
+  return ::counter_rng_stream.load();
+}
+
+void set_counter_rng_stream(uint64_t stream) {
+  ::counter_rng_stream.store(stream);
+}
+
 int get_num_io_generators() {
   return ::io_generators.size();
 }
@@ -131,12 +155,28 @@ void init_random(int seed, int num_io_RNGs, lbann_comm *comm) {
   generator_inited = true;
   fast_generator_inited = true;
 
-  // Use different seed on each rank in trainer
+  // Draw a seed if none is given. Every process in the trainer uses
+  // the same one, since counter-based fills need the same key on
+  // every process.
   if (seed == -1) {
     std::random_device rd;
     seed = rd();
+    if (comm != nullptr) {
+      comm->trainer_broadcast(0, seed);
+    }
+    else if (El::mpi::Initialized()) {
+      El::mpi::Broadcast(seed, 0, El::mpi::COMM_WORLD,
+                         El::SyncInfo<El::Device::CPU>{});
+    }
   }
-  else if (comm != nullptr) {
+
+  // Counter-based fills use the seed before the rank is mixed in
+  ::counter_rng_seed = static_cast<uint32_t>(seed);
+  ::counter_rng_stream.store(0);
+  ::counter_rng_inited = true;
+
+  // Use different seed on each rank in trainer
+  if (comm != nullptr) {
     seed = hash_combine(seed, comm->get_rank_in_trainer());
   }
   else if (El::mpi::Initialized()) {
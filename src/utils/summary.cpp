@@ -37,6 +37,34 @@ namespace lbann {
 
 #ifdef LBANN_HAS_TBINF
 
+namespace {
+
+/** Combined reduction for packed summary buffers.
+ *  Each element of the datatype is a whole packed buffer (see
+ *  lbann_summary::pending_flush). Entries in the sum section are
+ *  added and entries in the max section are maxed.
+ */
+void packed_summary_reduce(void* in, void* inout, int* len,
+                           MPI_Datatype* type) {
+  int type_size;
+  MPI_Type_size(*type, &type_size);
+  const size_t size = type_size / sizeof(float);
+  for (int k = 0; k < *len; ++k) {
+    const float* src = static_cast<const float*>(in) + k * size;
+    float* dst = static_cast<float*>(inout) + k * size;
+    const size_t num_sums = src[0];
+    const size_t num_maxes = src[1];
+    for (size_t i = 2; i < 2 + num_sums; ++i) {
+      dst[i] += src[i];
+    }
+    for (size_t i = 2 + num_sums; i < 2 + num_sums + num_maxes; ++i) {
+      dst[i] = std::max(dst[i], src[i]);
+    }
+  }
+}
+
+} // namespace
+
 lbann_summary::lbann_summary(std::string logdir, lbann_comm *comm)
   : m_comm(comm) {
   if (m_comm->am_world_master()) {
@@ -45,13 +73,17 @@ lbann_summary::lbann_summary(std::string logdir, lbann_comm *comm)
     m_sw = nullptr;
   }
   m_histogram_buckets = TBinf::SummaryWriter::get_default_histogram_buckets();
+  MPI_Op_create(&packed_summary_reduce, 1, &m_packed_op);
 }
 
 lbann_summary::~lbann_summary() {
   flush();
+  finish_flush();
   if (m_sw != nullptr) {
+    m_sw->flush();
     delete m_sw;
   }
+  MPI_Op_free(&m_packed_op);
 }
 
 #ifdef LBANN_HAS_OPENCV
@@ -77,154 +109,159 @@ void lbann_summary::report_image(std::string const& tag,
 #endif // LBANN_HAS_OPENCV
 
 void lbann_summary::flush() {
-  flush_means();
-  flush_mins();
-  flush_maxes();
-  flush_stdevs();
-  flush_scalars();
-  flush_sum_scalars();
+  finish_flush();
+  start_flush();
   flush_scalar_alls();
-  flush_histograms();
   if (m_sw != nullptr) {
     m_sw->flush();
   }
 }
 
-void lbann_summary::flush_means() {
-  if (m_pending_means.empty()) {
+void lbann_summary::start_flush() {
+  // Note: Scalars are only recorded on the trainer master and are
+  // not reduced.
+  const bool needs_reduction = !(m_pending_means.empty()
+                                 && m_pending_mins.empty()
+                                 && m_pending_maxes.empty()
+                                 && m_pending_stdevs.empty()
+                                 && m_pending_sum_scalars.empty()
+                                 && m_pending_histograms.empty());
+  if (!needs_reduction && m_pending_scalars.empty()) {
     return;
   }
-  std::vector<float> local_sums;
-  for (const auto& op : m_pending_means) {
-    local_sums.push_back(op.local);
+  auto f = make_unique<pending_flush>();
+  std::swap(f->means, m_pending_means);
+  std::swap(f->mins, m_pending_mins);
+  std::swap(f->maxes, m_pending_maxes);
+  std::swap(f->stdevs, m_pending_stdevs);
+  std::swap(f->scalars, m_pending_scalars);
+  std::swap(f->sum_scalars, m_pending_sum_scalars);
+  std::swap(f->histograms, m_pending_histograms);
+
+  // Pack entries that are summed
+  auto& buf = f->local;
+  buf.assign(2, 0.f);
+  for (const auto& op : f->means) { buf.push_back(op.local); }
+  for (const auto& op : f->stdevs) { buf.push_back(op.local); }
+  for (const auto& op : f->stdevs) { buf.push_back(op.local2); }
+  for (const auto& op : f->sum_scalars) { buf.push_back(op.local); }
+  for (const auto& op : f->histograms) {
+    buf.push_back(op.sum);
+    buf.push_back(op.sqsum);
+    buf.insert(buf.end(), op.buckets.begin(), op.buckets.end());
   }
-  if (m_comm->am_trainer_master()) {
-    std::vector<float> global_sums(local_sums.size());
-    m_comm->trainer_reduce(local_sums.data(), local_sums.size(),
-                           global_sums.data(), El::mpi::SUM);
-    // Compute the means in-place.
-    for (unsigned i = 0; i < global_sums.size(); ++i) {
-      global_sums[i] /= m_pending_means[i].num;
-    }
-    gather_scalar_summary(m_pending_means, global_sums);
-  } else {
-    m_comm->trainer_reduce(local_sums.data(), local_sums.size(),
-                         m_comm->get_trainer_master(), El::mpi::SUM);
+  buf[0] = buf.size() - 2;
+
+  // Pack entries that are maxed
+  for (const auto& op : f->maxes) { buf.push_back(op.local); }
+  for (const auto& op : f->mins) { buf.push_back(-op.local); }
+  for (const auto& op : f->histograms) {
+    buf.push_back(op.max);
+    buf.push_back(-op.min);
   }
-  m_pending_means.clear();
-}
+  buf[1] = buf.size() - 2 - buf[0];
 
-void lbann_summary::flush_mins() {
-  if (m_pending_mins.empty()) {
+  // Start reduction to trainer master
+  if (!needs_reduction) {
+    f->reduced = buf;
+    m_pending_flush = std::move(f);
     return;
   }
-  std::vector<float> local_mins;
-  for (const auto& op : m_pending_mins) {
-    local_mins.push_back(op.local);
-  }
+  MPI_Type_contiguous(buf.size(), MPI_FLOAT, &f->type);
+  MPI_Type_commit(&f->type);
   if (m_comm->am_trainer_master()) {
-    std::vector<float> global_mins(local_mins.size());
-    m_comm->trainer_reduce(local_mins.data(), local_mins.size(),
-                           global_mins.data(), El::mpi::MIN);
-    gather_scalar_summary(m_pending_mins, global_mins);
-  } else {
-    m_comm->trainer_reduce(local_mins.data(), local_mins.size(),
-                           m_comm->get_trainer_master(), El::mpi::MIN);
+    f->reduced.resize(buf.size());
   }
-  m_pending_mins.clear();
+  MPI_Ireduce(buf.data(),
+              m_comm->am_trainer_master() ? f->reduced.data() : nullptr,
+              1,
+              f->type,
+              m_packed_op,
+              m_comm->get_trainer_master(),
+              m_comm->get_trainer_comm().GetMPIComm(),
+              &f->request);
+  m_pending_flush = std::move(f);
 }
 
-void lbann_summary::flush_maxes() {
-  if (m_pending_maxes.empty()) {
+void lbann_summary::finish_flush() {
+  if (m_pending_flush == nullptr) {
     return;
   }
-  std::vector<float> local_maxes;
-  for (const auto& op : m_pending_maxes) {
-    local_maxes.push_back(op.local);
+  auto f = std::move(m_pending_flush);
+  if (f->type != MPI_DATATYPE_NULL) {
+    MPI_Wait(&f->request, MPI_STATUS_IGNORE);
+    MPI_Type_free(&f->type);
   }
-  if (m_comm->am_trainer_master()) {
-    std::vector<float> global_maxes(local_maxes.size());
-    m_comm->trainer_reduce(local_maxes.data(), local_maxes.size(),
-                           global_maxes.data(), El::mpi::MAX);
-    gather_scalar_summary(m_pending_maxes, global_maxes);
+  if (!m_comm->am_trainer_master()) {
+    return;
+  }
+
+  // Gather to the world master for writing out
+  // Note: Scalars are only recorded on trainer masters, so they are
+  // appended after the reduced values.
+  std::vector<float> values = std::move(f->reduced);
+  for (const auto& op : f->scalars) { values.push_back(op.local); }
+  if (m_comm->am_world_master()) {
+    const int num_trainers = m_comm->get_num_trainers();
+    std::vector<float> all_values(num_trainers * values.size());
+    m_comm->intertrainer_gather(values.data(), values.size(),
+                                all_values.data());
+    for (int model = 0; model < num_trainers; ++model) {
+      write_packed(*f, &all_values[model * values.size()], model);
+    }
   } else {
-    m_comm->trainer_reduce(local_maxes.data(), local_maxes.size(),
-                           m_comm->get_trainer_master(), El::mpi::MAX);
+    m_comm->intertrainer_gather(values.data(), values.size(),
+                                m_comm->get_intertrainer_master());
   }
-  m_pending_maxes.clear();
 }
 
-void lbann_summary::flush_stdevs() {
-  if (m_pending_stdevs.empty()) {
-    return;
-  }
-  std::vector<float> local_sums;
-  std::vector<float> local_sqsums;
-  for (const auto& op : m_pending_stdevs) {
-    local_sums.push_back(op.local);
-    local_sqsums.push_back(op.local2);
+void lbann_summary::write_packed(const pending_flush& f,
+                                 const float* values,
+                                 int model) {
+  const float* pos = values + 2;
+  for (const auto& op : f.means) {
+    m_sw->add_scalar(prepend_model(op.tag, model),
+                     *pos++ / op.num, op.step);
   }
-  if (m_comm->am_trainer_master()) {
+  const float* sums = pos;
+  const float* sqsums = pos + f.stdevs.size();
+  for (size_t i = 0; i < f.stdevs.size(); ++i) {
     // Compute the model sample standard deviation as:
     // sqrt[1/(n-1) (sqsum - (1/n)*sum^2)]
     // The n-1 is to use an unbiased variance estimate.
-    // This unrolls the usual formulation of standard deviation some, to avoid
-    // global operations when pushing the operation.
-    std::vector<float> global_sums(local_sums.size());
-    std::vector<float> global_sqsums(local_sqsums.size());
-    m_comm->trainer_reduce(local_sums.data(), local_sums.size(),
-                           global_sums.data(), El::mpi::SUM);
-    m_comm->trainer_reduce(local_sqsums.data(), local_sqsums.size(),
-                           global_sqsums.data(), El::mpi::SUM);
-    // Re-use the global_sums vector for the standard deviation.
-    for (unsigned i = 0; i < global_sums.size(); ++i) {
-      global_sums[i] = El::Sqrt(
-                         (global_sqsums[i] -
-                          global_sums[i] * global_sums[i] / m_pending_stdevs[i].num) /
-                         (m_pending_stdevs[i].num - 1));
-    }
-    gather_scalar_summary(m_pending_stdevs, global_sums);
-  } else {
-    m_comm->trainer_reduce(local_sums.data(), local_sums.size(),
-                         m_comm->get_trainer_master(), El::mpi::SUM);
-    m_comm->trainer_reduce(local_sqsums.data(), local_sqsums.size(),
-                         m_comm->get_trainer_master(), El::mpi::SUM);
+    const auto& op = f.stdevs[i];
+    const float stdev = El::Sqrt((sqsums[i] - sums[i] * sums[i] / op.num)
+                                 / (op.num - 1));
+    m_sw->add_scalar(prepend_model(op.tag, model), stdev, op.step);
   }
-  m_pending_stdevs.clear();
-}
-
-void lbann_summary::flush_scalars() {
-  if (m_pending_scalars.empty()) {
-    return;
+  pos += 2 * f.stdevs.size();
+  for (const auto& op : f.sum_scalars) {
+    m_sw->add_scalar(prepend_model(op.tag, model), *pos++, op.step);
   }
-  if (m_comm->am_trainer_master()) {
-    std::vector<float> local_scalars;
-    for (const auto& op : m_pending_scalars) {
-      local_scalars.push_back(op.local);
-    }
-    gather_scalar_summary(m_pending_scalars, local_scalars);
+  const float* hist_pos = pos;
+  for (const auto& op : f.histograms) {
+    hist_pos += 2 + op.buckets.size();
   }
-  m_pending_scalars.clear();
-}
-
-void lbann_summary::flush_sum_scalars() {
-  if (m_pending_sum_scalars.empty()) {
-    return;
+  const float* max_pos = hist_pos;
+  for (const auto& op : f.maxes) {
+    m_sw->add_scalar(prepend_model(op.tag, model), *max_pos++, op.step);
   }
-  std::vector<float> local_sums;
-  for (const auto& op : m_pending_sum_scalars) {
-    local_sums.push_back(op.local);
+  for (const auto& op : f.mins) {
+    m_sw->add_scalar(prepend_model(op.tag, model), -*max_pos++, op.step);
   }
-  if (m_comm->am_trainer_master()) {
-    std::vector<float> global_sums(local_sums.size());
-    m_comm->trainer_reduce(local_sums.data(), local_sums.size(),
-                           global_sums.data(), El::mpi::SUM);
-    gather_scalar_summary(m_pending_sum_scalars, global_sums);
-  } else {
-    m_comm->trainer_reduce(local_sums.data(), local_sums.size(),
-                           m_comm->get_trainer_master(), El::mpi::SUM);
+  for (const auto& op : f.histograms) {
+    const float sum = *pos++;
+    const float sqsum = *pos++;
+    std::vector<float> buckets(pos, pos + op.buckets.size());
+    pos += op.buckets.size();
+    const float max = *max_pos++;
+    const float min = -*max_pos++;
+    m_sw->add_histogram(prepend_model(op.tag, model),
+                        buckets, min, max, op.num, sum, sqsum, op.step);
+  }
+  for (const auto& op : f.scalars) {
+    m_sw->add_scalar(prepend_model(op.tag, model), *max_pos++, op.step);
   }
-  m_pending_sum_scalars.clear();
 }
 
 void lbann_summary::flush_scalar_alls() {
@@ -257,121 +294,11 @@ void lbann_summary::flush_scalar_alls() {
   m_pending_scalar_alls.clear();
 }
 
-void lbann_summary::flush_histograms() {
-  if (m_pending_histograms.empty()) {
-    return;
-  }
-  std::vector<float> local_mins;
-  std::vector<float> local_maxes;
-  std::vector<float> local_sums;
-  std::vector<float> local_sqsums;
-  std::vector<float> buckets;
-  for (const auto& op : m_pending_histograms) {
-    local_mins.push_back(op.min);
-    local_maxes.push_back(op.max);
-    local_sums.push_back(op.sum);
-    local_sqsums.push_back(op.sqsum);
-    buckets.insert(buckets.end(), op.buckets.begin(), op.buckets.end());
-  }
-  if (m_comm->am_trainer_master()) {
-    std::vector<float> model_mins(local_mins.size());
-    std::vector<float> model_maxes(local_maxes.size());
-    std::vector<float> model_sums(local_sums.size());
-    std::vector<float> model_sqsums(local_sqsums.size());
-    std::vector<float> model_buckets(buckets.size());
-    m_comm->trainer_reduce(local_mins.data(), local_mins.size(),
-                         model_mins.data(), El::mpi::MIN);
-    m_comm->trainer_reduce(local_maxes.data(), local_maxes.size(),
-                         model_maxes.data(), El::mpi::MAX);
-    m_comm->trainer_reduce(local_sums.data(), model_sums.size(),
-                         model_sums.data());
-    m_comm->trainer_reduce(local_sqsums.data(), local_sqsums.size(),
-                         model_sqsums.data());
-    m_comm->trainer_reduce(buckets.data(), buckets.size(),
-                         model_buckets.data());
-    // Gather to the world master for writing out.
-    if (m_comm->am_world_master()) {
-      std::vector<float> global_mins(
-        m_comm->get_num_trainers() * model_mins.size());
-      std::vector<float> global_maxes(
-        m_comm->get_num_trainers() * model_maxes.size());
-      std::vector<float> global_sums(
-        m_comm->get_num_trainers() * model_sums.size());
-      std::vector<float> global_sqsums(
-        m_comm->get_num_trainers() * model_sqsums.size());
-      std::vector<float> global_buckets(
-        m_comm->get_num_trainers() * model_buckets.size());
-      m_comm->intertrainer_gather(model_mins.data(), model_mins.size(),
-                                global_mins.data());
-      m_comm->intertrainer_gather(model_maxes.data(), model_maxes.size(),
-                                global_maxes.data());
-      m_comm->intertrainer_gather(model_sums.data(), model_sums.size(),
-                                global_sums.data());
-      m_comm->intertrainer_gather(model_sqsums.data(), model_sqsums.size(),
-                                global_sqsums.data());
-      m_comm->intertrainer_gather(model_buckets.data(), model_buckets.size(),
-                                global_buckets.data());
-      for (unsigned i = 0; i < global_mins.size(); ++i) {
-        int model = i / m_pending_histograms.size();
-        unsigned ops_pos = i % m_pending_histograms.size();
-        std::vector<float> tmp_buckets(
-          global_buckets.begin() + i*m_histogram_buckets.size(),
-          global_buckets.begin() + (i+1)*m_histogram_buckets.size());
-        m_sw->add_histogram(prepend_model(m_pending_histograms[ops_pos].tag, model),
-                            tmp_buckets, global_mins[i], global_maxes[i],
-                            m_pending_histograms[ops_pos].num,
-                            global_sums[i], global_sqsums[i],
-                            m_pending_histograms[ops_pos].step);
-      }
-    } else {
-      m_comm->intertrainer_gather(model_mins.data(), model_mins.size(),
-                                m_comm->get_intertrainer_master());
-      m_comm->intertrainer_gather(model_maxes.data(), model_maxes.size(),
-                                m_comm->get_intertrainer_master());
-      m_comm->intertrainer_gather(model_sums.data(), model_sums.size(),
-                                m_comm->get_intertrainer_master());
-      m_comm->intertrainer_gather(model_sqsums.data(), model_sqsums.size(),
-                                m_comm->get_intertrainer_master());
-      m_comm->intertrainer_gather(model_buckets.data(), model_buckets.size(),
-                                m_comm->get_intertrainer_master());
-    }
-  } else {
-    m_comm->trainer_reduce(local_mins.data(), local_mins.size(),
-                         m_comm->get_trainer_master(), El::mpi::MIN);
-    m_comm->trainer_reduce(local_maxes.data(), local_maxes.size(),
-                         m_comm->get_trainer_master(), El::mpi::MAX);
-    m_comm->trainer_reduce(local_sums.data(), local_sums.size(),
-                         m_comm->get_trainer_master(), El::mpi::SUM);
-    m_comm->trainer_reduce(local_sqsums.data(), local_sqsums.size(),
-                         m_comm->get_trainer_master(), El::mpi::SUM);
-    m_comm->trainer_reduce(buckets.data(), buckets.size(),
-                         m_comm->get_trainer_master(), El::mpi::SUM);
-  }
-  m_pending_histograms.clear();
-}
-
 std::string lbann_summary::prepend_model(const std::string tag,
                                          int model) const {
   return "model" + std::to_string(model) + "/" + tag;
 }
 
-void lbann_summary::gather_scalar_summary(
-  const std::vector<pending_op>& ops, std::vector<float>& scalars) {
-  if (m_comm->am_world_master()) {
-    std::vector<float> data(m_comm->get_num_trainers() * scalars.size());
-    m_comm->intertrainer_gather(scalars.data(), scalars.size(), data.data());
-    for (unsigned i = 0; i < data.size(); ++i) {
-      int model = i / ops.size();
-      unsigned ops_pos = i % ops.size();
-      m_sw->add_scalar(prepend_model(ops[ops_pos].tag, model),
-                       data[i], ops[ops_pos].step);
-    }
-  } else {
-    m_comm->intertrainer_gather(scalars.data(), scalars.size(),
-                              m_comm->get_intertrainer_master());
-  }
-}
-
 void lbann_summary::gather_scalar_summary(const std::string tag,
                                           float s,
                                           int step) {
@@ -0,0 +1,133 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/mapped_npy.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief Contents of a .npy file with float32 entries. */
+std::string make_npy(std::vector<float> const& vals,
+                     std::string const& shape)
+{
+  std::string header = "{'descr': '<f4', 'fortran_order': False, "
+                       "'shape': " + shape + ", }";
+  header.append(64 - (10 + header.size() + 1) % 64, ' ');
+  header.push_back('\n');
+  std::string contents("\x93NUMPY\x01\x00", 8);
+  contents.push_back(static_cast<char>(header.size() & 0xFF));
+  contents.push_back(static_cast<char>(header.size() >> 8));
+  contents += header;
+  contents.append(reinterpret_cast<char const*>(vals.data()),
+                  vals.size() * sizeof(float));
+  return contents;
+}
+
+void append_le(std::string& str, uint32_t val, size_t bytes)
+{
+  for (size_t i = 0; i < bytes; ++i) {
+    str.push_back(static_cast<char>((val >> (8 * i)) & 0xFF));
+  }
+}
+
+/** @brief Zip archive with one uncompressed member (CRC is not set). */
+std::string make_zip(std::string const& name, std::string const& contents)
+{
+  std::string zip;
+  append_le(zip, 0x04034b50, 4);
+  append_le(zip, 20, 2); // Version
+  append_le(zip, 0, 2);  // Flags
+  append_le(zip, 0, 2);  // Compression
+  append_le(zip, 0, 4);  // Modification time
+  append_le(zip, 0, 4);  // CRC
+  append_le(zip, contents.size(), 4);
+  append_le(zip, contents.size(), 4);
+  append_le(zip, name.size(), 2);
+  append_le(zip, 0, 2);  // Extra field size
+  zip += name;
+  zip += contents;
+  const size_t cd_offset = zip.size();
+  append_le(zip, 0x02014b50, 4);
+  append_le(zip, 20, 2); // Version made by
+  append_le(zip, 20, 2); // Version needed
+  append_le(zip, 0, 2);  // Flags
+  append_le(zip, 0, 2);  // Compression
+  append_le(zip, 0, 4);  // Modification time
+  append_le(zip, 0, 4);  // CRC
+  append_le(zip, contents.size(), 4);
+  append_le(zip, contents.size(), 4);
+  append_le(zip, name.size(), 2);
+  append_le(zip, 0, 2);  // Extra field size
+  append_le(zip, 0, 2);  // Comment size
+  append_le(zip, 0, 2);  // Disk number
+  append_le(zip, 0, 2);  // Internal attributes
+  append_le(zip, 0, 4);  // External attributes
+  append_le(zip, 0, 4);  // Local header offset
+  zip += name;
+  const size_t cd_size = zip.size() - cd_offset;
+  append_le(zip, 0x06054b50, 4);
+  append_le(zip, 0, 2);  // Disk number
+  append_le(zip, 0, 2);  // Disk with central directory
+  append_le(zip, 1, 2);  // Entries on disk
+  append_le(zip, 1, 2);  // Total entries
+  append_le(zip, cd_size, 4);
+  append_le(zip, cd_offset, 4);
+  append_le(zip, 0, 2);  // Comment size
+  return zip;
+}
+
+void write_file(std::string const& filename, std::string const& contents)
+{
+  std::ofstream ofs(filename, std::ios::binary);
+  ofs.write(contents.data(), contents.size());
+}
+
+} // namespace
+
+TEST_CASE("Memory-mapped NumPy arrays", "[seq][utilities][npy]")
+{
+  std::vector<float> const vals = {0.f, 1.f, 2.f, 3.f, 4.f, 5.f};
+  auto const npy = make_npy(vals, "(2, 3)");
+
+  SECTION(".npy file")
+  {
+    std::string const filename = "mapped_npy_test.npy";
+    write_file(filename, npy);
+    lbann::mapped_npy_array array(filename);
+    std::remove(filename.c_str());
+
+    REQUIRE(array.shape() == std::vector<size_t>{2, 3});
+    CHECK(array.type_code() == 'f');
+    CHECK(array.word_size() == 4);
+    CHECK_FALSE(array.fortran_order());
+
+    std::vector<double> row(3);
+    array.read(3, 3, row.data());
+    CHECK(row == std::vector<double>{3., 4., 5.});
+    CHECK(array.get<int>(2) == 2);
+  }
+
+  SECTION(".npz member")
+  {
+    std::string const filename = "mapped_npy_test.npz";
+    // Odd-length name so that entries are not aligned
+    write_file(filename, make_zip("datas.npy", npy));
+    CHECK(lbann::mapped_npy_array::has_npz_member(filename, "datas"));
+    CHECK_FALSE(lbann::mapped_npy_array::has_npz_member(filename, "data"));
+    CHECK(lbann::mapped_npy_array::is_npz_member_mappable(filename, "datas"));
+    CHECK_FALSE(
+      lbann::mapped_npy_array::is_npz_member_mappable(filename, "labels"));
+    lbann::mapped_npy_array array(filename, "datas");
+    std::remove(filename.c_str());
+
+    REQUIRE(array.shape() == std::vector<size_t>{2, 3});
+    std::vector<float> out(6);
+    array.read(0, 6, out.data());
+    CHECK(out == vals);
+  }
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 #include <lbann/base.hpp>
+#include <lbann/comm_impl.hpp>
 #include <lbann/utils/random.hpp>
 #include <h2/patterns/multimethods/SwitchDispatcher.hpp>
 
@@ -286,7 +287,7 @@ TEMPLATE_LIST_TEST_CASE(
 
   }
 
-  SECTION("Contiguous matrix (serial implementation)")
+  SECTION("Contiguous matrix (process-deterministic implementation)")
   {
 
     // Attempt Anderson-Darling test several times
@@ -330,7 +331,7 @@ TEMPLATE_LIST_TEST_CASE(
 
   }
 
-  SECTION("Non-contiguous matrix (serial implementation)")
+  SECTION("Non-contiguous matrix (process-deterministic implementation)")
   {
 
     // Attempt Anderson-Darling test several times
@@ -387,4 +388,40 @@ TEMPLATE_LIST_TEST_CASE(
 
   }
 
+  SECTION("Process-deterministic implementation is independent of distribution")
+  {
+    using T = TensorDataType<DistMatType>;
+    if constexpr (std::is_same<T,float>::value || std::is_same<T,double>::value)
+    {
+      using RefMatType = El::DistMatrix<T, El::STAR, El::STAR, El::ELEMENT, El::Device::CPU>;
+
+      // Same seed and stream, different distributions
+      lbann::init_random(20211110, 0, &comm);
+      DistMatType mat(grid);
+      lbann::gaussian_fill_procdet(mat, height, width, mean, stddev);
+      lbann::init_random(20211110, 0, &comm);
+      RefMatType ref(grid);
+      lbann::gaussian_fill_procdet(ref, height, width, mean, stddev);
+
+      RefMatType mat_copy(grid);
+      El::Copy(mat, mat_copy);
+      for (El::Int col = 0; col < width; ++col)
+      {
+        for (El::Int row = 0; row < height; ++row)
+        {
+          REQUIRE(mat_copy.GetLocal(row, col) == ref.GetLocal(row, col));
+        }
+      }
+    }
+  }
+
+  SECTION("Drawn seeds give the same counter-based key on every process")
+  {
+    lbann::init_random(-1, 0, &comm);
+    const uint64_t seed = lbann::get_counter_rng_seed();
+    uint64_t root_seed = seed;
+    comm.trainer_broadcast(0, root_seed);
+    REQUIRE(seed == root_seed);
+  }
+
 }
@@ -76,3 +76,42 @@ TEST_CASE("Testing random_uniform", "[random][utilities]") {
   }
 
 }
+
+TEST_CASE("Testing philox4x32", "[random][utilities]") {
+
+  // Known-answer tests from the Random123 distribution
+  SECTION("Zero counter and key") {
+    const auto r = lbann::philox4x32::generate({0, 0, 0, 0}, {0, 0});
+    CHECK(r[0] == 0x6627e8d5u);
+    CHECK(r[1] == 0xe169c58du);
+    CHECK(r[2] == 0xbc57ac4cu);
+    CHECK(r[3] == 0x9b00dbd8u);
+  }
+  SECTION("All-ones counter and key") {
+    const auto r = lbann::philox4x32::generate(
+      {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+      {0xffffffffu, 0xffffffffu});
+    CHECK(r[0] == 0x408f276du);
+    CHECK(r[1] == 0x41c83b0eu);
+    CHECK(r[2] == 0xa20bc7c6u);
+    CHECK(r[3] == 0x6d5451fdu);
+  }
+  SECTION("Digits of pi") {
+    const auto r = lbann::philox4x32::generate(
+      {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+      {0xa4093822u, 0x299f31d0u});
+    CHECK(r[0] == 0xd16cfe09u);
+    CHECK(r[1] == 0x94fdccebu);
+    CHECK(r[2] == 0x5001e420u);
+    CHECK(r[3] == 0x24126ea1u);
+  }
+
+  SECTION("Keys") {
+    const lbann::counter_rng_key key{20211110, 3};
+    const lbann::counter_rng_key other_stream{20211110, 4};
+    CHECK(key(17) == key(17));
+    CHECK(key(17) != key(18));
+    CHECK(key(17) != other_stream(17));
+  }
+
+}
@@ -277,6 +277,13 @@ auto data_type_weights<TensorDataType>::get_values() const
   return *m_values;
 }
 
+template <typename TensorDataType>
+size_t data_type_weights<TensorDataType>::get_values_memory_usage() const {
+  return (m_values == nullptr ? 0
+          : (m_values->LocalHeight() * m_values->LocalWidth()
+             * sizeof(TensorDataType)));
+}
+
 template <typename TensorDataType>
 void data_type_weights<TensorDataType>::set_values(const AbsDistMatrixType& values) {
   if ((values.Height() != get_values().Height())